@@ -0,0 +1,117 @@
+// AliasTable.h - Walker/Vose Alias Method for weighted random selection
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Alias Table for sampling from a discrete weighted distribution
+ * Every slot holds its own probability and one "alias" outcome,
+ * so a sample is one random number, one array read and one compare
+ * Time Complexity: O(n) build, O(1) sample regardless of outcome count
+ */
+class FAliasTable
+{
+private:
+    TArray<float> Probability;  // Chance of keeping slot i instead of its alias
+    TArray<int32> Alias;        // Outcome used when slot i is rejected
+
+public:
+    FAliasTable() {}
+
+    // Build from non-negative weights (do not need to sum to 1) - O(n)
+    void Build(const TArray<float>& Weights);
+
+    // Pick an outcome index from a uniform value in [0, 1) - O(1)
+    int32 Sample(float Uniform) const;
+
+    // Utility
+    int32 Num() const { return Probability.Num(); }
+    bool IsEmpty() const { return Probability.Num() == 0; }
+    void Reset();
+};
+
+// ===== IMPLEMENTATION =====
+
+inline void FAliasTable::Build(const TArray<float>& Weights)
+{
+    const int32 N = Weights.Num();
+    Reset();
+
+    double Total = 0.0;
+    for (float Weight : Weights)
+    {
+        Total += FMath::Max(Weight, 0.0f);
+    }
+
+    if (N == 0 || Total <= 0.0)
+        return;
+
+    Probability.SetNumUninitialized(N);
+    Alias.SetNumUninitialized(N);
+
+    // Scale so the average slot holds exactly 1.0
+    TArray<double> Scaled;
+    Scaled.SetNumUninitialized(N);
+
+    // Two stacks (Vose): slots under 1.0 borrow from slots over 1.0
+    TArray<int32> Small;
+    TArray<int32> Large;
+    Small.Reserve(N);
+    Large.Reserve(N);
+
+    for (int32 i = 0; i < N; i++)
+    {
+        Scaled[i] = FMath::Max(Weights[i], 0.0f) * N / Total;
+        Alias[i] = i;
+        if (Scaled[i] < 1.0)
+            Small.Push(i);
+        else
+            Large.Push(i);
+    }
+
+    while (Small.Num() > 0 && Large.Num() > 0)
+    {
+        const int32 Less = Small.Pop(EAllowShrinking::No);
+        const int32 More = Large.Pop(EAllowShrinking::No);
+
+        Probability[Less] = static_cast<float>(Scaled[Less]);
+        Alias[Less] = More;
+
+        // The large slot gives away what the small one was missing
+        Scaled[More] = (Scaled[More] + Scaled[Less]) - 1.0;
+        if (Scaled[More] < 1.0)
+            Small.Push(More);
+        else
+            Large.Push(More);
+    }
+
+    // Leftovers are 1.0 up to rounding error
+    for (int32 Index : Large)
+    {
+        Probability[Index] = 1.0f;
+    }
+    for (int32 Index : Small)
+    {
+        Probability[Index] = 1.0f;
+    }
+}
+
+inline int32 FAliasTable::Sample(float Uniform) const
+{
+    const int32 N = Probability.Num();
+    if (N == 0)
+        return INDEX_NONE;
+
+    // Integer part picks the slot, fractional part decides slot vs alias
+    const float Scaled = FMath::Clamp(Uniform, 0.0f, 1.0f) * N;
+    const int32 Slot = FMath::Min(static_cast<int32>(Scaled), N - 1);
+    const float Fraction = Scaled - Slot;
+
+    return Fraction < Probability[Slot] ? Slot : Alias[Slot];
+}
+
+inline void FAliasTable::Reset()
+{
+    Probability.Reset();
+    Alias.Reset();
+}
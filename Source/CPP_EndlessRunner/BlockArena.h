@@ -0,0 +1,84 @@
+// BlockArena.h - Fixed-size block allocator for small, trivially destructible nodes
+#pragma once
+
+#include "CoreMinimal.h"
+#include <type_traits>
+
+/**
+ * Hands out T slots from large blocks instead of one heap allocation per item
+ * Addresses stay stable until Reset(); freed slots go on an intrusive free list
+ * Reset() releases every block at once, without visiting items
+ * Time Complexity: O(1) New/Free, O(blocks) Reset
+ */
+template<typename T, int32 ItemsPerBlock = 4096>
+class TBlockArena
+{
+    static_assert(std::is_trivially_destructible_v<T>, "Reset() never runs destructors");
+    static_assert(ItemsPerBlock > 0, "Blocks need at least one item");
+
+private:
+    // A freed slot reuses its own storage as the free list link
+    union FSlot
+    {
+        FSlot* NextFree;
+        alignas(T) uint8 Storage[sizeof(T)];
+    };
+
+    TArray<FSlot*> Blocks;
+    int32 UsedInLastBlock;
+    FSlot* FreeList;
+    int32 NumLive;
+
+public:
+    TBlockArena() : UsedInLastBlock(ItemsPerBlock), FreeList(nullptr), NumLive(0) {}
+    ~TBlockArena() { Reset(); }
+
+    TBlockArena(const TBlockArena&) = delete;
+    TBlockArena& operator=(const TBlockArena&) = delete;
+
+    template<typename... ArgTypes>
+    T* New(ArgTypes&&... Args)
+    {
+        FSlot* Slot = FreeList;
+        if (Slot != nullptr)
+        {
+            FreeList = Slot->NextFree;
+        }
+        else
+        {
+            if (UsedInLastBlock == ItemsPerBlock)
+            {
+                Blocks.Add(static_cast<FSlot*>(FMemory::Malloc(sizeof(FSlot) * ItemsPerBlock, alignof(FSlot))));
+                UsedInLastBlock = 0;
+            }
+            Slot = &Blocks.Last()[UsedInLastBlock++];
+        }
+
+        NumLive++;
+        return new (Slot->Storage) T(Forward<ArgTypes>(Args)...);
+    }
+
+    void Free(T* Item)
+    {
+        FSlot* Slot = reinterpret_cast<FSlot*>(Item);
+        Slot->NextFree = FreeList;
+        FreeList = Slot;
+        NumLive--;
+    }
+
+    // Drops every item and block in one pass over the block list
+    void Reset()
+    {
+        for (FSlot* Block : Blocks)
+        {
+            FMemory::Free(Block);
+        }
+        Blocks.Empty();
+        UsedInLastBlock = ItemsPerBlock;
+        FreeList = nullptr;
+        NumLive = 0;
+    }
+
+    int32 Num() const { return NumLive; }
+    SIZE_T GetAllocatedSize() const { return Blocks.Num() * sizeof(FSlot) * ItemsPerBlock + Blocks.GetAllocatedSize(); }
+};
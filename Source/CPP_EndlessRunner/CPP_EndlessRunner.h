@@ -3,4 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Stats/Stats.h"
 
+// Counters shown in-game with "stat Runner"
+DECLARE_STATS_GROUP(TEXT("Runner"), STATGROUP_Runner, STATCAT_Advanced);
@@ -1,17 +1,73 @@
 // CPP_EndlessRunnerGameModeBase.cpp - FINAL FIXED VERSION
 #include "CPP_EndlessRunnerGameModeBase.h"
+#include "CPP_EndlessRunner.h"
 #include "FloorTile.h"
 #include "GameHudWidget.h"
 #include "Coin.h"
 #include "Obstacle.h"
+#include "RunnerBotController.h"
 #include "Components/ArrowComponent.h"
 #include "Kismet/GameplayStatics.h"
+#include "Misc/Paths.h"
+#include "Misc/CommandLine.h"
+#include "Stats/Stats.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "JsonObjectConverter.h"
 
 // Include our custom data structures
 #include "FloorTileQueue.h"
+#include "DeferredSpawnQueue.h"
 #include "ObjectPool.h"
 #include "LaneGraph.h"
+#include "LaneOccupancyIndex.h"
 #include "ScoreBST.h"
+#include "TimeWindowedLeaderboard.h"
+#include "TrackPatternLibrary.h"
+#include "DifficultyCurves.h"
+#include "LeaderboardStore.h"
+#include "RunTimeSeries.h"
+#include "ScoreSubmitter.h"
+#include "QuantileSketch.h"
+#include "RadixSort.h"
+#include "SortedSearch.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Spawn Queue Depth"), STAT_RunnerSpawnQueueDepth, STATGROUP_Runner);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Spawn Budget Overruns"), STAT_RunnerSpawnBudgetOverruns, STATGROUP_Runner);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Spawn Frame Time (ms)"), STAT_RunnerSpawnFrameMs, STATGROUP_Runner);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Sim Speed (sim s / wall s)"), STAT_RunnerSimSpeed, STATGROUP_Runner);
+
+// Fixed-step totals carry over level restarts
+static FSimulationStats GProcessSimulationStats;
+
+ACPP_EndlessRunnerGameModeBase::ACPP_EndlessRunnerGameModeBase()
+{
+	// Deferred spawns are drained once per frame, after physics has
+	// dispatched this frame's overlaps (which is where tile requests come from)
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.TickGroup = TG_PostPhysics;
+}
+
+void ACPP_EndlessRunnerGameModeBase::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	if (SpawnQueue && !SpawnQueue->IsEmpty())
+	{
+		ProcessSpawnQueue();
+	}
+
+	if (bFixedStepSim)
+	{
+		TickFixedStepSim(DeltaSeconds);
+	}
+
+	// Compaction runs on a pool thread; this only starts it or swaps in the result
+	if (Leaderboard)
+	{
+		Leaderboard->UpdateCompaction();
+	}
+}
 
 void ACPP_EndlessRunnerGameModeBase::BeginPlay()
 {
@@ -35,6 +91,12 @@ void ACPP_EndlessRunnerGameModeBase::BeginPlay()
 	Super::BeginPlay();
 	UGameplayStatics::GetPlayerController(GetWorld(), 0)->bShowMouseCursor = true;
 
+	// Decoupled from wall-clock time: -RunnerSim [-RunnerSimHz=60] [-RunnerSimSeconds=3600]
+	if (FParse::Param(FCommandLine::Get(), TEXT("RunnerSim")))
+	{
+		StartFixedStepSim();
+	}
+
 	GameHud = Cast<UGameHudWidget>(CreateWidget(GetWorld(), GameHudWidgetClass));
 	check(GameHud);
 	GameHud->InitHud(this);
@@ -42,10 +104,99 @@ void ACPP_EndlessRunnerGameModeBase::BeginPlay()
 
 	CurrentLivesCount = MaxLives;
 
+	// Difficulty can be picked from the level URL, e.g. "MainLevel?Difficulty=Hard"
+	const FString DifficultyOption = UGameplayStatics::ParseOption(OptionsString, TEXT("Difficulty"));
+	if (!DifficultyOption.IsEmpty())
+	{
+		DifficultyPreset = DifficultyOption;
+	}
+
+	// Seeded before anything is spawned, e.g. "MainLevel?Seed=42" or -RunnerSeed=42
+	int32 Seed = RandomSeed;
+	FParse::Value(FCommandLine::Get(), TEXT("RunnerSeed="), Seed);
+	const FString SeedOption = UGameplayStatics::ParseOption(OptionsString, TEXT("Seed"));
+	if (!SeedOption.IsEmpty())
+	{
+		Seed = FCString::Atoi(*SeedOption);
+	}
+	static int32 NumSeededLoads = 0;
+	SpawnRandom.Initialize(Seed != 0 ? Seed + NumSeededLoads++ : FMath::Rand());
+	UE_LOG(LogTemp, Warning, TEXT("Spawn seed: %d"), SpawnRandom.GetInitialSeed());
+
 	// Initialize Data Structures
 	InitializeDataStructures();
 
+#if !UE_BUILD_SHIPPING
+	// Poll the difficulty config so curves can be tuned while playing (shipped configs never change)
+	if (DifficultyReloadInterval > 0.0f)
+	{
+		GetWorldTimerManager().SetTimer(DifficultyReloadHandle, this,
+			&ACPP_EndlessRunnerGameModeBase::CheckDifficultyConfigChanged, DifficultyReloadInterval, true);
+	}
+#endif
+
 	CreateInitialFloorTiles();
+
+	// Autopilot for soak runs: -RunnerBot on the command line or ?Bot on the level URL
+	bBotActive = FParse::Param(FCommandLine::Get(), TEXT("RunnerBot")) || UGameplayStatics::HasOption(OptionsString, TEXT("Bot"));
+	if (bBotActive)
+	{
+		GetWorld()->SpawnActor<ARunnerBotController>();
+	}
+}
+
+void ACPP_EndlessRunnerGameModeBase::StartFixedStepSim()
+{
+	FParse::Value(FCommandLine::Get(), TEXT("RunnerSimHz="), SimStepHz);
+	FParse::Value(FCommandLine::Get(), TEXT("RunnerSimSeconds="), SimDurationSeconds);
+	SimStepHz = FMath::Max(SimStepHz, 1.0f);
+
+	// The engine's fixed time step: the game clock (and with it movement, world
+	// timers and FApp time) advances by exactly one step per frame, with no frame
+	// rate limiting or waiting on the wall clock between frames
+	FApp::SetUseFixedTimeStep(true);
+	FApp::SetFixedDeltaTime(1.0 / SimStepHz);
+
+	bFixedStepSim = true;
+	SimulationStats = GProcessSimulationStats;
+	SimLastWallTime = SimReportWallTime = FPlatformTime::Seconds();
+	SimReportSimSeconds = 0.0;
+
+	UE_LOG(LogTemp, Warning, TEXT("Fixed-step simulation at %.0f Hz (%.0f s simulated so far)"), SimStepHz, SimulationStats.SimSeconds);
+}
+
+void ACPP_EndlessRunnerGameModeBase::TickFixedStepSim(float DeltaSeconds)
+{
+	const double Now = FPlatformTime::Seconds();
+	SimulationStats.Steps++;
+	SimulationStats.SimSeconds += DeltaSeconds;
+	SimulationStats.WallSeconds += Now - SimLastWallTime;
+	SimLastWallTime = Now;
+	SimReportSimSeconds += DeltaSeconds;
+
+	const double ReportWallSeconds = Now - SimReportWallTime;
+	if (ReportWallSeconds >= SimReportInterval)
+	{
+		SimulationStats.SimSecondsPerWallSecond = static_cast<float>(SimReportSimSeconds / ReportWallSeconds);
+		SET_FLOAT_STAT(STAT_RunnerSimSpeed, SimulationStats.SimSecondsPerWallSecond);
+		UE_LOG(LogTemp, Warning, TEXT("Sim: %.1f simulated s per wall-clock s (%.0f steps/s), %.0f s simulated in %.0f s"),
+			SimulationStats.SimSecondsPerWallSecond, SimReportSimSeconds * SimStepHz / ReportWallSeconds,
+			SimulationStats.SimSeconds, SimulationStats.WallSeconds);
+
+		SimReportWallTime = Now;
+		SimReportSimSeconds = 0.0;
+	}
+
+	GProcessSimulationStats = SimulationStats;
+
+	if (SimDurationSeconds > 0.0f && SimulationStats.SimSeconds >= SimDurationSeconds)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Sim: done, %.0f s simulated in %.1f s of wall-clock time (%.1f simulated s per wall-clock s, %d steps)"),
+			SimulationStats.SimSeconds, SimulationStats.WallSeconds,
+			SimulationStats.SimSeconds / FMath::Max(SimulationStats.WallSeconds, UE_SMALL_NUMBER), SimulationStats.Steps);
+		bFixedStepSim = false;
+		FPlatformMisc::RequestExit(false, TEXT("RunnerSim"));
+	}
 }
 
 int32 ACPP_EndlessRunnerGameModeBase::GetNextPoolID()
@@ -92,10 +243,67 @@ void ACPP_EndlessRunnerGameModeBase::InitializeDataStructures()
 	UE_LOG(LogTemp, Warning, TEXT("Lane Graph initialized"));
 
 	// 4. Initialize Score BST
-	ScoreBST = MakeShared<FScoreBST>();
+	TSharedRef<FPlayerNameTable> PlayerNames = MakeShared<FPlayerNameTable>();
+	ScoreBST = MakeShared<FScoreBST>(PlayerNames);
+	ScoreBST->EnableSnapshots();
+	ScoreWindows = MakeShared<FTimeWindowedLeaderboard>(PlayerNames);
+	LocalPlayerNameId = ScoreBST->InternPlayerName(TEXT("Player"));
+	LoadScoreWindows();
 	UE_LOG(LogTemp, Warning, TEXT("Score BST initialized"));
 
-	// 5. Initialize Pool ID tracking maps
+	// 4b. Per-run time series (the BST only receives final scores)
+	RunSeries = MakeShared<FRunTimeSeries>();
+	RunStartTime = GetWorld()->GetTimeSeconds();
+	RunDistanceOffset = 0.0f;
+	LastRunnerDistance = 0.0f;
+
+	// 5. Initialize Lane Occupancy Index (lanes are sized after first tile)
+	LaneOccupancy = MakeShared<FLaneOccupancyIndex>();
+	CoinOccupancy = MakeShared<FLaneOccupancyIndex>();
+	UE_LOG(LogTemp, Warning, TEXT("Lane Occupancy Index initialized"));
+
+	// 6. Map the hand-authored pattern library (optional, tables bounds-checked once)
+	PatternLibrary = MakeShared<FTrackPatternLibrary>();
+	PatternLibrary->Load(FPaths::Combine(FPaths::ProjectContentDir(), PatternLibraryFile));
+	ActivePattern = nullptr;
+
+	// 7. Priority queue for spawns deferred out of overlap callbacks
+	SpawnQueue = MakeShared<FDeferredSpawnQueue>();
+	SpawnQueueStats = FSpawnQueueStats();
+
+	// 8. Difficulty curves baked into lookup tables
+	DifficultyTables = MakeShared<FDifficultyTables>();
+	ReloadDifficultyConfig();
+
+	// 9. Persistent leaderboard (maps the snapshot, replays only the recent log)
+	Leaderboard = MakeShared<FLeaderboardStore>();
+	Leaderboard->SetCompactThreshold(LeaderboardCompactThreshold);
+	Leaderboard->Open(FPaths::Combine(FPaths::ProjectSavedDir(), LeaderboardDirectory));
+
+	// Best run saved next to the leaderboard, for ghost comparisons
+	GhostSeries = MakeShared<FRunTimeSeries>();
+	TArray<uint8> GhostBytes;
+	if (FFileHelper::LoadFileToArray(GhostBytes, *GetGhostFilePath(), FILEREAD_Silent) && !GhostSeries->Load(GhostBytes))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Ghost run %s is invalid, ignoring it"), *GetGhostFilePath());
+	}
+
+	// 10. Score submission (resends anything a previous session left in the outbox)
+	if (!ScoreServiceUrl.IsEmpty())
+	{
+		ScoreSubmitter = MakeShared<FScoreSubmitter>();
+		ScoreSubmitter->Start(FPaths::Combine(FPaths::ProjectSavedDir(), LeaderboardDirectory, TEXT("Outbox")), ScoreServiceUrl);
+	}
+
+	// 11. Score distribution sketch (merged across sessions, bounded size)
+	ScoreSketch = MakeShared<FQuantileSketch>();
+	TArray<uint8> SketchBytes;
+	if (FFileHelper::LoadFileToArray(SketchBytes, *GetScoreSketchFilePath(), FILEREAD_Silent) && !ScoreSketch->Load(SketchBytes))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Score sketch %s is invalid, starting a new one"), *GetScoreSketchFilePath());
+	}
+
+	// 12. Initialize Pool ID tracking maps
 	CoinPoolIDs.Empty();
 	ObstaclePoolIDs.Empty();
 
@@ -104,9 +312,16 @@ void ACPP_EndlessRunnerGameModeBase::InitializeDataStructures()
 
 void ACPP_EndlessRunnerGameModeBase::CreateInitialFloorTiles()
 {
+	// Track distances are measured from where the first tile goes
+	TrackOrigin = NextSpawnPoint.GetLocation();
+	TrackForward = NextSpawnPoint.GetRotation().GetForwardVector();
+
 	// Spawn first tile and initialize lane graph
 	if (const AFloorTile* Tile = AddFloorTile(false))
 	{
+		// PlayerDied rebuilds the track through here: refill, don't append a second set of lanes
+		LaneSwitchValues.Reset();
+
 		// FIXED: Use accessor functions instead of direct access to protected members
 		if (Tile->GetLeftLane() && Tile->GetCenterLane() && Tile->GetRightLane())
 		{
@@ -131,20 +346,34 @@ void ACPP_EndlessRunnerGameModeBase::CreateInitialFloorTiles()
 		// Initialize Graph with lane positions
 		LaneGraph->Initialize(LaneSwitchValues);
 		UE_LOG(LogTemp, Warning, TEXT("Lane Graph initialized with %d lanes"), LaneSwitchValues.Num());
+
+		LaneOccupancy->Initialize(LaneSwitchValues.Num());
+		CoinOccupancy->Initialize(LaneSwitchValues.Num());
 	}
 
+	// The runner stands on these straight away, so they are not deferred
 	AddFloorTile(false);
 	AddFloorTile(false);
 
-	// Create initial tiles
-	UE_LOG(LogTemp, Warning, TEXT("Creating %d initial floor tiles"), NumInitialFloorTiles);
+	// Create initial tiles (spread over the next frames by the spawn budget)
+	UE_LOG(LogTemp, Warning, TEXT("Queueing %d initial floor tiles"), NumInitialFloorTiles);
 	for (int i = 0; i < NumInitialFloorTiles; i++)
 	{
-		AddFloorTile(true);
+		QueueFloorTile(true);
 	}
 }
 
 const AFloorTile* ACPP_EndlessRunnerGameModeBase::AddFloorTile(const bool bSpawnItems)
+{
+	AFloorTile* Tile = SpawnFloorTile(NextSpawnPoint, bSpawnItems);
+	if (Tile)
+	{
+		NextSpawnPoint = Tile->GetAttachTransform();
+	}
+	return Tile;
+}
+
+AFloorTile* ACPP_EndlessRunnerGameModeBase::SpawnFloorTile(const FTransform& SpawnTransform, const bool bSpawnItems)
 {
 	if (UWorld* World = GetWorld())
 	{
@@ -155,9 +384,9 @@ const AFloorTile* ACPP_EndlessRunnerGameModeBase::AddFloorTile(const bool bSpawn
 		}
 
 		UE_LOG(LogTemp, Warning, TEXT("Spawning floor tile at location: %s"),
-			*NextSpawnPoint.GetLocation().ToString());
+			*SpawnTransform.GetLocation().ToString());
 
-		AFloorTile* Tile = World->SpawnActor<AFloorTile>(FloorTileClass, NextSpawnPoint);
+		AFloorTile* Tile = World->SpawnActor<AFloorTile>(FloorTileClass, SpawnTransform);
 		if (Tile)
 		{
 			UE_LOG(LogTemp, Warning, TEXT("Floor tile spawned: %s"), *Tile->GetName());
@@ -174,7 +403,6 @@ const AFloorTile* ACPP_EndlessRunnerGameModeBase::AddFloorTile(const bool bSpawn
 			{
 				UE_LOG(LogTemp, Warning, TEXT("Tile %s will not spawn items (bSpawnItems = false)"), *Tile->GetName());
 			}
-			NextSpawnPoint = Tile->GetAttachTransform();
 		}
 		else
 		{
@@ -185,6 +413,86 @@ const AFloorTile* ACPP_EndlessRunnerGameModeBase::AddFloorTile(const bool bSpawn
 	return nullptr;
 }
 
+void ACPP_EndlessRunnerGameModeBase::QueueFloorTile(const bool bSpawnItems)
+{
+	if (!FloorTileClass)
+	{
+		UE_LOG(LogTemp, Error, TEXT("FloorTileClass is not set! Cannot queue floor tile."));
+		return;
+	}
+
+	// Every tile is the same class, so its attach point offset is known up front
+	// and the spawn point can advance now instead of after the tile exists
+	const UArrowComponent* AttachPoint = FloorTileClass->GetDefaultObject<AFloorTile>()->GetAttachPointComponent();
+
+	FDeferredSpawnRequest Request;
+	Request.Type = EDeferredSpawnType::Tile;
+	Request.Transform = NextSpawnPoint;
+	Request.TrackDistance = GetTrackDistance(NextSpawnPoint.GetLocation());
+	Request.bSpawnItems = bSpawnItems;
+
+	// PRIORITY QUEUE: O(log n)
+	SpawnQueue->Push(Request);
+
+	NextSpawnPoint = AttachPoint ? AttachPoint->GetRelativeTransform() * NextSpawnPoint : NextSpawnPoint;
+}
+
+// Drain deferred spawns, nearest first, until the frame budget is used up
+void ACPP_EndlessRunnerGameModeBase::ProcessSpawnQueue()
+{
+	const double StartTime = FPlatformTime::Seconds();
+	const double BudgetSeconds = SpawnBudgetMs / 1000.0;
+	int32 Processed = 0;
+
+	FDeferredSpawnRequest Request;
+	while (SpawnQueue->Pop(Request))
+	{
+		if (Request.Type == EDeferredSpawnType::Tile)
+		{
+			AFloorTile* Tile = SpawnFloorTile(Request.Transform, false);
+			if (Tile && Request.bSpawnItems)
+			{
+				// Items are their own request so a far tile's items never delay a near tile
+				FDeferredSpawnRequest ItemsRequest;
+				ItemsRequest.Type = EDeferredSpawnType::Items;
+				ItemsRequest.Tile = Tile;
+				ItemsRequest.TrackDistance = Request.TrackDistance;
+				SpawnQueue->Push(ItemsRequest);
+			}
+		}
+		else if (AFloorTile* Tile = Request.Tile.Get())
+		{
+			SpawnItemsUsingPool(Tile);
+		}
+		Processed++;
+
+		// At least one request per frame so the queue always makes progress.
+		// A fixed-step run drains everything: a wall-clock budget would make
+		// when tiles appear depend on how fast the machine is
+		if (!bFixedStepSim && FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+		{
+			break;
+		}
+	}
+
+	const float ElapsedMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	SpawnQueueStats.QueueDepth = SpawnQueue->Num();
+	SpawnQueueStats.PeakQueueDepth = SpawnQueue->GetPeakDepth();
+	SpawnQueueStats.LastFrameRequests = Processed;
+	SpawnQueueStats.TotalRequests += Processed;
+	SpawnQueueStats.LastFrameMs = ElapsedMs;
+	SpawnQueueStats.MaxFrameMs = FMath::Max(SpawnQueueStats.MaxFrameMs, ElapsedMs);
+	if (Processed > 0 && ElapsedMs > SpawnBudgetMs)
+	{
+		SpawnQueueStats.BudgetOverruns++;
+	}
+
+	SET_DWORD_STAT(STAT_RunnerSpawnQueueDepth, SpawnQueueStats.QueueDepth);
+	SET_DWORD_STAT(STAT_RunnerSpawnBudgetOverruns, SpawnQueueStats.BudgetOverruns);
+	SET_FLOAT_STAT(STAT_RunnerSpawnFrameMs, ElapsedMs);
+}
+
 void ACPP_EndlessRunnerGameModeBase::SpawnItemsUsingPool(AFloorTile* Tile)
 {
 	if (!Tile)
@@ -220,18 +528,38 @@ void ACPP_EndlessRunnerGameModeBase::SpawnItemsUsingPool(AFloorTile* Tile)
 		Tile->GetRightLane()
 	};
 
+	// ALIAS TABLES: Rebuild only if the spawn config changed since last tile
+	if (bSpawnTablesDirty)
+	{
+		RebuildSpawnTables();
+	}
+
+	const float TileDistance = GetTrackDistance(Tile->GetActorLocation());
+
+	const int32 BandIndex = FindSpawnBandIndex(TileDistance);
+	const FCompiledSpawnBand* Band = CompiledSpawnBands.IsValidIndex(BandIndex) ? &CompiledSpawnBands[BandIndex] : nullptr;
+
+	// LOOKUP TABLE: difficulty curves drive spawning unless bands were hand-authored
+	const FCompiledSpawnTable* CurveTable = SpawnBands.Num() == 0 ? DifficultyTables->GetSpawnTable(TileDistance) : nullptr;
+
+	// PATTERN LIBRARY: a pattern row overrides random sampling for the whole tile
+	// Hand-authored bands double as pattern tiers; otherwise the curves bake one per distance step
+	const int32 PatternTier = SpawnBands.Num() > 0 ? FMath::Max(BandIndex, 0) : DifficultyTables->GetPatternTier(TileDistance);
+	const uint8* PatternRow = NextPatternRow(PatternTier, Lanes.Num());
+
+	if (!Band && !CurveTable && !PatternRow)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("No spawn tables configured, tile %s stays empty"), *Tile->GetName());
+		return;
+	}
+
 	int32 spawnedItems = 0;
+	int32 BigObstaclesCount = 0;
 
 	for (int32 LaneIdx = 0; LaneIdx < Lanes.Num(); LaneIdx++)
 	{
-		// Check if lane is blocked in graph
-		if (LaneGraph->IsLaneBlocked(LaneIdx))
-		{
-			UE_LOG(LogTemp, Warning, TEXT("Lane %d is blocked, skipping"), LaneIdx);
-			continue;
-		}
-
-		const float RandVal = FMath::FRandRange(0.0f, 1.0f);
+		// NOTE: LaneGraph blocked state now tracks obstacles ahead of the runner
+		// (see UpdateLaneBlocking), so it no longer gates spawning at the far end
 
 		// Check if lane component is valid
 		if (!Lanes[LaneIdx])
@@ -240,131 +568,258 @@ void ACPP_EndlessRunnerGameModeBase::SpawnItemsUsingPool(AFloorTile* Tile)
 			continue;
 		}
 
-		const FTransform& SpawnLocation = Lanes[LaneIdx]->GetComponentTransform();
-
-		UE_LOG(LogTemp, Warning, TEXT("Lane %d: Random value = %.2f"), LaneIdx, RandVal);
+		ESpawnItemKind Kind = ESpawnItemKind::None;
+		if (PatternRow)
+		{
+			Kind = static_cast<ESpawnItemKind>(PatternRow[LaneIdx]);
+		}
+		else if (const FCompiledSpawnTable* Table = CurveTable ? CurveTable : Band->GetLaneTable(LaneIdx))
+		{
+			// ALIAS METHOD: O(1) weighted pick no matter how many outcomes the table has
+			Kind = Table->Sample(SpawnRandom.FRand());
+		}
 
-		// ===== TEMPORARY TEST: DIRECT SPAWN (bypass object pool) =====
-		// Spawn obstacle (10-30% chance)
-		if (RandVal >= 0.1f && RandVal < 0.3f)
+		// Only a limited number of big obstacles per tile so there is always a way through
+		if (Kind == ESpawnItemKind::BigObstacle && (BigObstaclesCount >= MaxBigObstaclesPerTile || !BigObstacleClass))
 		{
-			UE_LOG(LogTemp, Warning, TEXT("  Attempting to DIRECTLY spawn obstacle in lane %d"), LaneIdx);
+			Kind = ESpawnItemKind::SmallObstacle;
+		}
 
-			// DIRECT SPAWN INSTEAD OF POOL (Temporary test)
-			AObstacle* Obstacle = GetWorld()->SpawnActor<AObstacle>(SmallObstacleClass, SpawnLocation);
-			if (Obstacle)
-			{
-				UE_LOG(LogTemp, Warning, TEXT("  SUCCESS: Obstacle spawned directly: %s at location: %s"),
-					*Obstacle->GetName(),
-					*SpawnLocation.GetLocation().ToString());
+		const FTransform& SpawnLocation = Lanes[LaneIdx]->GetComponentTransform();
 
-				// Assign a pool ID and track it
-				int32 PoolID = GetNextPoolID();
-				Obstacle->SetPoolID(PoolID);
-				ObstaclePoolIDs.Add(Obstacle, PoolID);
+		UE_LOG(LogTemp, Warning, TEXT("Lane %d: Sampled %s"), LaneIdx, *UEnum::GetValueAsString(Kind));
 
-				Tile->AddPooledActor(Obstacle);
-				spawnedItems++;
-			}
-			else
+		switch (Kind)
+		{
+		case ESpawnItemKind::SmallObstacle:
+			if (SpawnObstacleInLane(Tile, SmallObstacleClass, SpawnLocation, LaneIdx))
 			{
-				UE_LOG(LogTemp, Error, TEXT("  FAILED: Could not spawn obstacle directly!"));
+				spawnedItems++;
 			}
-		}
-		// Spawn coin (50-100% chance)
-		else if (RandVal >= 0.5f)
-		{
-			UE_LOG(LogTemp, Warning, TEXT("  Attempting to DIRECTLY spawn coin in lane %d"), LaneIdx);
+			break;
 
-			// DIRECT SPAWN INSTEAD OF POOL (Temporary test)
-			ACoin* Coin = GetWorld()->SpawnActor<ACoin>(CoinClass, SpawnLocation);
-			if (Coin)
+		case ESpawnItemKind::BigObstacle:
+			if (SpawnObstacleInLane(Tile, BigObstacleClass, SpawnLocation, LaneIdx))
 			{
-				UE_LOG(LogTemp, Warning, TEXT("  SUCCESS: Coin spawned directly: %s at location: %s"),
-					*Coin->GetName(),
-					*SpawnLocation.GetLocation().ToString());
-
-				// Assign a pool ID and track it
-				int32 PoolID = GetNextPoolID();
-				Coin->SetPoolID(PoolID);
-				CoinPoolIDs.Add(Coin, PoolID);
-
-				Tile->AddPooledActor(Coin);
+				BigObstaclesCount++;
 				spawnedItems++;
 			}
-			else
+			break;
+
+		case ESpawnItemKind::Coin:
+			if (SpawnCoinInLane(Tile, SpawnLocation, LaneIdx))
 			{
-				UE_LOG(LogTemp, Error, TEXT("  FAILED: Could not spawn coin directly!"));
+				spawnedItems++;
 			}
+			break;
+
+		default:
+			UE_LOG(LogTemp, Warning, TEXT("  Nothing to spawn in lane %d"), LaneIdx);
+			break;
 		}
-		/* ===== ORIGINAL OBJECT POOL CODE (COMMENTED OUT FOR TESTING) =====
-		// Spawn obstacle from pool (10-30% chance)
-		if (RandVal >= 0.1f && RandVal < 0.3f)
-		{
-			UE_LOG(LogTemp, Warning, TEXT("  Attempting to spawn obstacle from pool in lane %d"), LaneIdx);
+	}
 
-			// OBJECT POOL: Acquire obstacle from pool (O(1) hash map operation)
-			AObstacle* Obstacle = ObstaclePool->Acquire(SpawnLocation);
-			if (Obstacle)
-			{
-				// Assign a pool ID and track it
-				int32 PoolID = GetNextPoolID();
-				Obstacle->SetPoolID(PoolID);
-				ObstaclePoolIDs.Add(Obstacle, PoolID);
+	UE_LOG(LogTemp, Warning, TEXT("=== Total spawned items: %d ==="), spawnedItems);
+}
 
-				UE_LOG(LogTemp, Warning, TEXT("  SUCCESS: Obstacle acquired from pool: %s (Pool ID: %d)"),
-					*Obstacle->GetName(), PoolID);
+AObstacle* ACPP_EndlessRunnerGameModeBase::SpawnObstacleInLane(AFloorTile* Tile, TSubclassOf<AObstacle> ObstacleClass,
+	const FTransform& SpawnLocation, int32 LaneIdx)
+{
+	UE_LOG(LogTemp, Warning, TEXT("  Attempting to DIRECTLY spawn obstacle in lane %d"), LaneIdx);
 
-				Tile->AddPooledActor(Obstacle);
-				spawnedItems++;
-			}
-			else
-			{
-				UE_LOG(LogTemp, Error, TEXT("  FAILED: Could not acquire obstacle from pool!"));
-			}
-		}
-		// Spawn coin from pool (50-100% chance)
-		else if (RandVal >= 0.5f)
-		{
-			UE_LOG(LogTemp, Warning, TEXT("  Attempting to spawn coin from pool in lane %d"), LaneIdx);
+	// DIRECT SPAWN INSTEAD OF POOL (Temporary test)
+	AObstacle* Obstacle = GetWorld()->SpawnActor<AObstacle>(ObstacleClass, SpawnLocation);
+	if (!Obstacle)
+	{
+		UE_LOG(LogTemp, Error, TEXT("  FAILED: Could not spawn obstacle directly!"));
+		return nullptr;
+	}
 
-			// OBJECT POOL: Acquire coin from pool (O(1) hash map operation)
-			ACoin* Coin = CoinPool->Acquire(SpawnLocation);
-			if (Coin)
-			{
-				// Assign a pool ID and track it
-				int32 PoolID = GetNextPoolID();
-				Coin->SetPoolID(PoolID);
-				CoinPoolIDs.Add(Coin, PoolID);
+	UE_LOG(LogTemp, Warning, TEXT("  SUCCESS: Obstacle spawned directly: %s at location: %s"),
+		*Obstacle->GetName(),
+		*SpawnLocation.GetLocation().ToString());
 
-				UE_LOG(LogTemp, Warning, TEXT("  SUCCESS: Coin acquired from pool: %s (Pool ID: %d)"),
-					*Coin->GetName(), PoolID);
+	// Assign a pool ID and track it
+	int32 PoolID = GetNextPoolID();
+	Obstacle->SetPoolID(PoolID);
+	ObstaclePoolIDs.Add(Obstacle, PoolID);
 
-				Tile->AddPooledActor(Coin);
-				spawnedItems++;
-			}
-			else
-			{
-				UE_LOG(LogTemp, Error, TEXT("  FAILED: Could not acquire coin from pool!"));
-			}
-		}
-		*/
-		else
+	// SORTED INDEX: Record obstacle for lane blocking queries (O(1))
+	LaneOccupancy->AddObstacle(LaneIdx, GetTrackDistance(SpawnLocation.GetLocation()));
+
+	Tile->AddPooledActor(Obstacle);
+	return Obstacle;
+}
+
+ACoin* ACPP_EndlessRunnerGameModeBase::SpawnCoinInLane(AFloorTile* Tile, const FTransform& SpawnLocation, int32 LaneIdx)
+{
+	// DIRECT SPAWN INSTEAD OF POOL (Temporary test)
+	ACoin* Coin = GetWorld()->SpawnActor<ACoin>(CoinClass, SpawnLocation);
+	if (!Coin)
+	{
+		UE_LOG(LogTemp, Error, TEXT("  FAILED: Could not spawn coin directly!"));
+		return nullptr;
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("  SUCCESS: Coin spawned directly: %s at location: %s"),
+		*Coin->GetName(),
+		*SpawnLocation.GetLocation().ToString());
+
+	// Assign a pool ID and track it
+	int32 PoolID = GetNextPoolID();
+	Coin->SetPoolID(PoolID);
+	CoinPoolIDs.Add(Coin, PoolID);
+
+	// SORTED INDEX: Coins ahead per lane, for the bot (O(1))
+	CoinOccupancy->AddObstacle(LaneIdx, GetTrackDistance(SpawnLocation.GetLocation()));
+
+	Tile->AddPooledActor(Coin);
+	return Coin;
+}
+
+// Compile SpawnBands into alias tables - O(total outcomes), only when config changes
+void ACPP_EndlessRunnerGameModeBase::RebuildSpawnTables()
+{
+	CompiledSpawnBands.Reset();
+
+	TArray<FSpawnBand> Bands = SpawnBands;
+	if (Bands.Num() == 0 && FloorTileClass)
+	{
+		// Fallback: thresholds from the floor tile's SpawnPercent values
+		const AFloorTile* TileDefaults = FloorTileClass->GetDefaultObject<AFloorTile>();
+
+		FSpawnBand& Band = Bands.AddDefaulted_GetRef();
+		Band.Lanes.Add(FSpawnLaneTable::FromThresholds(
+			TileDefaults->GetSpawnPercent1(), TileDefaults->GetSpawnPercent2(), TileDefaults->GetSpawnPercent3()));
+	}
+
+	// Bands are looked up by distance, keep them ascending
+	Bands.Sort([](const FSpawnBand& A, const FSpawnBand& B) { return A.MinDistance < B.MinDistance; });
+
+	for (const FSpawnBand& Band : Bands)
+	{
+		FCompiledSpawnBand& Compiled = CompiledSpawnBands.AddDefaulted_GetRef();
+		Compiled.MinDistance = Band.MinDistance;
+		for (const FSpawnLaneTable& LaneTable : Band.Lanes)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("  Nothing to spawn in lane %d (RandVal = %.2f)"), LaneIdx, RandVal);
+			Compiled.Lanes.AddDefaulted_GetRef().Build(LaneTable);
 		}
 	}
 
-	UE_LOG(LogTemp, Warning, TEXT("=== Total spawned items: %d ==="), spawnedItems);
+	bSpawnTablesDirty = false;
+	UE_LOG(LogTemp, Warning, TEXT("Spawn tables rebuilt: %d bands"), CompiledSpawnBands.Num());
+}
+
+// Binary Search - last band whose MinDistance <= Distance
+int32 ACPP_EndlessRunnerGameModeBase::FindSpawnBandIndex(float Distance) const
+{
+	int32 Left = 0;
+	int32 Right = CompiledSpawnBands.Num();
+
+	while (Left < Right)
+	{
+		const int32 Mid = Left + (Right - Left) / 2;
+		if (CompiledSpawnBands[Mid].MinDistance <= Distance)
+			Left = Mid + 1;
+		else
+			Right = Mid;
+	}
+
+	// Before the first band: use the first band
+	if (CompiledSpawnBands.Num() == 0)
+		return INDEX_NONE;
+	return FMath::Max(Left - 1, 0);
+}
+
+// Next tile row of the active pattern, starting a new one by chance - O(1)
+const uint8* ACPP_EndlessRunnerGameModeBase::NextPatternRow(int32 Difficulty, int32 NumLanes)
+{
+	if (!PatternLibrary || !PatternLibrary->IsLoaded())
+		return nullptr;
+
+	if (!ActivePattern && SpawnRandom.FRand() < PatternChance)
+	{
+		ActivePattern = PatternLibrary->PickPattern(Difficulty, NumLanes, SpawnRandom.FRand());
+		ActivePatternTile = 0;
+	}
+
+	if (!ActivePattern)
+		return nullptr;
+
+	const uint8* Row = PatternLibrary->GetTileRow(*ActivePattern, ActivePatternTile++);
+	if (ActivePatternTile >= ActivePattern->NumTiles)
+	{
+		ActivePattern = nullptr;
+	}
+	return Row;
+}
+
+// Load the difficulty file and bake the active preset - O(table size), never per tile
+bool ACPP_EndlessRunnerGameModeBase::ReloadDifficultyConfig()
+{
+	const FString Filename = FPaths::Combine(FPaths::ProjectContentDir(), DifficultyConfigFile);
+	DifficultyConfigTimestamp = IFileManager::Get().GetTimeStamp(*Filename);
+
+	FString Json;
+	FDifficultyConfig Config;
+	if (!FFileHelper::LoadFileToString(Json, *Filename) || !FJsonObjectConverter::JsonObjectStringToUStruct(Json, &Config))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Difficulty config %s missing or invalid, keeping current tables"), *Filename);
+		return false;
+	}
+
+	const FDifficultyPreset* Preset = Config.FindPreset(DifficultyPreset);
+	if (!Preset)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Difficulty preset '%s' not found in %s"), *DifficultyPreset, *Filename);
+		return false;
+	}
+
+	DifficultyTables->Bake(Config, *Preset);
+	UE_LOG(LogTemp, Warning, TEXT("Difficulty '%s' baked from %s"), *Preset->Name, *Filename);
+	return true;
+}
+
+// Timer callback - a timestamp check, the file is only re-read when it changed
+void ACPP_EndlessRunnerGameModeBase::CheckDifficultyConfigChanged()
+{
+	const FString Filename = FPaths::Combine(FPaths::ProjectContentDir(), DifficultyConfigFile);
+	if (IFileManager::Get().GetTimeStamp(*Filename) != DifficultyConfigTimestamp)
+	{
+		ReloadDifficultyConfig();
+	}
+}
+
+float ACPP_EndlessRunnerGameModeBase::GetRunSpeedAt(const FVector& Location) const
+{
+	return DifficultyTables ? DifficultyTables->GetRunSpeed(GetTrackDistance(Location)) : 0.0f;
+}
+
+void ACPP_EndlessRunnerGameModeBase::SetSpawnBands(const TArray<FSpawnBand>& NewBands)
+{
+	SpawnBands = NewBands;
+	bSpawnTablesDirty = true;
 }
 
+#if WITH_EDITOR
+void ACPP_EndlessRunnerGameModeBase::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(ACPP_EndlessRunnerGameModeBase, SpawnBands))
+	{
+		bSpawnTablesDirty = true;
+	}
+}
+#endif
+
 void ACPP_EndlessRunnerGameModeBase::AddCoin()
 {
 	TotalCoins++;
 	OnCoinsCountChanged.Broadcast(TotalCoins);
 
-	// BST OPERATION: Insert score into BST (O(log n))
-	ScoreBST->Insert(TotalCoins, TEXT("Player"));
+	// TIME SERIES: a few bytes per pickup; the BST gets the final score at GameOver
+	RecordRunSample();
 
 	UE_LOG(LogTemp, Warning, TEXT("Coin collected! Total coins: %d"), TotalCoins);
 }
@@ -390,8 +845,17 @@ void ACPP_EndlessRunnerGameModeBase::PlayerDied()
 			}
 		}
 
+		// The track restarts, the run distance carries on
+		RecordRunSample();
+		RunDistanceOffset += LastRunnerDistance;
+		LastRunnerDistance = 0.0f;
+
 		// Reset state
 		NextSpawnPoint = FTransform();
+		SpawnQueue->Reset();
+		LaneOccupancy->Clear();
+		CoinOccupancy->Clear();
+		ActivePattern = nullptr;
 
 		// Create initial floor tiles
 		CreateInitialFloorTiles();
@@ -474,6 +938,10 @@ void ACPP_EndlessRunnerGameModeBase::RemoveTile(AFloorTile* Tile)
 	// QUEUE OPERATION: Remove specific tile
 	UE_LOG(LogTemp, Warning, TEXT("Removing tile from queue: %s"), *Tile->GetName());
 
+	// SORTED INDEX: Everything behind this tile's end is gone for good
+	LaneOccupancy->RetireBefore(GetTrackDistance(Tile->GetAttachTransform().GetLocation()));
+	CoinOccupancy->RetireBefore(GetTrackDistance(Tile->GetAttachTransform().GetLocation()));
+
 	TArray<AFloorTile*> AllTiles = FloorTileQueue->ToArray();
 	FloorTileQueue->Clear();
 
@@ -494,13 +962,24 @@ void ACPP_EndlessRunnerGameModeBase::GameOver()
 {
 	UE_LOG(LogTemp, Warning, TEXT("=== GAME OVER ==="));
 
-	// Display top scores using BST
-	TArray<FScoreNode*> TopScores = ScoreBST->GetTopScores(10);
+	// One leaderboard entry per run
+	RecordRunSample();
+	const int64 FinishTime = FDateTime::UtcNow().ToUnixTimestamp();
+	ScoreBST->Insert(TotalCoins, LocalPlayerNameId);
+	ScoreWindows->Insert(TotalCoins, LocalPlayerNameId, FinishTime);
+	UE_LOG(LogTemp, Warning, TEXT("Today: #%d of %d, this week: #%d of %d"),
+		ScoreWindows->GetRank(ELeaderboardWindow::Daily, TotalCoins), ScoreWindows->Num(ELeaderboardWindow::Daily),
+		ScoreWindows->GetRank(ELeaderboardWindow::Weekly, TotalCoins), ScoreWindows->Num(ELeaderboardWindow::Weekly));
+	UE_LOG(LogTemp, Warning, TEXT("Run recorded: %d samples in %d bytes, %.0f distance"),
+		RunSeries->Num(), static_cast<int32>(RunSeries->GetAllocatedSize()), GetRunDistance());
+
+	// Display top scores using BST (cached reverse in-order, O(K))
+	TArrayView<FScoreNode* const> TopScores = ScoreBST->GetTopScoresCached(10);
 
 	UE_LOG(LogTemp, Warning, TEXT("=== TOP 10 SCORES ==="));
 	for (int32 i = 0; i < TopScores.Num(); i++)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("%d. %s: %d"), i + 1, *TopScores[i]->PlayerName, TopScores[i]->Score);
+		UE_LOG(LogTemp, Warning, TEXT("%d. %s: %d"), i + 1, *ScoreBST->GetPlayerName(TopScores[i]), TopScores[i]->Score);
 	}
 
 	if (IsValid(GameOverWidgetClass))
@@ -510,76 +989,223 @@ void ACPP_EndlessRunnerGameModeBase::GameOver()
 			Widget->AddToViewport();
 		}
 	}
+
+	// Bot runs stay in this session: nothing is saved or submitted under the player's name
+	if (bBotActive)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Bot run: %d coins not persisted or submitted"), TotalCoins);
+		return;
+	}
+
+	// Persist the finished run, then show where it stands across all sessions
+	SaveScoreWindowsRun(TotalCoins, TEXT("Player"), FinishTime);
+	const TArray<FLeaderboardEntry> PreviousBest = Leaderboard->GetTopScores(1);
+	if (Leaderboard->Append(TotalCoins, TEXT("Player")))
+	{
+		const int32 Rank = Leaderboard->GetRank(TotalCoins);
+		UE_LOG(LogTemp, Warning, TEXT("=== ALL-TIME TOP 10 (this run: #%d of %d) ==="), Rank, Leaderboard->Num());
+		const TArray<FLeaderboardEntry> AllTime = Leaderboard->GetTopScores(10);
+		for (int32 i = 0; i < AllTime.Num(); i++)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%d. %s: %d"), i + 1, *AllTime[i].PlayerName, AllTime[i].Score);
+		}
+
+		// New best (a tie keeps the existing ghost): this run becomes the ghost
+		if (PreviousBest.Num() == 0 || TotalCoins > PreviousBest[0].Score)
+		{
+			TArray<uint8> GhostBytes;
+			RunSeries->Serialize(GhostBytes);
+			FFileHelper::SaveArrayToFile(GhostBytes, *GetGhostFilePath());
+		}
+	}
+
+	// Percentile from the sketch: no per-run storage, same answer at any population size
+	ScoreSketch->Add(TotalCoins);
+	UE_LOG(LogTemp, Warning, TEXT("You beat %.1f%% of %lld runs"), GetScorePercentile(TotalCoins), ScoreSketch->Num());
+
+	TArray<uint8> SketchBytes;
+	ScoreSketch->Serialize(SketchBytes);
+	FFileHelper::SaveArrayToFile(SketchBytes, *GetScoreSketchFilePath());
+
+	// Queued to disk here, sent in the background
+	if (ScoreSubmitter.IsValid())
+	{
+		FScoreSubmission Submission;
+		Submission.PlayerName = TEXT("Player");
+		Submission.Score = TotalCoins;
+		Submission.Distance = GetRunDistance();
+		Submission.Duration = GetWorld()->GetTimeSeconds() - RunStartTime;
+		ScoreSubmitter->Submit(MoveTemp(Submission));
+	}
+}
+
+// ALGORITHM: Radix sort for sorting scores
+// Replaces a recursive quicksort that went quadratic (and O(n) deep) on
+// already-sorted or duplicate-heavy input, which is what scores usually are
+void ACPP_EndlessRunnerGameModeBase::SortScores(TArray<int32>& Scores, bool bDescending)
+{
+	FRadixSort::Sort(Scores, bDescending ? ERadixSortFlags::Descending : ERadixSortFlags::None);
 }
 
-// ALGORITHM: QuickSort for sorting scores
 void ACPP_EndlessRunnerGameModeBase::QuickSortScores(TArray<int32>& Scores, int32 Low, int32 High)
 {
+	Low = FMath::Max(Low, 0);
+	High = FMath::Min(High, Scores.Num() - 1);
 	if (Low < High)
 	{
-		int32 PivotIndex = Partition(Scores, Low, High);
-		QuickSortScores(Scores, Low, PivotIndex - 1);
-		QuickSortScores(Scores, PivotIndex + 1, High);
+		FRadixSort::Sort(TArrayView<int32>(Scores).Slice(Low, High - Low + 1));
 	}
 }
 
-int32 ACPP_EndlessRunnerGameModeBase::Partition(TArray<int32>& Scores, int32 Low, int32 High)
+// ALGORITHM: Binary Search for finding score threshold
+int32 ACPP_EndlessRunnerGameModeBase::BinarySearchScore(const TArray<int32>& SortedScores, int32 Target)
+{
+	const int32 Index = FSortedSearch::LowerBound(SortedScores, Target);
+	return (Index < SortedScores.Num() && SortedScores[Index] == Target) ? Index : -1;
+}
+
+int32 ACPP_EndlessRunnerGameModeBase::LowerBoundScore(const TArray<int32>& SortedScores, int32 Score) const
 {
-	int32 Pivot = Scores[High];
-	int32 i = Low - 1;
+	return FSortedSearch::LowerBound(SortedScores, Score);
+}
+
+int32 ACPP_EndlessRunnerGameModeBase::UpperBoundScore(const TArray<int32>& SortedScores, int32 Score) const
+{
+	return FSortedSearch::UpperBound(SortedScores, Score);
+}
+
+// GRAPH ALGORITHM: Find optimal lane using the cached route table
+int32 ACPP_EndlessRunnerGameModeBase::FindOptimalLane(int32 CurrentLane, int32 TargetLane)
+{
+	// O(1) lookup - the table is kept in sync by SetLaneBlocked/AddEdge/RemoveEdge
+	// Returns CurrentLane when already there or when no route exists
+	return LaneGraph->GetNextHop(CurrentLane, TargetLane);
+}
 
-	for (int32 j = Low; j < High; j++)
+// Mark lane as blocked (for AI obstacle avoidance)
+void ACPP_EndlessRunnerGameModeBase::SetLaneBlocked(int32 LaneID, bool bBlocked)
+{
+	LaneGraph->SetLaneBlocked(LaneID, bBlocked);
+	UE_LOG(LogTemp, Warning, TEXT("Lane %d blocked: %s"), LaneID, bBlocked ? TEXT("true") : TEXT("false"));
+}
+
+float ACPP_EndlessRunnerGameModeBase::GetTrackDistance(const FVector& Location) const
+{
+	return FVector::DotProduct(Location - TrackOrigin, TrackForward);
+}
+
+// Drive LaneGraph blocking from the occupancy index - O(lanes * log n), no actor scans
+void ACPP_EndlessRunnerGameModeBase::UpdateLaneBlocking(const FVector& RunnerLocation)
+{
+	const float RunnerDistance = GetTrackDistance(RunnerLocation);
+	LastRunnerDistance = FMath::Max(RunnerDistance, 0.0f);
+
+	for (int32 LaneIdx = 0; LaneIdx < LaneOccupancy->GetNumLanes(); LaneIdx++)
 	{
-		if (Scores[j] <= Pivot)
-		{
-			i++;
-			Swap(Scores[i], Scores[j]);
-		}
+		// FLaneGraph ignores no-op updates, so the route table only changes on transitions
+		LaneGraph->SetLaneBlocked(LaneIdx, LaneOccupancy->IsLaneBlockedWithin(LaneIdx, RunnerDistance, LaneBlockLookahead));
 	}
-	Swap(Scores[i + 1], Scores[High]);
-	return i + 1;
 }
 
-// ALGORITHM: Binary Search for finding score threshold
-int32 ACPP_EndlessRunnerGameModeBase::BinarySearchScore(const TArray<int32>& SortedScores, int32 Target)
+bool ACPP_EndlessRunnerGameModeBase::IsLaneBlockedAhead(int32 LaneID, const FVector& FromLocation, float Range) const
 {
-	int32 Left = 0;
-	int32 Right = SortedScores.Num() - 1;
+	return LaneOccupancy->IsLaneBlockedWithin(LaneID, GetTrackDistance(FromLocation), Range);
+}
 
-	while (Left <= Right)
-	{
-		int32 Mid = Left + (Right - Left) / 2;
+float ACPP_EndlessRunnerGameModeBase::GetObstacleDistanceAhead(int32 LaneID, const FVector& FromLocation) const
+{
+	const float From = GetTrackDistance(FromLocation);
+	const float Next = LaneOccupancy->GetNextObstacleDistance(LaneID, From);
+	return Next >= 0.0f ? Next - From : -1.0f;
+}
 
-		if (SortedScores[Mid] == Target)
-			return Mid;
+float ACPP_EndlessRunnerGameModeBase::GetCoinDistanceAhead(int32 LaneID, const FVector& FromLocation) const
+{
+	const float From = GetTrackDistance(FromLocation);
+	const float Next = CoinOccupancy->GetNextObstacleDistance(LaneID, From);
+	return Next >= 0.0f ? Next - From : -1.0f;
+}
 
-		if (SortedScores[Mid] < Target)
-			Left = Mid + 1;
-		else
-			Right = Mid - 1;
-	}
+void ACPP_EndlessRunnerGameModeBase::RecordRunSample()
+{
+	RunSeries->AddSample(GetWorld()->GetTimeSeconds() - RunStartTime, GetRunDistance(), TotalCoins);
+}
 
-	return -1; // Not found
+FString ACPP_EndlessRunnerGameModeBase::GetGhostFilePath() const
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), LeaderboardDirectory, TEXT("BestRun.series"));
 }
 
-// GRAPH ALGORITHM: Find optimal lane using BFS
-int32 ACPP_EndlessRunnerGameModeBase::FindOptimalLane(int32 CurrentLane, int32 TargetLane)
+FString ACPP_EndlessRunnerGameModeBase::GetScoreWindowsFilePath() const
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), LeaderboardDirectory, TEXT("Week.csv"));
+}
+
+void ACPP_EndlessRunnerGameModeBase::LoadScoreWindows()
 {
-	// Use BFS to find shortest path between lanes
-	TArray<int32> Path = LaneGraph->BFS_FindPath(CurrentLane, TargetLane);
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *GetScoreWindowsFilePath()))
+		return;
 
-	if (Path.Num() > 1)
+	// Runs from before this UTC week (Monday 00:00) can't reach the daily or weekly board
+	const FDateTime Today = FDateTime::UtcNow().GetDate();
+	const int64 WeekStart = (Today - FTimespan::FromDays(static_cast<int32>(Today.GetDayOfWeek()))).ToUnixTimestamp();
+
+	TArray<FString> Kept;
+	for (const FString& Line : Lines)
 	{
-		// Return next lane in path
-		return Path[1];
+		// The name goes last, so it may contain commas; a torn last line fails to parse and is dropped
+		FString Time, Rest, Score, Name;
+		if (!Line.Split(TEXT(","), &Time, &Rest) || !Rest.Split(TEXT(","), &Score, &Name)
+			|| !Time.IsNumeric() || !Score.IsNumeric() || Name.IsEmpty())
+			continue;
+
+		const int64 UnixTime = FCString::Atoi64(*Time);
+		if (UnixTime < WeekStart)
+			continue;
+
+		ScoreWindows->Insert(FCString::Atoi(*Score), ScoreWindows->GetNameTable().Intern(Name), UnixTime);
+		Kept.Add(Line);
 	}
+	ScoreWindows->Advance(FDateTime::UtcNow().ToUnixTimestamp());
 
-	return CurrentLane; // Stay in current lane
+	// Only this week's lines are kept, so the file never outgrows a week of runs
+	if (Kept.Num() < Lines.Num())
+	{
+		FFileHelper::SaveStringArrayToFile(Kept, *GetScoreWindowsFilePath(), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("Score windows: %d runs this week, %d today"),
+		ScoreWindows->Num(ELeaderboardWindow::Weekly), ScoreWindows->Num(ELeaderboardWindow::Daily));
 }
 
-// Mark lane as blocked (for AI obstacle avoidance)
-void ACPP_EndlessRunnerGameModeBase::SetLaneBlocked(int32 LaneID, bool bBlocked)
+void ACPP_EndlessRunnerGameModeBase::SaveScoreWindowsRun(int32 Score, const FString& PlayerName, int64 UnixTime) const
 {
-	LaneGraph->SetLaneBlocked(LaneID, bBlocked);
-	UE_LOG(LogTemp, Warning, TEXT("Lane %d blocked: %s"), LaneID, bBlocked ? TEXT("true") : TEXT("false"));
-}
\ No newline at end of file
+	// One appended line per run, no rewrite
+	const FString Line = FString::Printf(TEXT("%lld,%d,%s\n"), UnixTime, Score, *PlayerName);
+	FFileHelper::SaveStringToFile(Line, *GetScoreWindowsFilePath(), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM,
+		&IFileManager::Get(), FILEWRITE_Append);
+}
+
+int32 ACPP_EndlessRunnerGameModeBase::GetGhostCoins() const
+{
+	if (!GhostSeries || GhostSeries->IsEmpty())
+		return -1;
+
+	return GhostSeries->GetCoinsAtDistance(GetRunDistance());
+}
+
+float ACPP_EndlessRunnerGameModeBase::GetScorePercentile(int32 Score) const
+{
+	return ScoreSketch ? ScoreSketch->GetPercentile(Score) : 0.0f;
+}
+
+TSharedRef<const FScoreSnapshot, ESPMode::ThreadSafe> ACPP_EndlessRunnerGameModeBase::GetScoreSnapshot() const
+{
+	return ScoreBST ? ScoreBST->GetSnapshot() : MakeShared<const FScoreSnapshot, ESPMode::ThreadSafe>();
+}
+
+FString ACPP_EndlessRunnerGameModeBase::GetScoreSketchFilePath() const
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), LeaderboardDirectory, TEXT("Scores.sketch"));
+}
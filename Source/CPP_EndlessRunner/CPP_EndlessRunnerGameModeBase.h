@@ -3,6 +3,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/GameModeBase.h"
+#include "SpawnTables.h"
 #include "CPP_EndlessRunnerGameModeBase.generated.h"
 
 // Forward declarations
@@ -14,23 +15,95 @@ class UArrowComponent;
 
 // Data Structure Forward Declarations
 class FFloorTileQueue;
+class FDeferredSpawnQueue;
 template<typename T> class FObjectPool;
 class FLaneGraph;
+class FLaneOccupancyIndex;
 class FScoreBST;
+class FScoreSnapshot;
+class FTimeWindowedLeaderboard;
+class FTrackPatternLibrary;
+class FDifficultyTables;
+class FLeaderboardStore;
+class FRunTimeSeries;
+class FScoreSubmitter;
+class FQuantileSketch;
+struct FTrackPatternRecord;
 
 // Delegates - MUST be declared BEFORE the class
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnCoinsCountChanged, int32, CoinsCount);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnLivesCountChanged, int32, LivesCount);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnLevelReset);
 
+/**
+ * Deferred spawn queue counters, refreshed every frame the queue is drained
+ * Also visible in-game with "stat Runner"
+ */
+USTRUCT(BlueprintType)
+struct FSpawnQueueStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Spawn")
+	int32 QueueDepth = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Spawn")
+	int32 PeakQueueDepth = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Spawn")
+	int32 LastFrameRequests = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Spawn")
+	int32 TotalRequests = 0;
+
+	// Frames where draining took longer than SpawnBudgetMs
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Spawn")
+	int32 BudgetOverruns = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Spawn")
+	float LastFrameMs = 0.0f;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Spawn")
+	float MaxFrameMs = 0.0f;
+};
+
+/**
+ * Fixed-step simulation progress, summed over every level load in the process
+ * Also visible in-game with "stat Runner"
+ */
+USTRUCT(BlueprintType)
+struct FSimulationStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Simulation")
+	int32 Steps = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Simulation")
+	double SimSeconds = 0.0;
+
+	// Wall-clock time spent ticking the level (loads excluded)
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Simulation")
+	double WallSeconds = 0.0;
+
+	// Over the last report interval
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Simulation")
+	float SimSecondsPerWallSecond = 0.0f;
+};
+
 /**
  * Game Mode using Data Structures and Algorithms
  */
-UCLASS()
+UCLASS(Config = Game)
 class CPP_ENDLESSRUNNER_API ACPP_EndlessRunnerGameModeBase : public AGameModeBase
 {
 	GENERATED_BODY()
 
+public:
+	ACPP_EndlessRunnerGameModeBase();
+
+	virtual void Tick(float DeltaSeconds) override;
+
 protected:
 	virtual void BeginPlay() override;
 
@@ -39,6 +112,9 @@ protected:
 	// 1. QUEUE: Floor Tile Management (FIFO)
 	TSharedPtr<FFloorTileQueue> FloorTileQueue;
 
+	// 1b. PRIORITY QUEUE: Deferred tile/item spawns, nearest first
+	TSharedPtr<FDeferredSpawnQueue> SpawnQueue;
+
 	// 2. HASH MAP OBJECT POOLS: Efficient object reuse
 	TSharedPtr<FObjectPool<ACoin>> CoinPool;
 	TSharedPtr<FObjectPool<AObstacle>> ObstaclePool;
@@ -49,6 +125,73 @@ protected:
 	// 4. BINARY SEARCH TREE: Score management
 	TSharedPtr<FScoreBST> ScoreBST;
 
+	// Interned once; finished runs are inserted without hashing the name
+	uint32 LocalPlayerNameId = 0;
+
+	// 4a. DAY BUCKETS: Today / this week / all-time views of the same runs (shares the BST's names)
+	TSharedPtr<FTimeWindowedLeaderboard> ScoreWindows;
+
+	// This week's finished runs with their times, one "UnixTime,Score,Name" line each,
+	// so today's and this week's ranks count earlier sessions too
+	FString GetScoreWindowsFilePath() const;
+	void LoadScoreWindows();
+	void SaveScoreWindowsRun(int32 Score, const FString& PlayerName, int64 UnixTime) const;
+
+	// 4b. DELTA-ENCODED TIME SERIES: (time, distance, coins) of the current run
+	TSharedPtr<FRunTimeSeries> RunSeries;
+
+	// Best stored run, replayed as a ghost (empty until one has been saved)
+	TSharedPtr<FRunTimeSeries> GhostSeries;
+
+	// Run distance keeps growing across lives, although the track restarts each life
+	float RunStartTime = 0.0f;
+	float RunDistanceOffset = 0.0f;
+	float LastRunnerDistance = 0.0f;
+
+	void RecordRunSample();
+	FString GetGhostFilePath() const;
+
+	// 5. SORTED LANE INDEX: Obstacle occupancy along the upcoming track
+	TSharedPtr<FLaneOccupancyIndex> LaneOccupancy;
+
+	// Same index over coins, so a bot can read what is ahead without touching actors
+	TSharedPtr<FLaneOccupancyIndex> CoinOccupancy;
+
+	// Track frame used to turn world locations into track distances
+	// (tiles are chained along the first tile's forward axis)
+	FVector TrackOrigin = FVector::ZeroVector;
+	FVector TrackForward = FVector::ForwardVector;
+
+	float GetTrackDistance(const FVector& Location) const;
+
+	// 6. MEMORY-MAPPED PATTERN LIBRARY: Hand-authored multi-tile sequences
+	TSharedPtr<FTrackPatternLibrary> PatternLibrary;
+
+	// Pattern currently being stamped onto new tiles (points into the mapped file)
+	const FTrackPatternRecord* ActivePattern = nullptr;
+	int32 ActivePatternTile = 0;
+
+	const uint8* NextPatternRow(int32 Difficulty, int32 NumLanes);
+
+	// 7. LOOKUP TABLES: Difficulty curves baked per distance step
+	TSharedPtr<FDifficultyTables> DifficultyTables;
+
+	FDateTime DifficultyConfigTimestamp;
+	FTimerHandle DifficultyReloadHandle;
+
+	void CheckDifficultyConfigChanged();
+
+	// 8. PERSISTENT LEADERBOARD: Mapped snapshot + append-only log of finished runs
+	TSharedPtr<FLeaderboardStore> Leaderboard;
+
+	// 9. SCORE SUBMISSION: Disk outbox drained to the score service in batches
+	TSharedPtr<FScoreSubmitter> ScoreSubmitter;
+
+	// 10. QUANTILE SKETCH: Distribution of every finished run's score in a few KB
+	TSharedPtr<FQuantileSketch> ScoreSketch;
+
+	FString GetScoreSketchFilePath() const;
+
 	// ===== POOL ID TRACKING =====
 	// Track pool IDs for objects (since ObjectPool can't set them directly)
 	TMap<AActor*, int32> CoinPoolIDs;
@@ -59,10 +202,45 @@ protected:
 	void InitializeDataStructures();
 	void CreateInitialFloorTiles();
 
+	AFloorTile* SpawnFloorTile(const FTransform& SpawnTransform, const bool bSpawnItems);
+	void ProcessSpawnQueue();
+
 	// Object Pool Spawning
 	void SpawnItemsUsingPool(AFloorTile* Tile);
 	void ReturnPooledObjects(AFloorTile* Tile);
 
+	AObstacle* SpawnObstacleInLane(AFloorTile* Tile, TSubclassOf<AObstacle> ObstacleClass, const FTransform& SpawnLocation, int32 LaneIdx);
+	ACoin* SpawnCoinInLane(AFloorTile* Tile, const FTransform& SpawnLocation, int32 LaneIdx);
+
+	// Every spawn decision draws from this, so a fixed seed replays the same track
+	FRandomStream SpawnRandom;
+
+	bool bFixedStepSim = false;
+
+	// Set when the autopilot plays: its runs never reach the leaderboard, ghost, sketch or score service
+	bool bBotActive = false;
+
+	UPROPERTY(VisibleInstanceOnly, Category = "Simulation")
+	FSimulationStats SimulationStats;
+
+	double SimLastWallTime = 0.0;
+	double SimReportWallTime = 0.0;
+	double SimReportSimSeconds = 0.0;
+
+	void StartFixedStepSim();
+	void TickFixedStepSim(float DeltaSeconds);
+
+	// Alias tables compiled from SpawnBands (ascending MinDistance)
+	TArray<FCompiledSpawnBand> CompiledSpawnBands;
+	bool bSpawnTablesDirty = true;
+
+	void RebuildSpawnTables();
+	int32 FindSpawnBandIndex(float Distance) const;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 	// Helper to get next pool ID
 	int32 GetNextPoolID();
 
@@ -78,9 +256,24 @@ public:
 	UPROPERTY(VisibleInstanceOnly, Category = "Runtime")
 	FTransform NextSpawnPoint;
 
+	// Spawns immediately - use QueueFloorTile from gameplay callbacks
 	UFUNCTION()
 	const AFloorTile* AddFloorTile(const bool bSpawnItems);
 
+	// Defers the spawn to the next ProcessSpawnQueue (runs under SpawnBudgetMs)
+	UFUNCTION()
+	void QueueFloorTile(const bool bSpawnItems);
+
+	// Time allowed per frame for draining deferred spawns
+	UPROPERTY(EditAnywhere, Category = "Config", meta = (ClampMin = "0.0"))
+	float SpawnBudgetMs = 2.0f;
+
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Runtime")
+	FSpawnQueueStats SpawnQueueStats;
+
+	UFUNCTION(BlueprintCallable, Category = "Runtime")
+	FSpawnQueueStats GetSpawnQueueStats() const { return SpawnQueueStats; }
+
 	UFUNCTION()
 	void RemoveTile(AFloorTile* Tile);
 
@@ -95,6 +288,95 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = "Config")
 	TSubclassOf<AObstacle> BigObstacleClass;
 
+	// ===== SPAWN TABLES =====
+
+	// Weighted outcomes per lane, switched by distance along the track
+	// Leave empty to use FloorTileClass's SpawnPercent1..3 thresholds
+	UPROPERTY(EditAnywhere, Category = "Spawn")
+	TArray<FSpawnBand> SpawnBands;
+
+	// Extra big obstacles on a tile are downgraded to small ones
+	UPROPERTY(EditAnywhere, Category = "Spawn")
+	int32 MaxBigObstaclesPerTile = 1;
+
+	UFUNCTION(BlueprintCallable, Category = "Spawn")
+	void SetSpawnBands(const TArray<FSpawnBand>& NewBands);
+
+	// Cooked pattern library, relative to the Content directory (see CookTrackPatterns commandlet)
+	UPROPERTY(EditDefaultsOnly, Category = "Spawn")
+	FString PatternLibraryFile = TEXT("Patterns/TrackPatterns.bin");
+
+	// Chance that a tile without an active pattern starts a new one
+	UPROPERTY(EditAnywhere, Category = "Spawn", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float PatternChance = 0.15f;
+
+	// Fixed seed for spawning (0 picks one at random); also ?Seed= on the level URL or -RunnerSeed= on the command line.
+	// Each level load in the same process uses the next seed, so restarted soak runs differ but stay reproducible
+	UPROPERTY(EditAnywhere, Category = "Spawn")
+	int32 RandomSeed = 0;
+
+	UFUNCTION(BlueprintCallable, Category = "Spawn")
+	int32 GetSpawnSeed() const { return SpawnRandom.GetInitialSeed(); }
+
+	// ===== DIFFICULTY =====
+
+	// Preset name in the difficulty config (Easy / Medium / Hard), or ?Difficulty= on the level URL
+	UPROPERTY(EditAnywhere, Category = "Difficulty")
+	FString DifficultyPreset = TEXT("Medium");
+
+	// Curves file, relative to the Content directory
+	UPROPERTY(EditDefaultsOnly, Category = "Difficulty")
+	FString DifficultyConfigFile = TEXT("Tuning/Difficulty.json");
+
+	// Seconds between checks for an edited config file (0 disables hot reload; never in Shipping)
+	UPROPERTY(EditDefaultsOnly, Category = "Difficulty", meta = (ClampMin = "0.0"))
+	float DifficultyReloadInterval = 1.0f;
+
+	UFUNCTION(BlueprintCallable, Category = "Difficulty")
+	bool ReloadDifficultyConfig();
+
+	// Runner speed from the baked curve (0 when no curves are loaded)
+	UFUNCTION(BlueprintCallable, Category = "Difficulty")
+	float GetRunSpeedAt(const FVector& Location) const;
+
+	// ===== LEADERBOARD =====
+
+	// Snapshot + log location, relative to the Saved directory
+	UPROPERTY(EditDefaultsOnly, Category = "Leaderboard")
+	FString LeaderboardDirectory = TEXT("Leaderboard");
+
+	// Runs kept in the log before they are folded into the snapshot
+	UPROPERTY(EditDefaultsOnly, Category = "Leaderboard", meta = (ClampMin = "1"))
+	int32 LeaderboardCompactThreshold = 4096;
+
+	// Score service finished runs are submitted to (empty disables submission)
+	// Set per deployment in DefaultGame.ini, e.g.
+	// [/Script/CPP_EndlessRunner.CPP_EndlessRunnerGameModeBase] ScoreServiceUrl=http://127.0.0.1:8085/scores
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Leaderboard")
+	FString ScoreServiceUrl;
+
+	// ===== FIXED-STEP SIMULATION =====
+
+	// With -RunnerSim every frame advances the game by exactly 1 / SimStepHz and the
+	// engine no longer waits for wall-clock time, so a -nullrhi or server process runs
+	// as fast as the CPU allows. -RunnerSimHz= and -RunnerSimSeconds= override these
+	UPROPERTY(EditDefaultsOnly, Category = "Simulation", meta = (ClampMin = "1.0"))
+	float SimStepHz = 60.0f;
+
+	// Simulated seconds before the process exits, over all level loads (0 runs until stopped)
+	UPROPERTY(EditDefaultsOnly, Category = "Simulation", meta = (ClampMin = "0.0"))
+	float SimDurationSeconds = 0.0f;
+
+	// Wall-clock seconds between speed reports in the log
+	UPROPERTY(EditDefaultsOnly, Category = "Simulation", meta = (ClampMin = "0.1"))
+	float SimReportInterval = 5.0f;
+
+	UFUNCTION(BlueprintCallable, Category = "Simulation")
+	bool IsFixedStepSim() const { return bFixedStepSim; }
+
+	UFUNCTION(BlueprintCallable, Category = "Simulation")
+	FSimulationStats GetSimulationStats() const { return SimulationStats; }
+
 	// ===== LANE MANAGEMENT =====
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Runtime")
@@ -107,6 +389,28 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Lane System")
 	void SetLaneBlocked(int32 LaneID, bool bBlocked);
 
+	// How far ahead of the runner an obstacle marks its lane as blocked
+	UPROPERTY(EditDefaultsOnly, Category = "Lane System")
+	float LaneBlockLookahead = 1000.0f;
+
+	// Sync the lane graph's blocked state with obstacles ahead of the runner
+	// (the runner's own lane included: FindOptimalLane still routes out of it)
+	UFUNCTION(BlueprintCallable, Category = "Lane System")
+	void UpdateLaneBlocking(const FVector& RunnerLocation);
+
+	UFUNCTION(BlueprintCallable, Category = "Lane System")
+	bool IsLaneBlockedAhead(int32 LaneID, const FVector& FromLocation, float Range) const;
+
+	// Distance from FromLocation to the next obstacle / coin in a lane (-1 if none on the spawned track)
+	UFUNCTION(BlueprintCallable, Category = "Lane System")
+	float GetObstacleDistanceAhead(int32 LaneID, const FVector& FromLocation) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Lane System")
+	float GetCoinDistanceAhead(int32 LaneID, const FVector& FromLocation) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Lane System")
+	int32 GetNumLanes() const { return LaneSwitchValues.Num(); }
+
 	// ===== SCORE MANAGEMENT =====
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Score")
@@ -115,14 +419,40 @@ public:
 	UFUNCTION()
 	void AddCoin();
 
-	// Sorting Algorithm: QuickSort
+	// Distance covered this run, summed over lives
+	UFUNCTION(BlueprintCallable, Category = "Score")
+	float GetRunDistance() const { return RunDistanceOffset + LastRunnerDistance; }
+
+	// Coins the best stored run had at this run's current distance (-1 without a ghost)
+	UFUNCTION(BlueprintCallable, Category = "Score")
+	int32 GetGhostCoins() const;
+
+	// Share of all recorded runs (0-100) that scored below Score
+	UFUNCTION(BlueprintCallable, Category = "Score")
+	float GetScorePercentile(int32 Score) const;
+
+	// Latest published session leaderboard; safe to take and query on any thread
+	TSharedRef<const FScoreSnapshot, ESPMode::ThreadSafe> GetScoreSnapshot() const;
+
+	// Sorting Algorithm: LSD radix sort (stable, O(n), parallel for large arrays)
 	UFUNCTION(BlueprintCallable, Category = "Algorithms")
+	void SortScores(UPARAM(ref) TArray<int32>& Scores, bool bDescending = false);
+
+	UFUNCTION(BlueprintCallable, Category = "Algorithms", meta = (DeprecatedFunction, DeprecationMessage = "Use SortScores"))
 	void QuickSortScores(TArray<int32>& Scores, int32 Low, int32 High);
 
-	// Searching Algorithm: Binary Search
+	// Searching Algorithm: Binary Search (index of the first Target, or -1)
 	UFUNCTION(BlueprintCallable, Category = "Algorithms")
 	int32 BinarySearchScore(const TArray<int32>& SortedScores, int32 Target);
 
+	// First index with a score >= Score in an ascending array (Num if none)
+	UFUNCTION(BlueprintCallable, Category = "Algorithms")
+	int32 LowerBoundScore(const TArray<int32>& SortedScores, int32 Score) const;
+
+	// First index with a score > Score; Num - UpperBound is how many scored higher
+	UFUNCTION(BlueprintCallable, Category = "Algorithms")
+	int32 UpperBoundScore(const TArray<int32>& SortedScores, int32 Score) const;
+
 	// ===== LIVES SYSTEM =====
 
 	UPROPERTY(EditDefaultsOnly, Category = "Config")
@@ -158,8 +488,4 @@ public:
 
 	UPROPERTY(BlueprintAssignable, Category = "Delegates")
 	FOnLevelReset OnLevelReset;
-
-private:
-	// Helper for QuickSort
-	int32 Partition(TArray<int32>& Scores, int32 Low, int32 High);
 };
\ No newline at end of file
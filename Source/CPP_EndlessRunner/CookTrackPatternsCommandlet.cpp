@@ -0,0 +1,60 @@
+// CookTrackPatternsCommandlet.cpp - Cooks authored pattern data tables into the binary library
+
+#include "CookTrackPatternsCommandlet.h"
+#include "TrackPatternLibrary.h"
+#include "Engine/DataTable.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+UCookTrackPatternsCommandlet::UCookTrackPatternsCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UCookTrackPatternsCommandlet::Main(const FString& Params)
+{
+	FString TablePath;
+	FString OutPath = TEXT("Patterns/TrackPatterns.bin");
+
+	if (!FParse::Value(*Params, TEXT("Table="), TablePath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("CookTrackPatterns: missing -Table=/Game/Path/To/DataTable"));
+		return 1;
+	}
+	FParse::Value(*Params, TEXT("Out="), OutPath);
+
+	const UDataTable* Table = LoadObject<UDataTable>(nullptr, *TablePath);
+	if (!Table || Table->GetRowStruct() != FTrackPatternRow::StaticStruct())
+	{
+		UE_LOG(LogTemp, Error, TEXT("CookTrackPatterns: %s is not a FTrackPatternRow data table"), *TablePath);
+		return 1;
+	}
+
+	// Row order is irrelevant, the writer groups them by bucket
+	TArray<FTrackPatternRow> Rows;
+	Table->ForeachRow<FTrackPatternRow>(TEXT("CookTrackPatterns"), [&Rows](const FName& Key, const FTrackPatternRow& Row)
+	{
+		Rows.Add(Row);
+	});
+
+	TArray<uint8> Bytes;
+	FString Error;
+	if (!FTrackPatternLibrary::Serialize(Rows, Bytes, Error))
+	{
+		UE_LOG(LogTemp, Error, TEXT("CookTrackPatterns: %s"), *Error);
+		return 1;
+	}
+
+	const FString Filename = FPaths::Combine(FPaths::ProjectContentDir(), OutPath);
+	if (!FFileHelper::SaveArrayToFile(Bytes, *Filename))
+	{
+		UE_LOG(LogTemp, Error, TEXT("CookTrackPatterns: could not write %s"), *Filename);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("CookTrackPatterns: wrote %d patterns (%d bytes) to %s"), Rows.Num(), Bytes.Num(), *Filename);
+	return 0;
+}
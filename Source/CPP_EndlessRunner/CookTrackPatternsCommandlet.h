@@ -0,0 +1,27 @@
+// CookTrackPatternsCommandlet.h - Cooks authored pattern data tables into the binary library
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "CookTrackPatternsCommandlet.generated.h"
+
+/**
+ * Converts a DataTable of FTrackPatternRow into the memory-mappable pattern library
+ *
+ * Usage:
+ *   UnrealEditor-Cmd CPP_EndlessRunner.uproject -run=CookTrackPatterns
+ *       -Table=/Game/_Game/Data/DT_TrackPatterns -Out=Patterns/TrackPatterns.bin
+ *
+ * -Out is relative to the project Content directory
+ */
+UCLASS()
+class CPP_ENDLESSRUNNER_API UCookTrackPatternsCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UCookTrackPatternsCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
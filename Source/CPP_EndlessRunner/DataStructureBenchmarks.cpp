@@ -0,0 +1,1362 @@
+// DataStructureBenchmarks.cpp - Console benchmarks for the custom data structures
+// Run from the in-game console (~), e.g. "Runner.Bench.AliasTable"
+// Compiled out of Shipping builds
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "AliasTable.h"
+#include "LaneGraph.h"
+#include "SpawnTables.h"
+#include "ScoreBST.h"
+#include "ScoreSnapshot.h"
+#include "LeaderboardStore.h"
+#include "LeaderboardMerge.h"
+#include "RunTimeSeries.h"
+#include "QuantileSketch.h"
+#include "RadixSort.h"
+#include "SortedSearch.h"
+#include "TimeWindowedLeaderboard.h"
+#include "Algo/Sort.h"
+#include "Algo/BinarySearch.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include <atomic>
+
+#if !UE_BUILD_SHIPPING
+
+namespace RunnerBenchmarks
+{
+	// Keeps the optimizer from throwing away benchmark loops
+	static volatile int64 Sink = 0;
+
+	static int32 ParseIntArg(const TArray<FString>& Args, int32 Index, int32 Default)
+	{
+		return Args.IsValidIndex(Index) ? FCString::Atoi(*Args[Index]) : Default;
+	}
+
+	// ===== ALIAS TABLE vs CHAINED THRESHOLDS =====
+	// Sampling cost should stay flat as the number of outcomes grows,
+	// while a cumulative threshold scan (the old if-chain) grows linearly
+	static void AliasTable(const TArray<FString>& Args)
+	{
+		const int32 NumSamples = ParseIntArg(Args, 0, 10000000);
+		const int32 OutcomeCounts[] = { 2, 4, 8, 32, 128, 1024, 8192 };
+
+		FRandomStream Random(1234);
+
+		// Uniform values are pre-generated so only the lookup is timed
+		TArray<float> Uniforms;
+		Uniforms.SetNumUninitialized(NumSamples);
+		for (float& U : Uniforms)
+		{
+			U = Random.FRand();
+		}
+
+		UE_LOG(LogTemp, Warning, TEXT("=== Alias Table Benchmark (%d samples) ==="), NumSamples);
+		UE_LOG(LogTemp, Warning, TEXT("Outcomes | Build (us) | Alias (ns/sample) | Threshold scan (ns/sample)"));
+
+		for (int32 NumOutcomes : OutcomeCounts)
+		{
+			TArray<float> Weights;
+			Weights.SetNumUninitialized(NumOutcomes);
+			for (float& Weight : Weights)
+			{
+				Weight = Random.FRandRange(0.1f, 10.0f);
+			}
+
+			// Cumulative thresholds, normalized to [0, 1]
+			TArray<float> Thresholds;
+			Thresholds.SetNumUninitialized(NumOutcomes);
+			float Total = 0.0f;
+			for (int32 i = 0; i < NumOutcomes; i++)
+			{
+				Total += Weights[i];
+				Thresholds[i] = Total;
+			}
+			for (float& Threshold : Thresholds)
+			{
+				Threshold /= Total;
+			}
+
+			FAliasTable Table;
+			double Start = FPlatformTime::Seconds();
+			Table.Build(Weights);
+			const double BuildTime = FPlatformTime::Seconds() - Start;
+
+			int64 Checksum = 0;
+			Start = FPlatformTime::Seconds();
+			for (float U : Uniforms)
+			{
+				Checksum += Table.Sample(U);
+			}
+			const double AliasTime = FPlatformTime::Seconds() - Start;
+
+			Start = FPlatformTime::Seconds();
+			for (float U : Uniforms)
+			{
+				int32 Index = 0;
+				while (Index < NumOutcomes - 1 && U >= Thresholds[Index])
+				{
+					Index++;
+				}
+				Checksum += Index;
+			}
+			const double ScanTime = FPlatformTime::Seconds() - Start;
+			Sink += Checksum;
+
+			UE_LOG(LogTemp, Warning, TEXT("%8d | %10.1f | %17.2f | %26.2f"),
+				NumOutcomes,
+				BuildTime * 1e6,
+				AliasTime * 1e9 / NumSamples,
+				ScanTime * 1e9 / NumSamples);
+		}
+	}
+
+	static FAutoConsoleCommand AliasTableCommand(
+		TEXT("Runner.Bench.AliasTable"),
+		TEXT("Alias table vs threshold scan sampling cost. Args: [NumSamples]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&AliasTable));
+
+	// ===== SPAWN TABLE vs ORIGINAL THRESHOLDS =====
+	// The SpawnPercent fallback table must spawn with the same odds as the
+	// if-chain it replaced: per-kind frequencies from the compiled alias table
+	// are compared against the same uniforms run through the old thresholds
+	static void SpawnThresholds(const TArray<FString>& Args)
+	{
+		const int32 NumSamples = ParseIntArg(Args, 0, 4000000);
+		const FVector Percents[] = { FVector(0.1f, 0.3f, 0.5f), FVector(0.0f, 0.5f, 0.5f), FVector(0.2f, 0.2f, 0.9f), FVector(0.25f, 0.5f, 1.0f) };
+		constexpr int32 NumKinds = 4;
+
+		// ~6 sigma of a binomial frequency at p = 0.5
+		const double Tolerance = 3.0 / FMath::Sqrt(static_cast<double>(FMath::Max(NumSamples, 1)));
+
+		FRandomStream Random(1234);
+		int32 Errors = 0;
+
+		for (const FVector& P : Percents)
+		{
+			FCompiledSpawnTable Table;
+			Table.Build(FSpawnLaneTable::FromThresholds(P.X, P.Y, P.Z));
+
+			int64 TableCounts[NumKinds] = {};
+			int64 ChainCounts[NumKinds] = {};
+			for (int32 i = 0; i < NumSamples; i++)
+			{
+				const float U = Random.FRand();
+				TableCounts[static_cast<int32>(Table.Sample(U))]++;
+
+				// The original per-lane if-chain
+				ESpawnItemKind Kind = ESpawnItemKind::None;
+				if (U >= P.X && U < P.Y)
+				{
+					Kind = ESpawnItemKind::SmallObstacle;
+				}
+				else if (U >= P.Z)
+				{
+					Kind = ESpawnItemKind::Coin;
+				}
+				ChainCounts[static_cast<int32>(Kind)]++;
+			}
+
+			for (int32 Kind = 0; Kind < NumKinds; Kind++)
+			{
+				const double TableFreq = static_cast<double>(TableCounts[Kind]) / NumSamples;
+				const double ChainFreq = static_cast<double>(ChainCounts[Kind]) / NumSamples;
+				if (FMath::Abs(TableFreq - ChainFreq) > Tolerance)
+				{
+					UE_LOG(LogTemp, Error, TEXT("SPAWN TABLE MISMATCH: thresholds (%.2f, %.2f, %.2f) %s table %.4f vs if-chain %.4f"),
+						P.X, P.Y, P.Z, *UEnum::GetValueAsString(static_cast<ESpawnItemKind>(Kind)), TableFreq, ChainFreq);
+					Errors++;
+				}
+			}
+		}
+
+		UE_LOG(LogTemp, Warning, TEXT("=== Spawn Thresholds (%d samples per table): %s ==="),
+			NumSamples, Errors == 0 ? TEXT("results OK") : TEXT("MISMATCHES"));
+	}
+
+	static FAutoConsoleCommand SpawnThresholdsCommand(
+		TEXT("Runner.Bench.SpawnThresholds"),
+		TEXT("Checks the SpawnPercent fallback table against the original thresholds. Args: [NumSamples]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&SpawnThresholds));
+
+	// ===== SCORE BST: MONOTONIC INSERTS =====
+	// Scores inserted in ascending order are the worst case for an
+	// unbalanced BST (a linked list). With AVL balancing, per-insert cost
+	// should track log2(n) and the height should stay near 1.44 log2(n)
+	static void ScoreBST(const TArray<FString>& Args)
+	{
+		const int32 NumInserts = ParseIntArg(Args, 0, 1000000);
+		const int32 NumCheckpoints = 10;
+		const int32 CheckpointSize = FMath::Max(NumInserts / NumCheckpoints, 1);
+		const FString PlayerName = TEXT("Player");
+
+		UE_LOG(LogTemp, Warning, TEXT("=== Score BST Benchmark (%d monotonic inserts) ==="), NumInserts);
+		UE_LOG(LogTemp, Warning, TEXT("   Nodes | Height | Insert (ns/op) | Rank (ns/op) | Select (ns/op)"));
+
+		FScoreBST Tree;
+		const double TotalStart = FPlatformTime::Seconds();
+
+		for (int32 Checkpoint = 0; Checkpoint < NumCheckpoints; Checkpoint++)
+		{
+			const int32 First = Checkpoint * CheckpointSize;
+
+			double Start = FPlatformTime::Seconds();
+			for (int32 i = 0; i < CheckpointSize; i++)
+			{
+				Tree.Insert(First + i + 1, PlayerName);
+			}
+			const double InsertTime = FPlatformTime::Seconds() - Start;
+
+			const int32 NumQueries = 100000;
+			int64 Checksum = 0;
+
+			Start = FPlatformTime::Seconds();
+			for (int32 i = 0; i < NumQueries; i++)
+			{
+				Checksum += Tree.GetRank((i * 7919) % Tree.GetNodeCount());
+			}
+			const double RankTime = FPlatformTime::Seconds() - Start;
+
+			Start = FPlatformTime::Seconds();
+			for (int32 i = 0; i < NumQueries; i++)
+			{
+				Checksum += Tree.SelectByRank(1 + (i * 7919) % Tree.GetNodeCount())->Score;
+			}
+			const double SelectTime = FPlatformTime::Seconds() - Start;
+			Sink += Checksum;
+
+			UE_LOG(LogTemp, Warning, TEXT("%8d | %6d | %14.1f | %12.1f | %13.1f"),
+				Tree.GetNodeCount(),
+				Tree.GetHeight(),
+				InsertTime * 1e9 / CheckpointSize,
+				RankTime * 1e9 / NumQueries,
+				SelectTime * 1e9 / NumQueries);
+		}
+
+		UE_LOG(LogTemp, Warning, TEXT("Total: %.1f ms for %d inserts (log2(n) = %.1f)"),
+			(FPlatformTime::Seconds() - TotalStart) * 1000.0,
+			Tree.GetNodeCount(),
+			FMath::Log2(static_cast<double>(FMath::Max(Tree.GetNodeCount(), 1))));
+	}
+
+	static FAutoConsoleCommand ScoreBSTCommand(
+		TEXT("Runner.Bench.ScoreBST"),
+		TEXT("Monotonic insert, rank and select cost of FScoreBST. Args: [NumInserts]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&ScoreBST));
+
+	// ===== SCORE NODE STORAGE: PER-NODE NEW vs ARENA + INTERNED NAMES =====
+	// The old node carried its own FString and was allocated with new, so
+	// every entry paid two heap allocations. Reports allocation cost and
+	// bytes per entry for both layouts, plus full insert cost of the tree
+	struct FLegacyScoreNode
+	{
+		int32 Score;
+		FString PlayerName;
+		FLegacyScoreNode* Left;
+		FLegacyScoreNode* Right;
+		int32 Height;
+		int32 Size;
+	};
+
+	static void ScoreMemory(const TArray<FString>& Args)
+	{
+		const int32 NumEntries = FMath::Max(ParseIntArg(Args, 0, 1000000), 1);
+		const FString PlayerName = TEXT("Player");
+
+		UE_LOG(LogTemp, Warning, TEXT("=== Score Node Storage Benchmark (%d entries) ==="), NumEntries);
+
+		// Before: one new per node plus one FString copy per node
+		TArray<FLegacyScoreNode*> LegacyNodes;
+		LegacyNodes.Reserve(NumEntries);
+
+		double Start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumEntries; i++)
+		{
+			FLegacyScoreNode* Node = new FLegacyScoreNode();
+			Node->Score = i;
+			Node->PlayerName = PlayerName;
+			LegacyNodes.Add(Node);
+		}
+		const double LegacyAllocTime = FPlatformTime::Seconds() - Start;
+
+		const SIZE_T LegacyBytes = FMemory::QuantizeSize(sizeof(FLegacyScoreNode), alignof(FLegacyScoreNode))
+			+ FMemory::QuantizeSize(PlayerName.GetAllocatedSize(), alignof(TCHAR));
+
+		Start = FPlatformTime::Seconds();
+		for (FLegacyScoreNode* Node : LegacyNodes)
+		{
+			delete Node;
+		}
+		const double LegacyFreeTime = FPlatformTime::Seconds() - Start;
+		LegacyNodes.Empty();
+
+		// After: arena slots, name interned once
+		FScoreBST Tree;
+		const uint32 PlayerId = Tree.InternPlayerName(PlayerName);
+
+		Start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumEntries; i++)
+		{
+			Tree.Insert(i + 1, PlayerId);
+		}
+		const double InsertTime = FPlatformTime::Seconds() - Start;
+		const double ArenaBytes = static_cast<double>(Tree.GetAllocatedSize()) / NumEntries;
+
+		Start = FPlatformTime::Seconds();
+		Tree.Clear();
+		const double ClearTime = FPlatformTime::Seconds() - Start;
+
+		// Insert by name still interns, but only hashes - no allocation after the first
+		Start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumEntries; i++)
+		{
+			Tree.Insert(i + 1, PlayerName);
+		}
+		const double NamedInsertTime = FPlatformTime::Seconds() - Start;
+		Sink += Tree.GetNodeCount();
+
+		UE_LOG(LogTemp, Warning, TEXT("Legacy node:  %3d bytes/entry (%d node + name), alloc %.1f ns/entry, free %.1f ms"),
+			static_cast<int32>(LegacyBytes), static_cast<int32>(sizeof(FLegacyScoreNode)),
+			LegacyAllocTime * 1e9 / NumEntries, LegacyFreeTime * 1000.0);
+		UE_LOG(LogTemp, Warning, TEXT("Arena node:   %5.1f bytes/entry (%d node), clear %.3f ms"),
+			ArenaBytes, static_cast<int32>(sizeof(FScoreNode)), ClearTime * 1000.0);
+		UE_LOG(LogTemp, Warning, TEXT("Tree insert:  %.1f ns/op by ID, %.1f ns/op by name (%.2f M inserts/s)"),
+			InsertTime * 1e9 / NumEntries, NamedInsertTime * 1e9 / NumEntries, NumEntries / InsertTime / 1e6);
+	}
+
+	static FAutoConsoleCommand ScoreMemoryCommand(
+		TEXT("Runner.Bench.ScoreMemory"),
+		TEXT("Bytes per entry and allocation cost of score nodes, legacy vs arena. Args: [NumEntries]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&ScoreMemory));
+
+	// ===== PERSISTENT LEADERBOARD: STARTUP vs SIZE =====
+	// Open() only maps the snapshot, so it should stay flat as the file grows;
+	// LoadInto() is the O(n) alternative when a full in-memory tree is needed
+	static void Leaderboard(const TArray<FString>& Args)
+	{
+		const int32 MaxEntries = FMath::Max(ParseIntArg(Args, 0, 1000000), 1);
+		const FString Directory = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Benchmarks"), TEXT("Leaderboard"));
+		FRandomStream Random(1234);
+
+		UE_LOG(LogTemp, Warning, TEXT("=== Leaderboard Store Benchmark (up to %d entries) ==="), MaxEntries);
+		UE_LOG(LogTemp, Warning, TEXT("   Entries | File (KB) | Open (ms) | Rank (ns/op) | Top10 (us) | LoadInto (ms)"));
+
+		for (int32 NumEntries = FMath::Min(1000, MaxEntries); ; NumEntries = FMath::Min(NumEntries * 10, MaxEntries))
+		{
+			// Write a snapshot directly rather than appending NumEntries log records
+			FPlayerNameTable Names;
+			for (int32 i = 0; i < 1000; i++)
+			{
+				Names.Intern(FString::Printf(TEXT("Player%d"), i));
+			}
+
+			TArray<FLeaderboardSnapshotEntry> Entries;
+			Entries.SetNumUninitialized(NumEntries);
+			for (FLeaderboardSnapshotEntry& Entry : Entries)
+			{
+				Entry.Score = Random.RandRange(0, 1000000);
+				Entry.NameId = Random.RandRange(0, Names.Num() - 1);
+			}
+			Entries.Sort([](const FLeaderboardSnapshotEntry& A, const FLeaderboardSnapshotEntry& B) { return A.Score < B.Score; });
+
+			TArray<uint8> Bytes;
+			FLeaderboardStore::SerializeSnapshot(Entries, Names, 0, Bytes);
+			IFileManager::Get().DeleteDirectory(*Directory, false, true);
+			IFileManager::Get().MakeDirectory(*Directory, true);
+			FFileHelper::SaveArrayToFile(Bytes, *FPaths::Combine(Directory, TEXT("Scores.snap")));
+
+			FLeaderboardStore Store;
+			double Start = FPlatformTime::Seconds();
+			Store.Open(Directory);
+			const double OpenTime = FPlatformTime::Seconds() - Start;
+
+			const int32 NumQueries = 100000;
+			int64 Checksum = 0;
+			Start = FPlatformTime::Seconds();
+			for (int32 i = 0; i < NumQueries; i++)
+			{
+				Checksum += Store.GetRank((i * 7919) % 1000000);
+			}
+			const double RankTime = FPlatformTime::Seconds() - Start;
+
+			Start = FPlatformTime::Seconds();
+			Checksum += Store.GetTopScores(10).Num();
+			const double TopTime = FPlatformTime::Seconds() - Start;
+
+			FScoreBST Tree;
+			Start = FPlatformTime::Seconds();
+			Store.LoadInto(Tree);
+			const double LoadTime = FPlatformTime::Seconds() - Start;
+			Sink += Checksum + Tree.GetHeight();
+
+			UE_LOG(LogTemp, Warning, TEXT("%10d | %9d | %9.2f | %12.1f | %10.1f | %13.1f"),
+				Store.Num(),
+				Bytes.Num() / 1024,
+				OpenTime * 1000.0,
+				RankTime * 1e9 / NumQueries,
+				TopTime * 1e6,
+				LoadTime * 1000.0);
+
+			if (NumEntries == MaxEntries)
+				break;
+		}
+
+		IFileManager::Get().DeleteDirectory(*Directory, false, true);
+	}
+
+	static FAutoConsoleCommand LeaderboardCommand(
+		TEXT("Runner.Bench.Leaderboard"),
+		TEXT("Startup, rank and bulk-load cost of the persistent leaderboard by size. Args: [MaxEntries]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&Leaderboard));
+
+	// ===== RUN TIME SERIES vs ONE BST NODE PER COIN =====
+	// Simulates a long run with a pickup every few hundred units and compares
+	// the encoded series with what per-coin BST inserts used to cost
+	static void RunSeries(const TArray<FString>& Args)
+	{
+		const int32 NumSamples = FMath::Max(ParseIntArg(Args, 0, 100000), 1);
+		FRandomStream Random(1234);
+
+		FRunTimeSeries Series;
+		float Time = 0.0f;
+		float Distance = 0.0f;
+
+		double Start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumSamples; i++)
+		{
+			Time += Random.FRandRange(0.05f, 1.5f);
+			Distance += Random.FRandRange(50.0f, 1500.0f);
+			Series.AddSample(Time, Distance, i + 1);
+		}
+		const double AppendTime = FPlatformTime::Seconds() - Start;
+
+		const int32 NumQueries = 100000;
+		int64 Checksum = 0;
+		Start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumQueries; i++)
+		{
+			Checksum += Series.GetCoinsAtDistance(Random.FRandRange(0.0f, Distance));
+		}
+		const double QueryTime = FPlatformTime::Seconds() - Start;
+		Sink += Checksum;
+
+		UE_LOG(LogTemp, Warning, TEXT("=== Run Time Series Benchmark (%d samples) ==="), NumSamples);
+		UE_LOG(LogTemp, Warning, TEXT("Series:    %.2f bytes/sample, append %.1f ns, coins-at-distance %.1f ns"),
+			static_cast<double>(Series.GetAllocatedSize()) / NumSamples,
+			AppendTime * 1e9 / NumSamples,
+			QueryTime * 1e9 / NumQueries);
+		UE_LOG(LogTemp, Warning, TEXT("BST nodes: %d bytes/coin (arena node, no history queries)"),
+			static_cast<int32>(sizeof(FScoreNode)));
+	}
+
+	static FAutoConsoleCommand RunSeriesCommand(
+		TEXT("Runner.Bench.RunSeries"),
+		TEXT("Memory and query cost of the per-run time series. Args: [NumSamples]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunSeries));
+	// ===== QUANTILE SKETCH vs EXACT RANKS FROM THE TREE =====
+	// Feeds the same skewed score stream to a KLL sketch and an FScoreBST,
+	// then compares ranks, memory and cost; also merges per-shard sketches
+	static void QuantileSketch(const TArray<FString>& Args)
+	{
+		const int32 NumRuns = FMath::Max(ParseIntArg(Args, 0, 1000000), 1);
+		const int32 K = ParseIntArg(Args, 1, 200);
+		const int32 NumShards = 16;
+		FRandomStream Random(1234);
+
+		// Long-tailed like real run scores: most runs short, a few very long
+		TArray<int32> Scores;
+		Scores.SetNumUninitialized(NumRuns);
+		for (int32& Score : Scores)
+		{
+			Score = FMath::FloorToInt(-FMath::Loge(1.0f - Random.FRand() * 0.999999f) * 400.0f);
+		}
+
+		FQuantileSketch Sketch(K);
+		double Start = FPlatformTime::Seconds();
+		for (int32 Score : Scores)
+		{
+			Sketch.Add(Score);
+		}
+		const double SketchAddTime = FPlatformTime::Seconds() - Start;
+
+		FScoreBST Tree;
+		const uint32 PlayerId = Tree.InternPlayerName(TEXT("Player"));
+		Start = FPlatformTime::Seconds();
+		for (int32 Score : Scores)
+		{
+			Tree.Insert(Score, PlayerId);
+		}
+		const double TreeInsertTime = FPlatformTime::Seconds() - Start;
+
+		// Shards as if each session or server kept its own sketch
+		TArray<FQuantileSketch> Shards;
+		for (int32 i = 0; i < NumShards; i++)
+		{
+			Shards.Emplace(K);
+		}
+		for (int32 i = 0; i < NumRuns; i++)
+		{
+			Shards[i % NumShards].Add(Scores[i]);
+		}
+
+		FQuantileSketch Merged(K);
+		Start = FPlatformTime::Seconds();
+		for (const FQuantileSketch& Shard : Shards)
+		{
+			Merged.Merge(Shard);
+		}
+		const double MergeTime = FPlatformTime::Seconds() - Start;
+
+		// Rank error in runs, relative to the whole population
+		const int32 NumQueries = 10000;
+		TArray<int32> Queries;
+		Queries.SetNumUninitialized(NumQueries);
+		for (int32& Query : Queries)
+		{
+			Query = Scores[Random.RandRange(0, NumRuns - 1)];
+		}
+
+		double MaxError = 0.0, SumError = 0.0, MaxMergedError = 0.0;
+		for (int32 Query : Queries)
+		{
+			const int64 Exact = Tree.GetRank(Query);
+			const double Error = FMath::Abs(static_cast<double>(Sketch.GetRank(Query) - Exact)) / NumRuns;
+			const double MergedError = FMath::Abs(static_cast<double>(Merged.GetRank(Query) - Exact)) / NumRuns;
+			MaxError = FMath::Max(MaxError, Error);
+			SumError += Error;
+			MaxMergedError = FMath::Max(MaxMergedError, MergedError);
+		}
+
+		int64 Checksum = 0;
+		Start = FPlatformTime::Seconds();
+		for (int32 Query : Queries)
+		{
+			Checksum += Sketch.GetRank(Query);
+		}
+		const double SketchRankTime = FPlatformTime::Seconds() - Start;
+
+		Start = FPlatformTime::Seconds();
+		for (int32 Query : Queries)
+		{
+			Checksum += Tree.GetRank(Query);
+		}
+		const double TreeRankTime = FPlatformTime::Seconds() - Start;
+		Sink += Checksum;
+
+		TArray<uint8> Bytes;
+		Sketch.Serialize(Bytes);
+
+		UE_LOG(LogTemp, Warning, TEXT("=== Quantile Sketch Benchmark (%d runs, K = %d) ==="), NumRuns, K);
+		UE_LOG(LogTemp, Warning, TEXT("Sketch: add %.1f ns, rank %.1f ns, %d items retained, %d KB in memory, %d bytes serialized"),
+			SketchAddTime * 1e9 / NumRuns, SketchRankTime * 1e9 / NumQueries, Sketch.GetRetainedCount(),
+			static_cast<int32>(Sketch.GetAllocatedSize() / 1024), Bytes.Num());
+		UE_LOG(LogTemp, Warning, TEXT("Tree:   insert %.1f ns, rank %.1f ns, %d KB in memory"),
+			TreeInsertTime * 1e9 / NumRuns, TreeRankTime * 1e9 / NumQueries,
+			static_cast<int32>(Tree.GetAllocatedSize() / 1024));
+		UE_LOG(LogTemp, Warning, TEXT("Rank error: max %.3f%%, mean %.3f%% of runs; %d merged shards max %.3f%% (merge %.2f ms)"),
+			MaxError * 100.0, SumError * 100.0 / NumQueries, NumShards, MaxMergedError * 100.0, MergeTime * 1000.0);
+		UE_LOG(LogTemp, Warning, TEXT("Median: sketch %d, exact %d"),
+			Sketch.GetQuantile(0.5), Tree.SelectByRank(NumRuns / 2 + 1)->Score);
+	}
+
+	static FAutoConsoleCommand QuantileSketchCommand(
+		TEXT("Runner.Bench.QuantileSketch"),
+		TEXT("Accuracy, memory and cost of the score sketch against exact tree ranks. Args: [NumRuns] [K]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&QuantileSketch));
+	// ===== SORTING: LEGACY QUICKSORT vs RADIX =====
+	// The old Lomuto quicksort recursed once per element on sorted or
+	// few-distinct input, so it only runs where the stack survives it
+	static void LegacyQuickSort(TArray<int32>& Scores, int32 Low, int32 High)
+	{
+		if (Low < High)
+		{
+			const int32 Pivot = Scores[High];
+			int32 i = Low - 1;
+			for (int32 j = Low; j < High; j++)
+			{
+				if (Scores[j] <= Pivot)
+				{
+					i++;
+					Swap(Scores[i], Scores[j]);
+				}
+			}
+			Swap(Scores[i + 1], Scores[High]);
+
+			LegacyQuickSort(Scores, Low, i);
+			LegacyQuickSort(Scores, i + 2, High);
+		}
+	}
+
+	// (score, player) as a leaderboard export would carry it
+	struct FSortRecord
+	{
+		int32 Score;
+		uint32 PlayerId;
+	};
+
+	// Average seconds per sort of a fresh copy of Input
+	template<typename SortFuncType>
+	static double TimeSort(const TArray<int32>& Input, TArray<int32>& Work, int32 Repeats, SortFuncType SortFunc)
+	{
+		double Total = 0.0;
+		for (int32 Repeat = 0; Repeat < Repeats; Repeat++)
+		{
+			FMemory::Memcpy(Work.GetData(), Input.GetData(), Input.Num() * sizeof(int32));
+			const double Start = FPlatformTime::Seconds();
+			SortFunc(Work);
+			Total += FPlatformTime::Seconds() - Start;
+		}
+		Sink += Work[Work.Num() / 2];
+		return Total / Repeats;
+	}
+
+	static void Sort(const TArray<FString>& Args)
+	{
+		// The largest size holds ~24 bytes per entry at once (input, work copy, records, radix scratch)
+		const int32 MaxEntries = FMath::Max(ParseIntArg(Args, 0, 4000000), 1);
+		TArray<int32> Sizes;
+		for (int32 Size : { 1000, 1000000 })
+		{
+			if (Size < MaxEntries)
+			{
+				Sizes.Add(Size);
+			}
+		}
+		Sizes.Add(MaxEntries);
+		const TCHAR* InputNames[] = { TEXT("random"), TEXT("sorted"), TEXT("16 distinct") };
+		FRandomStream Random(1234);
+
+		UE_LOG(LogTemp, Warning, TEXT("=== Sort Benchmark (ms per sort, %d cores) ==="), FPlatformMisc::NumberOfCoresIncludingHyperthreads());
+		UE_LOG(LogTemp, Warning, TEXT("    Entries | Input       | QuickSort | Algo::Sort | Radix 1T | Radix MT | Records MT (desc)"));
+
+		for (int32 Size : Sizes)
+		{
+			// Small sizes are repeated so the timer resolution does not dominate
+			const int32 Repeats = FMath::Max(1, 1000000 / Size);
+
+			TArray<int32> Input;
+			TArray<int32> Work;
+			TArray<FSortRecord> Records;
+			Input.SetNumUninitialized(Size);
+			Work.SetNumUninitialized(Size);
+			Records.SetNumUninitialized(Size);
+
+			for (int32 Kind = 0; Kind < static_cast<int32>(UE_ARRAY_COUNT(InputNames)); Kind++)
+			{
+				for (int32 i = 0; i < Size; i++)
+				{
+					Input[i] = Kind == 0 ? Random.RandRange(0, 1000000) : Kind == 1 ? i : Random.RandRange(0, 15) * 100;
+				}
+
+				const bool bLegacySafe = Kind == 0 ? Size <= 1000000 : Size <= 10000;
+				const double LegacyTime = bLegacySafe
+					? TimeSort(Input, Work, Repeats, [](TArray<int32>& A) { LegacyQuickSort(A, 0, A.Num() - 1); })
+					: -1.0;
+				const double AlgoSortTime = TimeSort(Input, Work, Repeats, [](TArray<int32>& A) { Algo::Sort(A); });
+				const double SerialTime = TimeSort(Input, Work, Repeats,
+					[](TArray<int32>& A) { FRadixSort::Sort(A, ERadixSortFlags::SingleThreaded); });
+				const double ParallelTime = TimeSort(Input, Work, Repeats, [](TArray<int32>& A) { FRadixSort::Sort(A); });
+
+				double RecordTime = 0.0;
+				for (int32 Repeat = 0; Repeat < Repeats; Repeat++)
+				{
+					for (int32 i = 0; i < Size; i++)
+					{
+						Records[i] = { Input[i], static_cast<uint32>(i) };
+					}
+					const double Start = FPlatformTime::Seconds();
+					FRadixSort::SortByKey(TArrayView<FSortRecord>(Records),
+						[](const FSortRecord& Record) { return Record.Score; }, ERadixSortFlags::Descending);
+					RecordTime += FPlatformTime::Seconds() - Start;
+				}
+				RecordTime /= Repeats;
+				Sink += Records[0].PlayerId;
+
+				const FString LegacyText = bLegacySafe ? FString::Printf(TEXT("%9.3f"), LegacyTime * 1000.0) : TEXT("(stack)");
+				UE_LOG(LogTemp, Warning, TEXT("%11d | %-11s | %9s | %10.3f | %8.3f | %8.3f | %17.3f"),
+					Size, InputNames[Kind], *LegacyText,
+					AlgoSortTime * 1000.0, SerialTime * 1000.0, ParallelTime * 1000.0, RecordTime * 1000.0);
+			}
+		}
+	}
+
+	static FAutoConsoleCommand SortCommand(
+		TEXT("Runner.Bench.Sort"),
+		TEXT("Legacy quicksort vs Algo::Sort vs radix sort (keys and records) at 1K/1M/MaxEntries. Args: [MaxEntries=4000000]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&Sort));
+	// ===== SEARCH: BRANCHY vs BRANCHLESS vs EYTZINGER =====
+	// Random rank lookups from small (cache-resident) to well past L3;
+	// lookups per second for each layout, all checked against each other
+	static int32 LegacyLowerBound(const TArray<int32>& Scores, int32 Target)
+	{
+		int32 Left = 0;
+		int32 Right = Scores.Num();
+		while (Left < Right)
+		{
+			const int32 Mid = Left + (Right - Left) / 2;
+			if (Scores[Mid] < Target)
+				Left = Mid + 1;
+			else
+				Right = Mid;
+		}
+		return Left;
+	}
+
+	template<typename SearchFuncType>
+	static double TimeSearch(const TArray<int32>& Queries, int64& OutChecksum, SearchFuncType SearchFunc)
+	{
+		int64 Checksum = 0;
+		const double Start = FPlatformTime::Seconds();
+		for (int32 Query : Queries)
+		{
+			Checksum += SearchFunc(Query);
+		}
+		const double Elapsed = FPlatformTime::Seconds() - Start;
+		OutChecksum = Checksum;
+		Sink += Checksum;
+		return Queries.Num() / Elapsed / 1e6;
+	}
+
+	static void Search(const TArray<FString>& Args)
+	{
+		const int32 MaxEntries = FMath::Max(ParseIntArg(Args, 0, 64 * 1024 * 1024), 1);
+		const int32 NumQueries = FMath::Max(ParseIntArg(Args, 1, 2000000), 1);
+		const int32 Sizes[] = { 4 * 1024, 256 * 1024, 4 * 1024 * 1024, 64 * 1024 * 1024 };
+		FRandomStream Random(1234);
+
+		TArray<int32> Queries;
+		Queries.SetNumUninitialized(NumQueries);
+
+		UE_LOG(LogTemp, Warning, TEXT("=== Score Search Benchmark (M lookups/s, %d random queries) ==="), NumQueries);
+		UE_LOG(LogTemp, Warning, TEXT("    Entries |     Data | Branchy | Algo::LowerBound | Branchless | Eytzinger"));
+
+		for (int32 Size : Sizes)
+		{
+			if (Size > MaxEntries)
+				continue;
+
+			TArray<int32> Scores;
+			Scores.SetNumUninitialized(Size);
+			for (int32& Score : Scores)
+			{
+				Score = Random.RandRange(0, MAX_int32 - 1);
+			}
+			FRadixSort::Sort(Scores);
+
+			FEytzingerIndex Eytzinger;
+			Eytzinger.Build(Scores);
+
+			for (int32& Query : Queries)
+			{
+				Query = Random.RandRange(0, MAX_int32 - 1);
+			}
+
+			int64 Expected = 0, Checksum = 0;
+			bool bMatch = true;
+			const double Branchy = TimeSearch(Queries, Expected, [&Scores](int32 Query) { return LegacyLowerBound(Scores, Query); });
+			const double AlgoBound = TimeSearch(Queries, Checksum, [&Scores](int32 Query) { return Algo::LowerBound(Scores, Query); });
+			bMatch &= Checksum == Expected;
+			const double Branchless = TimeSearch(Queries, Checksum, [&Scores](int32 Query) { return FSortedSearch::LowerBound(Scores, Query); });
+			bMatch &= Checksum == Expected;
+			const double EytzingerRate = TimeSearch(Queries, Checksum, [&Eytzinger](int32 Query) { return Eytzinger.LowerBound(Query); });
+			bMatch &= Checksum == Expected;
+
+			UE_LOG(LogTemp, Warning, TEXT("%11d | %5.1f MB | %7.2f | %16.2f | %10.2f | %9.2f%s"),
+				Size, static_cast<double>(Size) * sizeof(int32) / (1024.0 * 1024.0),
+				Branchy, AlgoBound, Branchless, EytzingerRate, bMatch ? TEXT("") : TEXT("  RESULTS DIFFER"));
+		}
+	}
+
+	static FAutoConsoleCommand SearchCommand(
+		TEXT("Runner.Bench.Search"),
+		TEXT("Lower-bound lookups/s: branchy, branchless and Eytzinger, up to past L3. Args: [MaxEntries] [NumQueries]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&Search));
+
+	// ===== SHARDED LEADERBOARD MERGE =====
+	// Many per-session snapshots folded into one best-score-per-player board;
+	// the output is checked against the best scores recorded while generating
+	static void LeaderboardMerge(const TArray<FString>& Args)
+	{
+		const int32 NumShards = FMath::Max(ParseIntArg(Args, 0, 200), 1);
+		const int32 EntriesPerShard = FMath::Max(ParseIntArg(Args, 1, 50000), 1);
+		const int32 NumPlayers = FMath::Max(ParseIntArg(Args, 2, 1000000), 1);
+		const FString Directory = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Benchmarks"), TEXT("LeaderboardMerge"));
+		FRandomStream Random(1234);
+
+		UE_LOG(LogTemp, Warning, TEXT("=== Leaderboard Merge Benchmark (%d shards x %d entries, %d players) ==="),
+			NumShards, EntriesPerShard, NumPlayers);
+
+		IFileManager::Get().DeleteDirectory(*Directory, false, true);
+		IFileManager::Get().MakeDirectory(*Directory, true);
+
+		TArray<int32> BestScores;
+		BestScores.Init(MIN_int32, NumPlayers);
+
+		TArray<FString> ShardPaths;
+		int64 InputBytes = 0;
+		for (int32 Shard = 0; Shard < NumShards; Shard++)
+		{
+			FPlayerNameTable Names;
+			TArray<FLeaderboardSnapshotEntry> Entries;
+			Entries.SetNumUninitialized(EntriesPerShard);
+			for (FLeaderboardSnapshotEntry& Entry : Entries)
+			{
+				const int32 Player = Random.RandRange(0, NumPlayers - 1);
+				Entry.Score = Random.RandRange(0, 10000000);
+				Entry.NameId = Names.Intern(FString::Printf(TEXT("Player%d"), Player));
+				BestScores[Player] = FMath::Max(BestScores[Player], Entry.Score);
+			}
+			FRadixSort::SortByKey(TArrayView<FLeaderboardSnapshotEntry>(Entries),
+				[](const FLeaderboardSnapshotEntry& Entry) { return Entry.Score; });
+
+			TArray<uint8> Bytes;
+			FLeaderboardStore::SerializeSnapshot(Entries, Names, 0, Bytes);
+			const FString Path = FPaths::Combine(Directory, FString::Printf(TEXT("Shard%03d.snap"), Shard));
+			FFileHelper::SaveArrayToFile(Bytes, *Path);
+			ShardPaths.Add(Path);
+			InputBytes += Bytes.Num();
+		}
+
+		int32 ExpectedPlayers = 0;
+		int64 ExpectedChecksum = 0;
+		for (int32 Score : BestScores)
+		{
+			if (Score != MIN_int32)
+			{
+				ExpectedPlayers++;
+				ExpectedChecksum += Score;
+			}
+		}
+
+		const FString OutputPath = FPaths::Combine(Directory, TEXT("Merged.snap"));
+		FLeaderboardMergeStats Stats;
+		if (!FLeaderboardMerge::MergeSnapshots(ShardPaths, OutputPath, &Stats))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Leaderboard merge failed"));
+			IFileManager::Get().DeleteDirectory(*Directory, false, true);
+			return;
+		}
+
+		// Every player once, at their best score, lowest first
+		TArray64<uint8> Output;
+		FFileHelper::LoadFileToArray(Output, *OutputPath);
+		bool bCorrect = FLeaderboardStore::IsValidSnapshot(Output.GetData(), Output.Num());
+		if (bCorrect)
+		{
+			const FLeaderboardSnapshotHeader& Header = *reinterpret_cast<const FLeaderboardSnapshotHeader*>(Output.GetData());
+			const FLeaderboardSnapshotEntry* Entries = reinterpret_cast<const FLeaderboardSnapshotEntry*>(Output.GetData() + Header.EntriesOffset);
+			int64 Checksum = 0;
+			for (uint32 i = 0; i < Header.NumEntries; i++)
+			{
+				bCorrect &= i == 0 || Entries[i - 1].Score <= Entries[i].Score;
+				Checksum += Entries[i].Score;
+			}
+			bCorrect &= static_cast<int32>(Header.NumEntries) == ExpectedPlayers && Checksum == ExpectedChecksum;
+		}
+
+		UE_LOG(LogTemp, Warning, TEXT("Input:   %lld entries, %.1f MB on disk"), Stats.InputEntries, InputBytes / (1024.0 * 1024.0));
+		UE_LOG(LogTemp, Warning, TEXT("Output:  %d players (expected %d)%s"), Stats.OutputEntries, ExpectedPlayers,
+			bCorrect ? TEXT("") : TEXT("  OUTPUT WRONG"));
+		UE_LOG(LogTemp, Warning, TEXT("Merge:   %.2f s, %.1f M entries/s over %d partitions"),
+			Stats.Seconds, Stats.InputEntries / Stats.Seconds / 1e6, Stats.NumPartitions);
+		UE_LOG(LogTemp, Warning, TEXT("Working: %.1f MB (inputs and temporary files are mapped, not loaded)"), Stats.WorkingBytes / (1024.0 * 1024.0));
+
+		IFileManager::Get().DeleteDirectory(*Directory, false, true);
+	}
+
+	static FAutoConsoleCommand LeaderboardMergeCommand(
+		TEXT("Runner.Bench.LeaderboardMerge"),
+		TEXT("Merge time and memory for sharded leaderboard snapshots. Args: [NumShards] [EntriesPerShard] [NumPlayers]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&LeaderboardMerge));
+
+	// ===== LEADERBOARD SNAPSHOTS UNDER CONCURRENT READERS =====
+	// Reader threads query published versions as fast as they can while this
+	// thread inserts and deletes; every version a reader sees must be
+	// internally consistent, and the last one must equal the tree
+	static void ScoreSnapshots(const TArray<FString>& Args)
+	{
+		const int32 NumReaders = FMath::Clamp(ParseIntArg(Args, 0, 4), 0, 64);
+		const int32 NumChanges = FMath::Max(ParseIntArg(Args, 1, 200000), 1);
+		const int32 InitialScores = 100000;
+		const int32 TopCount = 10;
+
+		UE_LOG(LogTemp, Warning, TEXT("=== Score Snapshot Stress (%d readers, %d changes on %d scores) ==="), NumReaders, NumChanges, InitialScores);
+
+		// Same change sequence with and without publishing
+		auto RunChanges = [NumChanges](FScoreBST& Tree, FRandomStream& Random)
+		{
+			for (int32 i = 0; i < NumChanges; i++)
+			{
+				if (i % 10 == 9)
+				{
+					Tree.Delete(Tree.SelectByRank(Random.RandRange(1, Tree.GetNodeCount()))->Score);
+				}
+				else
+				{
+					Tree.Insert(Random.RandRange(0, 10000000), static_cast<uint32>(Random.RandRange(0, 999)));
+				}
+			}
+		};
+
+		auto Populate = [InitialScores](FScoreBST& Tree, FRandomStream& Random)
+		{
+			for (int32 i = 0; i < 1000; i++)
+			{
+				Tree.InternPlayerName(FString::Printf(TEXT("Player%d"), i));
+			}
+			for (int32 i = 0; i < InitialScores; i++)
+			{
+				Tree.Insert(Random.RandRange(0, 10000000), static_cast<uint32>(Random.RandRange(0, 999)));
+			}
+		};
+
+		FScoreBST Plain;
+		FRandomStream PlainRandom(1234);
+		Populate(Plain, PlainRandom);
+		double Start = FPlatformTime::Seconds();
+		RunChanges(Plain, PlainRandom);
+		const double PlainTime = FPlatformTime::Seconds() - Start;
+
+		FScoreBST Tree;
+		FRandomStream Random(1234);
+		Populate(Tree, Random);
+		Tree.EnableSnapshots();
+
+		std::atomic<bool> bStop(false);
+		std::atomic<int64> NumQueries(0);
+		std::atomic<int64> NumViolations(0);
+
+		TArray<TFuture<void>> Readers;
+		for (int32 Reader = 0; Reader < NumReaders; Reader++)
+		{
+			Readers.Add(Async(EAsyncExecution::Thread, [&Tree, &bStop, &NumQueries, &NumViolations, TopCount]()
+			{
+				uint64 LastVersion = 0;
+				int64 Queries = 0;
+				int64 Violations = 0;
+				while (!bStop.load(std::memory_order_relaxed))
+				{
+					TSharedRef<const FScoreSnapshot, ESPMode::ThreadSafe> Snapshot = Tree.GetSnapshot();
+					Violations += Snapshot->GetVersion() < LastVersion ? 1 : 0;
+					LastVersion = Snapshot->GetVersion();
+
+					const TArray<FScoreSnapshotEntry> Top = Snapshot->GetTopScores(TopCount);
+					Violations += Top.Num() != FMath::Min(TopCount, Snapshot->Num()) ? 1 : 0;
+					for (int32 i = 0; i < Top.Num(); i++)
+					{
+						Violations += (i > 0 && Top[i - 1].Score < Top[i].Score) ? 1 : 0;
+						Violations += Snapshot->CountGreater(Top[i].Score) > i ? 1 : 0;
+						Violations += Snapshot->GetPlayerName(Top[i].PlayerId).IsEmpty() ? 1 : 0;
+					}
+					Queries += 1 + Top.Num();
+				}
+				NumQueries += Queries;
+				NumViolations += Violations;
+			}));
+		}
+
+		Start = FPlatformTime::Seconds();
+		RunChanges(Tree, Random);
+		const double PublishTime = FPlatformTime::Seconds() - Start;
+
+		bStop = true;
+		for (TFuture<void>& Reader : Readers)
+		{
+			Reader.Wait();
+		}
+
+		// The final version must be the tree
+		TSharedRef<const FScoreSnapshot, ESPMode::ThreadSafe> Final = Tree.GetSnapshot();
+		bool bMatches = Final->Num() == Tree.GetNodeCount();
+		const TArray<FScoreSnapshotEntry> FinalTop = Final->GetTopScores(1000);
+		const TArray<FScoreNode*> TreeTop = Tree.GetTopScores(1000);
+		for (int32 i = 0; i < FinalTop.Num() && bMatches; i++)
+		{
+			bMatches = FinalTop[i].Score == TreeTop[i]->Score;
+		}
+		for (int32 i = 0; i < 1000 && bMatches; i++)
+		{
+			const int32 Score = Random.RandRange(0, 10000000);
+			bMatches = Final->GetRank(Score) == Tree.GetRank(Score);
+		}
+
+		UE_LOG(LogTemp, Warning, TEXT("Changes without publishing: %8.1f ns each"), PlainTime * 1e9 / NumChanges);
+		UE_LOG(LogTemp, Warning, TEXT("Changes with publishing:    %8.1f ns each (%llu versions)"), PublishTime * 1e9 / NumChanges, Final->GetVersion());
+		UE_LOG(LogTemp, Warning, TEXT("Reader queries:             %8.2f M/s over %d threads"), NumQueries.load() / PublishTime / 1e6, NumReaders);
+		UE_LOG(LogTemp, Warning, TEXT("Inconsistent reads:         %lld"), NumViolations.load());
+		UE_LOG(LogTemp, Warning, TEXT("Final version matches tree: %s"), bMatches ? TEXT("yes") : TEXT("NO"));
+		Sink += Plain.GetNodeCount();
+	}
+
+	static FAutoConsoleCommand ScoreSnapshotsCommand(
+		TEXT("Runner.Bench.ScoreSnapshots"),
+		TEXT("Insert/delete cost with snapshot publishing while reader threads query. Args: [NumReaders] [NumChanges]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&ScoreSnapshots));
+
+	// ===== PER-PLAYER BEST SCORES: INDEX vs EVERY RUN IN THE TREE =====
+	// With one node per player the board stays the size of the player base;
+	// a score below the player's best should cost one array load, a better
+	// one a tree move, and a player's rank one lookup plus a rank query
+	static void PlayerBest(const TArray<FString>& Args)
+	{
+		const int32 NumPlayers = FMath::Max(ParseIntArg(Args, 0, 1000000), 1);
+		const int32 NumSubmissions = FMath::Max(ParseIntArg(Args, 1, 2000000), 1);
+		FRandomStream Random(1234);
+
+		UE_LOG(LogTemp, Warning, TEXT("=== Player Best Score Benchmark (%d players, %d submissions) ==="), NumPlayers, NumSubmissions);
+
+		FScoreBST Board;
+		for (int32 i = 0; i < NumPlayers; i++)
+		{
+			Board.InternPlayerName(FString::Printf(TEXT("Player%d"), i));
+		}
+
+		// Everyone's first run
+		double Start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumPlayers; i++)
+		{
+			Board.SubmitBest(Random.RandRange(1000000, 2000000), static_cast<uint32>(i));
+		}
+		const double FirstTime = FPlatformTime::Seconds() - Start;
+
+		TArray<uint32> Players;
+		Players.SetNumUninitialized(NumSubmissions);
+		for (uint32& Player : Players)
+		{
+			Player = static_cast<uint32>(Random.RandRange(0, NumPlayers - 1));
+		}
+
+		// Worse runs: every player's best is above 1,000,000
+		int64 Improved = 0;
+		Start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumSubmissions; i++)
+		{
+			Improved += Board.SubmitBest(i % 1000000, Players[i]) ? 1 : 0;
+		}
+		const double WorseTime = FPlatformTime::Seconds() - Start;
+
+		// Better runs: always above the current best
+		Start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumSubmissions; i++)
+		{
+			Improved += Board.SubmitBest(2000000 + i, Players[i]) ? 1 : 0;
+		}
+		const double BetterTime = FPlatformTime::Seconds() - Start;
+
+		int64 Checksum = 0;
+		Start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumSubmissions; i++)
+		{
+			Checksum += Board.GetPlayerRank(Players[i]);
+		}
+		const double RankTime = FPlatformTime::Seconds() - Start;
+		Sink += Checksum;
+
+		// The same runs kept one node each, as Insert does
+		const int64 RunsPerPlayerBoard = static_cast<int64>(NumPlayers) + 2 * static_cast<int64>(NumSubmissions);
+
+		UE_LOG(LogTemp, Warning, TEXT("First run:   %8.1f ns each"), FirstTime * 1e9 / NumPlayers);
+		UE_LOG(LogTemp, Warning, TEXT("Worse run:   %8.1f ns each (no-op)"), WorseTime * 1e9 / NumSubmissions);
+		UE_LOG(LogTemp, Warning, TEXT("Better run:  %8.1f ns each (node moved)"), BetterTime * 1e9 / NumSubmissions);
+		UE_LOG(LogTemp, Warning, TEXT("Player rank: %8.1f ns each"), RankTime * 1e9 / NumSubmissions);
+		UE_LOG(LogTemp, Warning, TEXT("Board: %d nodes, %.1f MB (every run kept: %lld nodes, %.1f MB); %s"),
+			Board.GetNodeCount(), Board.GetAllocatedSize() / (1024.0 * 1024.0),
+			RunsPerPlayerBoard, RunsPerPlayerBoard * sizeof(FScoreNode) / (1024.0 * 1024.0),
+			Improved == NumSubmissions ? TEXT("results OK") : TEXT("WRONG NUMBER OF IMPROVEMENTS"));
+	}
+
+	static FAutoConsoleCommand PlayerBestCommand(
+		TEXT("Runner.Bench.PlayerBest"),
+		TEXT("Per-player best-score board: worse/better submissions and player rank. Args: [NumPlayers] [NumSubmissions]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&PlayerBest));
+
+	// ===== NAME SEARCH: PREFIX INDEX vs SCANNING THE BOARD =====
+	// A search box over a million players: the trie should answer a short
+	// prefix in microseconds, and a hit should jump straight to its page of
+	// the board through the player's best node and a rank query
+	static void NameSearch(const TArray<FString>& Args)
+	{
+		const int32 NumPlayers = FMath::Max(ParseIntArg(Args, 0, 1000000), 1);
+		const int32 NumQueries = 100000;
+		const int32 PageSize = 20;
+		FRandomStream Random(1234);
+
+		UE_LOG(LogTemp, Warning, TEXT("=== Name Search Benchmark (%d players) ==="), NumPlayers);
+
+		// Syllable names share prefixes the way real handles do
+		static const TCHAR* Syllables[] = { TEXT("ka"), TEXT("Ri"), TEXT("mo"), TEXT("a"), TEXT("an"), TEXT("Zed"), TEXT("la"), TEXT("tor"), TEXT("x"), TEXT("Vi") };
+		const int32 NumSyllables = UE_ARRAY_COUNT(Syllables);
+
+		FScoreBST Board;
+		TArray<uint32> Players;
+		Players.Reserve(NumPlayers);
+		for (int32 i = 0; i < NumPlayers; i++)
+		{
+			FString Name;
+			for (int32 Part = Random.RandRange(1, 3); Part > 0; Part--)
+			{
+				Name += Syllables[Random.RandRange(0, NumSyllables - 1)];
+			}
+			Name.AppendInt(i);
+			Players.Add(Board.InternPlayerName(Name));
+		}
+		for (const uint32 Player : Players)
+		{
+			Board.SubmitBest(Random.RandRange(0, 10000000), Player);
+		}
+
+		double Start = FPlatformTime::Seconds();
+		Board.EnableNameIndex();
+		const double BuildTime = FPlatformTime::Seconds() - Start;
+
+		TArray<FString> Prefixes;
+		for (int32 i = 0; i < 64; i++)
+		{
+			Prefixes.Add(FString(Syllables[Random.RandRange(0, NumSyllables - 1)]) + FString(Syllables[Random.RandRange(0, NumSyllables - 1)]).Left(1));
+		}
+
+		// Top 10 matches for a two or three letter prefix
+		TArray<uint32> Matches;
+		int64 Checksum = 0;
+		Start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumQueries; i++)
+		{
+			Checksum += Board.FindPlayersByPrefix(Prefixes[i % Prefixes.Num()], 10, Matches);
+		}
+		const double SearchTime = FPlatformTime::Seconds() - Start;
+
+		// Full name typed in: find the player, their rank, and the page around them
+		Start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumQueries; i++)
+		{
+			const uint32 Player = Players[i % NumPlayers];
+			Board.FindPlayersByPrefix(Board.GetNameTable().GetName(Player), 1, Matches);
+			const int32 Rank = Board.GetPlayerRank(Matches[0]);
+			Checksum += Board.GetScoresFromRank(FMath::Max(1, Rank - PageSize / 2), PageSize).Num();
+		}
+		const double JumpTime = FPlatformTime::Seconds() - Start;
+
+		// Without the index: walk the board and test every name
+		const int32 NumScans = 5;
+		int32 ScanMatches = 0;
+		Start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumScans; i++)
+		{
+			for (const FScoreNode* Node : Board.InOrderTraversal())
+			{
+				ScanMatches += Board.GetPlayerName(Node).StartsWith(Prefixes[i], ESearchCase::IgnoreCase) ? 1 : 0;
+			}
+		}
+		const double ScanTime = FPlatformTime::Seconds() - Start;
+
+		int32 IndexMatches = 0;
+		for (int32 i = 0; i < NumScans; i++)
+		{
+			IndexMatches += Board.FindPlayersByPrefix(Prefixes[i], 0, Matches);
+		}
+		Sink += Checksum;
+
+		UE_LOG(LogTemp, Warning, TEXT("Index build:   %8.1f ns per player"), BuildTime * 1e9 / NumPlayers);
+		UE_LOG(LogTemp, Warning, TEXT("Prefix search: %8.2f us (top 10)"), SearchTime * 1e6 / NumQueries);
+		UE_LOG(LogTemp, Warning, TEXT("Jump to rank:  %8.2f us (find + rank + %d rows)"), JumpTime * 1e6 / NumQueries, PageSize);
+		UE_LOG(LogTemp, Warning, TEXT("Board scan:    %8.2f ms per prefix"), ScanTime * 1e3 / NumScans);
+		UE_LOG(LogTemp, Warning, TEXT("Index: %d nodes, %.1f MB; %s"),
+			Board.GetNameIndex()->NumNodes(), Board.GetNameIndex()->GetAllocatedSize() / (1024.0 * 1024.0),
+			IndexMatches == ScanMatches ? TEXT("results OK") : TEXT("MATCH COUNTS DIFFER"));
+	}
+
+	static FAutoConsoleCommand NameSearchCommand(
+		TEXT("Runner.Bench.NameSearch"),
+		TEXT("Player-name prefix index: build, prefix search, jump to rank, vs a board scan. Args: [NumPlayers]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&NameSearch));
+
+	// ===== TIME WINDOWS: DAY BUCKETS vs REBUILDING FROM HISTORY =====
+	// Insert cost and memory should not move as weeks of history pile up,
+	// while a board rebuilt from the full run history for the current week
+	// costs more every week
+	static void TimeWindows(const TArray<FString>& Args)
+	{
+		const int32 RunsPerDay = FMath::Max(ParseIntArg(Args, 0, 100000), 1);
+		const int32 NumWeeks = FMath::Max(ParseIntArg(Args, 1, 8), 1);
+		const int32 NumQueries = 100000;
+		FRandomStream Random(1234);
+
+		UE_LOG(LogTemp, Warning, TEXT("=== Time Window Benchmark (%d runs per day, %d weeks) ==="), RunsPerDay, NumWeeks);
+
+		FTimeWindowedLeaderboard Board;
+		for (int32 i = 0; i < 100000; i++)
+		{
+			Board.GetNameTable().Intern(FString::Printf(TEXT("Player%d"), i));
+		}
+
+		// Whole run history, only for the rebuild comparison
+		TArray<int32> HistoryScores;
+		TArray<int64> HistoryTimes;
+
+		// Monday 2024-01-01 00:00 UTC
+		const int64 FirstMonday = 1704067200;
+		const int64 SecondsPerRun = FMath::Max<int64>(86400 / RunsPerDay, 1);
+		int64 Now = FirstMonday;
+
+		for (int32 Week = 0; Week < NumWeeks; Week++)
+		{
+			const int32 NumRuns = 7 * RunsPerDay;
+			const double Start = FPlatformTime::Seconds();
+			for (int32 i = 0; i < NumRuns; i++)
+			{
+				const int32 Score = Random.RandRange(0, 20000);
+				Board.Insert(Score, static_cast<uint32>(Random.RandRange(0, 99999)), Now);
+				HistoryScores.Add(Score);
+				HistoryTimes.Add(Now);
+				Now += SecondsPerRun;
+			}
+			const double InsertTime = FPlatformTime::Seconds() - Start;
+
+			UE_LOG(LogTemp, Warning, TEXT("Week %d: %8.1f ns per insert, %.1f MB live, %d expired distinct scores"),
+				Week + 1, InsertTime * 1e9 / NumRuns, Board.GetAllocatedSize() / (1024.0 * 1024.0), Board.NumExpiredScores());
+		}
+
+		const ELeaderboardWindow Windows[] = { ELeaderboardWindow::Daily, ELeaderboardWindow::Weekly, ELeaderboardWindow::AllTime };
+		const TCHAR* WindowNames[] = { TEXT("Daily"), TEXT("Weekly"), TEXT("All-time") };
+		int64 Checksum = 0;
+		for (int32 w = 0; w < static_cast<int32>(UE_ARRAY_COUNT(Windows)); w++)
+		{
+			double Start = FPlatformTime::Seconds();
+			for (int32 i = 0; i < NumQueries; i++)
+			{
+				Checksum += Board.GetRank(Windows[w], Random.RandRange(0, 20000));
+			}
+			const double RankTime = FPlatformTime::Seconds() - Start;
+
+			Start = FPlatformTime::Seconds();
+			for (int32 i = 0; i < NumQueries / 10; i++)
+			{
+				Checksum += Board.GetTopScores(Windows[w], 10).Num();
+			}
+			const double TopTime = FPlatformTime::Seconds() - Start;
+
+			UE_LOG(LogTemp, Warning, TEXT("%-8s: %6d entries, rank %8.1f ns, top 10 %8.1f ns"), WindowNames[w],
+				Board.Num(Windows[w]), RankTime * 1e9 / NumQueries, TopTime * 1e9 / (NumQueries / 10));
+		}
+
+		// Without buckets: pick this week's runs out of the history and build a board
+		const int64 WeekStart = FirstMonday + static_cast<int64>(NumWeeks - 1) * 7 * 86400;
+		const double Start = FPlatformTime::Seconds();
+		TArray<int32> WeekScores;
+		for (int32 i = 0; i < HistoryScores.Num(); i++)
+		{
+			if (HistoryTimes[i] >= WeekStart)
+			{
+				WeekScores.Add(HistoryScores[i]);
+			}
+		}
+		Algo::Sort(WeekScores);
+		TArray<uint32> WeekPlayers;
+		WeekPlayers.SetNumZeroed(WeekScores.Num());
+		FScoreBST Rebuilt;
+		Rebuilt.BuildFromSorted(WeekScores, WeekPlayers);
+		const double RebuildTime = FPlatformTime::Seconds() - Start;
+		Sink += Checksum;
+
+		UE_LOG(LogTemp, Warning, TEXT("Rebuild weekly board from %d runs of history: %.1f ms; %s"), HistoryScores.Num(), RebuildTime * 1e3,
+			Rebuilt.GetNodeCount() == Board.Num(ELeaderboardWindow::Weekly) ? TEXT("results OK") : TEXT("WEEKLY COUNTS DIFFER"));
+	}
+
+	static FAutoConsoleCommand TimeWindowsCommand(
+		TEXT("Runner.Bench.TimeWindows"),
+		TEXT("Daily/weekly/all-time boards from day buckets: insert cost and memory per week, rank and top 10, vs a rebuild. Args: [RunsPerDay] [Weeks]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&TimeWindows));
+
+	// ===== LANE GRAPH: ROUTE TABLE vs BFS =====
+	// Random block / unblock / edge changes, with every pair's table route
+	// checked against a fresh BFS after each change. Includes the case that
+	// matters for dodging: the runner's own lane is blocked and must be left
+	static void LaneGraph(const TArray<FString>& Args)
+	{
+		const int32 NumChanges = ParseIntArg(Args, 0, 100000);
+		const int32 NumLanes = FMath::Max(ParseIntArg(Args, 1, 5), 2);
+
+		FRandomStream Random(1234);
+		TArray<float> Positions;
+		for (int32 Lane = 0; Lane < NumLanes; Lane++)
+		{
+			Positions.Add(Lane * 200.0f);
+		}
+
+		UE_LOG(LogTemp, Warning, TEXT("=== Lane Graph Benchmark (%d changes, %d lanes) ==="), NumChanges, NumLanes);
+
+		FLaneGraph Graph;
+		Graph.Initialize(Positions);
+
+		int32 Mismatches = 0;
+		int64 Checksum = 0;
+		for (int32 Change = 0; Change < NumChanges; Change++)
+		{
+			const int32 A = Random.RandRange(0, NumLanes - 1);
+			const int32 B = Random.RandRange(0, NumLanes - 1);
+			switch (Random.RandRange(0, 3))
+			{
+			case 0: Graph.SetLaneBlocked(A, true); break;
+			case 1: Graph.SetLaneBlocked(A, false); break;
+			case 2: if (A != B) Graph.AddEdge(A, B); break;
+			default: if (A != B) Graph.RemoveEdge(A, B); break;
+			}
+
+			for (int32 From = 0; From < NumLanes; From++)
+			{
+				for (int32 To = 0; To < NumLanes; To++)
+				{
+					const int32 Hop = Graph.GetNextHop(From, To);
+					const int32 Distance = Graph.GetDistance(From, To);
+					const TArray<int32> Path = Graph.BFS_FindPath(From, To);
+					const int32 ExpectedDistance = Path.Num() > 0 ? Path.Num() - 1 : INDEX_NONE;
+					const bool bHopOk = Distance <= 0 || (!Graph.IsLaneBlocked(Hop) && Graph.GetDistance(Hop, To) == Distance - 1);
+					if (Distance != ExpectedDistance || !bHopOk)
+					{
+						Mismatches++;
+					}
+				}
+			}
+		}
+
+		// Query cost on the final graph
+		const int32 NumQueries = 1000000;
+		double Start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumQueries; i++)
+		{
+			Checksum += Graph.GetNextHop(i % NumLanes, (i / NumLanes) % NumLanes);
+		}
+		const double TableTime = FPlatformTime::Seconds() - Start;
+
+		Start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumQueries / 100; i++)
+		{
+			Checksum += Graph.BFS_FindPath(i % NumLanes, (i / NumLanes) % NumLanes).Num();
+		}
+		const double BFSTime = FPlatformTime::Seconds() - Start;
+		Sink += Checksum;
+
+		// Standing in the blocked middle lane of three: both sides are still reachable
+		FLaneGraph ThreeLanes;
+		ThreeLanes.Initialize({ -200.0f, 0.0f, 200.0f });
+		ThreeLanes.SetLaneBlocked(1, true);
+		const bool bLeavesBlockedLane = ThreeLanes.GetNextHop(1, 0) == 0 && ThreeLanes.GetNextHop(1, 2) == 2
+			&& ThreeLanes.GetDistance(0, 2) == INDEX_NONE;
+
+		UE_LOG(LogTemp, Warning, TEXT("Next hop: route table %.1f ns, BFS %.1f ns"),
+			TableTime * 1e9 / NumQueries, BFSTime * 1e9 / (NumQueries / 100));
+		UE_LOG(LogTemp, Warning, TEXT("%d mismatches, blocked current lane %s; %s"), Mismatches,
+			bLeavesBlockedLane ? TEXT("can be left") : TEXT("TRAPS THE RUNNER"),
+			Mismatches == 0 && bLeavesBlockedLane ? TEXT("results OK") : TEXT("ROUTES DIFFER"));
+	}
+
+	static FAutoConsoleCommand LaneGraphCommand(
+		TEXT("Runner.Bench.LaneGraph"),
+		TEXT("Lane graph route table checked against BFS under random changes, incl. a blocked current lane. Args: [NumChanges] [NumLanes]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&LaneGraph));
+}
+
+#endif // !UE_BUILD_SHIPPING
@@ -0,0 +1,80 @@
+// DeferredSpawnQueue.h - Priority Queue (Binary Min-Heap) for deferred spawning
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AFloorTile;
+
+/**
+ * What a deferred request spawns
+ */
+enum class EDeferredSpawnType : uint8
+{
+    Tile,   // Floor tile at a precomputed transform
+    Items   // Coins/obstacles for an already spawned tile
+};
+
+/**
+ * One unit of spawn work, drained by the GameMode under a per-frame budget
+ */
+struct FDeferredSpawnRequest
+{
+    EDeferredSpawnType Type;
+    FTransform Transform;               // Tile requests: where the tile goes
+    TWeakObjectPtr<AFloorTile> Tile;    // Item requests: tile to fill (may be gone by then)
+    float TrackDistance;                // Priority: nearest to the start of the track first
+    bool bSpawnItems;                   // Tile requests: queue items once the tile exists
+
+    FDeferredSpawnRequest()
+        : Type(EDeferredSpawnType::Tile), TrackDistance(0.0f), bSpawnItems(false) {}
+};
+
+/**
+ * Priority Queue of spawn requests ordered by track distance
+ * Uses a binary min-heap stored in a TArray
+ * Time Complexity: O(log n) push/pop, O(1) peek
+ */
+class FDeferredSpawnQueue
+{
+private:
+    TArray<FDeferredSpawnRequest> Heap;
+    int32 PeakDepth;
+
+    struct FNearestFirst
+    {
+        bool operator()(const FDeferredSpawnRequest& A, const FDeferredSpawnRequest& B) const
+        {
+            return A.TrackDistance < B.TrackDistance;
+        }
+    };
+
+public:
+    FDeferredSpawnQueue() : PeakDepth(0) {}
+
+    void Push(const FDeferredSpawnRequest& Request);
+    bool Pop(FDeferredSpawnRequest& OutRequest);
+    const FDeferredSpawnRequest* Peek() const { return Heap.Num() > 0 ? &Heap[0] : nullptr; }
+
+    // Utility
+    bool IsEmpty() const { return Heap.Num() == 0; }
+    int32 Num() const { return Heap.Num(); }
+    int32 GetPeakDepth() const { return PeakDepth; }
+    void Reset() { Heap.Reset(); }
+};
+
+// ===== IMPLEMENTATION =====
+
+inline void FDeferredSpawnQueue::Push(const FDeferredSpawnRequest& Request)
+{
+    Heap.HeapPush(Request, FNearestFirst());
+    PeakDepth = FMath::Max(PeakDepth, Heap.Num());
+}
+
+inline bool FDeferredSpawnQueue::Pop(FDeferredSpawnRequest& OutRequest)
+{
+    if (Heap.Num() == 0)
+        return false;
+
+    Heap.HeapPop(OutRequest, FNearestFirst(), EAllowShrinking::No);
+    return true;
+}
@@ -0,0 +1,102 @@
+// DifficultyCurves.cpp - Distance-based difficulty curves baked into lookup tables
+#include "DifficultyCurves.h"
+
+float FDifficultyCurve::Evaluate(float Distance, float DefaultValue) const
+{
+	if (Keys.Num() == 0)
+		return DefaultValue;
+
+	if (Distance <= Keys[0].Distance)
+		return Keys[0].Value;
+
+	for (int32 i = 1; i < Keys.Num(); i++)
+	{
+		if (Distance <= Keys[i].Distance)
+		{
+			const FDifficultyCurveKey& A = Keys[i - 1];
+			const FDifficultyCurveKey& B = Keys[i];
+			const float Span = B.Distance - A.Distance;
+			return Span > 0.0f ? FMath::Lerp(A.Value, B.Value, (Distance - A.Distance) / Span) : B.Value;
+		}
+	}
+	return Keys.Last().Value;
+}
+
+const FDifficultyPreset* FDifficultyConfig::FindPreset(const FString& Name) const
+{
+	return Presets.FindByPredicate([&Name](const FDifficultyPreset& Preset)
+	{
+		return Preset.Name.Equals(Name, ESearchCase::IgnoreCase);
+	});
+}
+
+void FDifficultyTables::Bake(const FDifficultyConfig& Config, const FDifficultyPreset& InPreset)
+{
+	// Keys may be authored in any order
+	FDifficultyPreset Preset = InPreset;
+	for (FDifficultyCurve* Curve : { &Preset.SpawnDensity, &Preset.ObstacleShare, &Preset.BigObstacleShare, &Preset.RunSpeed, &Preset.PatternTier })
+	{
+		Curve->Keys.Sort([](const FDifficultyCurveKey& A, const FDifficultyCurveKey& B) { return A.Distance < B.Distance; });
+	}
+
+	const float Step = FMath::Max(Config.TableStep, 1.0f);
+	const int32 NumEntries = FMath::Max(FMath::CeilToInt(Config.TableDistance / Step), 0) + 1;
+	InvStep = 1.0f / Step;
+
+	SpawnTables.Reset(NumEntries);
+	RunSpeeds.Reset(NumEntries);
+	PatternTiers.Reset(NumEntries);
+
+	for (int32 i = 0; i < NumEntries; i++)
+	{
+		const float Distance = i * Step;
+		const float Density = FMath::Clamp(Preset.SpawnDensity.Evaluate(Distance, 0.7f), 0.0f, 1.0f);
+		const float Obstacles = FMath::Clamp(Preset.ObstacleShare.Evaluate(Distance, 0.3f), 0.0f, 1.0f);
+		const float Big = FMath::Clamp(Preset.BigObstacleShare.Evaluate(Distance, 0.0f), 0.0f, 1.0f);
+
+		FSpawnLaneTable Table;
+		Table.Outcomes.Add(FSpawnOutcome(ESpawnItemKind::None, 1.0f - Density));
+		Table.Outcomes.Add(FSpawnOutcome(ESpawnItemKind::Coin, Density * (1.0f - Obstacles)));
+		Table.Outcomes.Add(FSpawnOutcome(ESpawnItemKind::SmallObstacle, Density * Obstacles * (1.0f - Big)));
+		Table.Outcomes.Add(FSpawnOutcome(ESpawnItemKind::BigObstacle, Density * Obstacles * Big));
+
+		SpawnTables.AddDefaulted_GetRef().Build(Table);
+		RunSpeeds.Add(Preset.RunSpeed.Evaluate(Distance, 0.0f));
+		PatternTiers.Add(static_cast<uint8>(FMath::Clamp(FMath::FloorToInt(Preset.PatternTier.Evaluate(Distance, 0.0f)), 0, MAX_uint8 - 1)));
+	}
+}
+
+void FDifficultyTables::Reset()
+{
+	SpawnTables.Reset();
+	RunSpeeds.Reset();
+	PatternTiers.Reset();
+	InvStep = 0.0f;
+}
+
+int32 FDifficultyTables::GetIndex(float Distance) const
+{
+	return FMath::Clamp(FMath::FloorToInt(Distance * InvStep), 0, SpawnTables.Num() - 1);
+}
+
+const FCompiledSpawnTable* FDifficultyTables::GetSpawnTable(float Distance) const
+{
+	return IsBaked() ? &SpawnTables[GetIndex(Distance)] : nullptr;
+}
+
+int32 FDifficultyTables::GetPatternTier(float Distance) const
+{
+	return IsBaked() ? PatternTiers[GetIndex(Distance)] : 0;
+}
+
+float FDifficultyTables::GetRunSpeed(float Distance) const
+{
+	if (!IsBaked())
+		return 0.0f;
+
+	// Blend neighbouring entries so speed changes smoothly between steps
+	const float Position = FMath::Max(Distance * InvStep, 0.0f);
+	const int32 Index = FMath::Min(FMath::FloorToInt(Position), RunSpeeds.Num() - 1);
+	const int32 NextIndex = FMath::Min(Index + 1, RunSpeeds.Num() - 1);
+	return FMath::Lerp(RunSpeeds[Index], RunSpeeds[NextIndex], FMath::Min(Position - Index, 1.0f));
+}
@@ -0,0 +1,120 @@
+// DifficultyCurves.h - Distance-based difficulty curves baked into lookup tables
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SpawnTables.h"
+#include "DifficultyCurves.generated.h"
+
+/**
+ * One key of a piecewise-linear curve over track distance
+ */
+USTRUCT(BlueprintType)
+struct FDifficultyCurveKey
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Difficulty")
+	float Distance = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Difficulty")
+	float Value = 0.0f;
+};
+
+/**
+ * Piecewise-linear curve, clamped to the first/last key outside its range
+ */
+USTRUCT(BlueprintType)
+struct FDifficultyCurve
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Difficulty")
+	TArray<FDifficultyCurveKey> Keys;
+
+	// O(k) - only used while baking, never per tile
+	float Evaluate(float Distance, float DefaultValue) const;
+};
+
+/**
+ * Everything one difficulty level (Easy / Medium / Hard) changes over distance
+ */
+USTRUCT(BlueprintType)
+struct FDifficultyPreset
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Difficulty")
+	FString Name;
+
+	// Chance a lane gets anything at all
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Difficulty")
+	FDifficultyCurve SpawnDensity;
+
+	// Fraction of spawned items that are obstacles (the rest are coins)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Difficulty")
+	FDifficultyCurve ObstacleShare;
+
+	// Fraction of obstacles that are big
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Difficulty")
+	FDifficultyCurve BigObstacleShare;
+
+	// Runner MaxWalkSpeed
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Difficulty")
+	FDifficultyCurve RunSpeed;
+
+	// Track pattern difficulty tier (FTrackPatternRow::Difficulty), rounded down;
+	// tiers past the library's hardest use the hardest
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Difficulty")
+	FDifficultyCurve PatternTier;
+};
+
+/**
+ * Root of the difficulty config file (Content/Tuning/Difficulty.json)
+ */
+USTRUCT(BlueprintType)
+struct FDifficultyConfig
+{
+	GENERATED_BODY()
+
+	// Track distance covered by one lookup table entry
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Difficulty", meta = (ClampMin = "1.0"))
+	float TableStep = 100.0f;
+
+	// Distance the tables cover; further along, the last entry is used
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Difficulty", meta = (ClampMin = "1.0"))
+	float TableDistance = 100000.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Difficulty")
+	TArray<FDifficultyPreset> Presets;
+
+	const FDifficultyPreset* FindPreset(const FString& Name) const;
+};
+
+/**
+ * Lookup tables baked from one preset
+ * Per-tile spawn table, pattern tier and per-frame run speed are a single index computation
+ * Time Complexity: O(n * k) bake, O(1) lookup
+ */
+class FDifficultyTables
+{
+private:
+	float InvStep;
+	TArray<FCompiledSpawnTable> SpawnTables;    // Alias table per distance step
+	TArray<float> RunSpeeds;
+	TArray<uint8> PatternTiers;
+
+public:
+	FDifficultyTables() : InvStep(0.0f) {}
+
+	void Bake(const FDifficultyConfig& Config, const FDifficultyPreset& Preset);
+	void Reset();
+	bool IsBaked() const { return SpawnTables.Num() > 0; }
+
+	// O(1)
+	const FCompiledSpawnTable* GetSpawnTable(float Distance) const;
+	float GetRunSpeed(float Distance) const;
+	int32 GetPatternTier(float Distance) const;
+
+private:
+	int32 GetIndex(float Distance) const;
+};
@@ -57,8 +57,8 @@ void AFloorTile::OnTriggerOverlap(UPrimitiveComponent* OverlappedComponent, AAct
 	// Check if player overlapped with this tile
 	if (ARunCharacter* RunCharacter = Cast<ARunCharacter>(OtherActor))
 	{
-		// Tell GameMode to spawn next tile (using Queue)
-		GameMode->AddFloorTile(true);
+		// Tell GameMode to spawn next tile (deferred out of the overlap callback)
+		GameMode->QueueFloorTile(true);
 
 		// Set timer to destroy this tile after delay
 		GetWorldTimerManager().SetTimer(DestroyHandle, this, &AFloorTile::DestroyFloorTile, DestroyAfterTime, false);
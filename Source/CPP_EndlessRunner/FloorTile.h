@@ -108,6 +108,11 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Floor Tile")
 	UArrowComponent* GetAttachPointComponent() const { return AttachPoint; }
 
+	// SPAWN THRESHOLDS - Default spawn table when GameMode has none configured
+	float GetSpawnPercent1() const { return SpawnPercent1; }
+	float GetSpawnPercent2() const { return SpawnPercent2; }
+	float GetSpawnPercent3() const { return SpawnPercent3; }
+
 	// POOLED ACTORS ACCESS - For GameMode to manage pooled objects
 	UFUNCTION(BlueprintCallable, Category = "Floor Tile")
 	const TArray<AActor*>& GetPooledActors() const { return PooledActors; }
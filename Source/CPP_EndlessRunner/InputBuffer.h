@@ -0,0 +1,88 @@
+// InputBuffer.h - Timestamped player commands held until a frame can apply them
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Commands in press order, each kept until it is applied or goes stale
+ * A command the game can't act on yet (a jump pressed just before landing)
+ * waits instead of being lost, but only for MaxAge seconds, so it never
+ * fires long after the player meant it
+ * Fixed-capacity ring: when full, the oldest command makes room
+ * Time Complexity: O(1) push, O(Capacity) per apply pass
+ */
+template<typename CommandType, int32 Capacity = 8>
+class TInputBuffer
+{
+    static_assert(Capacity > 0, "The buffer needs room for at least one command");
+
+public:
+    struct FEntry
+    {
+        CommandType Command;
+        double PressTime;   // Seconds, on the owner's clock
+        uint64 PressFrame;  // GFrameCounter
+    };
+
+private:
+    FEntry Entries[Capacity];
+    int32 Head;   // Oldest
+    int32 Count;
+    double MaxAge;
+
+public:
+    explicit TInputBuffer(double InMaxAge = 0.2) : Head(0), Count(0), MaxAge(InMaxAge) {}
+
+    // Returns false if the oldest command had to be dropped to make room (copied to OutDropped)
+    bool Push(CommandType Command, double PressTime, uint64 PressFrame, FEntry* OutDropped = nullptr)
+    {
+        const bool bHadRoom = Count < Capacity;
+        if (!bHadRoom)
+        {
+            if (OutDropped)
+            {
+                *OutDropped = Entries[Head];
+            }
+            Head = (Head + 1) % Capacity;
+            Count--;
+        }
+
+        Entries[(Head + Count) % Capacity] = { Command, PressTime, PressFrame };
+        Count++;
+        return bHadRoom;
+    }
+
+    // Offers each command to TryApply(const FEntry&) -> bool, oldest first.
+    // Applied and stale (OnExpired(const FEntry&)) commands leave the buffer;
+    // the rest stay, in order. Returns the number applied
+    template<typename ApplyFuncType, typename ExpiredFuncType>
+    int32 Apply(double Now, ApplyFuncType&& TryApply, ExpiredFuncType&& OnExpired)
+    {
+        int32 NumApplied = 0;
+        int32 NumKept = 0;
+        for (int32 i = 0; i < Count; i++)
+        {
+            const FEntry Entry = Entries[(Head + i) % Capacity];
+            if (Now - Entry.PressTime > MaxAge)
+            {
+                OnExpired(Entry);
+            }
+            else if (TryApply(Entry))
+            {
+                NumApplied++;
+            }
+            else
+            {
+                Entries[(Head + NumKept++) % Capacity] = Entry;
+            }
+        }
+        Count = NumKept;
+        return NumApplied;
+    }
+
+    void SetMaxAge(double InMaxAge) { MaxAge = InMaxAge; }
+    void Reset() { Head = 0; Count = 0; }
+
+    int32 Num() const { return Count; }
+    bool IsEmpty() const { return Count == 0; }
+};
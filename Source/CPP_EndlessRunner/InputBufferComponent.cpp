@@ -0,0 +1,148 @@
+// InputBufferComponent.cpp - Buffered lane/jump commands and press-to-motion latency
+#include "InputBufferComponent.h"
+#include "CPP_EndlessRunner.h"
+#include "GameFramework/Actor.h"
+#include "Misc/App.h"
+
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Input Latency Lane (ms)"), STAT_RunnerInputLatencyLaneMs, STATGROUP_Runner);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Input Latency Jump (ms)"), STAT_RunnerInputLatencyJumpMs, STATGROUP_Runner);
+
+// Wall clock normally; under a fixed time step the game clock, so buffering and
+// latency follow simulated time however fast the frames actually run
+static double GetInputClock()
+{
+	return FApp::UseFixedTimeStep() ? FApp::GetCurrentTime() : FPlatformTime::Seconds();
+}
+
+UInputBufferComponent::UInputBufferComponent()
+{
+	// Measures after movement has run for the frame; ticks only while a measurement is open
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PostPhysics;
+
+	LatencyStats.SetNum(static_cast<int32>(ERunnerInput::Count));
+}
+
+void UInputBufferComponent::Press(ERunnerInput Input)
+{
+	LatencyStats[static_cast<int32>(Input)].NumPresses++;
+
+	Buffer.SetMaxAge(BufferSeconds);
+	TInputBuffer<ERunnerInput>::FEntry Dropped;
+	if (!Buffer.Push(Input, GetInputClock(), GFrameCounter, &Dropped))
+	{
+		LatencyStats[static_cast<int32>(Dropped.Command)].NumDropped++;
+	}
+	ApplyBuffered();
+}
+
+void UInputBufferComponent::ApplyBuffered()
+{
+	if (Buffer.IsEmpty())
+		return;
+
+	Buffer.Apply(GetInputClock(),
+		[this](const TInputBuffer<ERunnerInput>::FEntry& Entry) { return TryApply(Entry); },
+		[this](const TInputBuffer<ERunnerInput>::FEntry& Entry) { LatencyStats[static_cast<int32>(Entry.Command)].NumDropped++; });
+}
+
+bool UInputBufferComponent::TryApply(const TInputBuffer<ERunnerInput>::FEntry& Entry)
+{
+	FVector Direction = FVector::ZeroVector;
+	if (!TryApplyInput.IsBound() || !TryApplyInput.Execute(Entry.Command, Direction))
+		return false;
+
+	if (Entry.PressFrame != GFrameCounter)
+	{
+		LatencyStats[static_cast<int32>(Entry.Command)].NumBuffered++;
+	}
+
+	if (!Direction.IsNearlyZero())
+	{
+		OpenMeasurements.Add({ Entry.Command, Entry.PressTime, Entry.PressFrame, GetOwner()->GetActorLocation(), Direction.GetSafeNormal() });
+		SetComponentTickEnabled(true);
+	}
+	return true;
+}
+
+void UInputBufferComponent::ResetBuffer()
+{
+	Buffer.Reset();
+	OpenMeasurements.Reset();
+	SetComponentTickEnabled(false);
+}
+
+void UInputBufferComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	const double Now = GetInputClock();
+	const FVector Location = GetOwner()->GetActorLocation();
+
+	for (int32 i = OpenMeasurements.Num() - 1; i >= 0; i--)
+	{
+		const FOpenMeasurement& Measurement = OpenMeasurements[i];
+		const float Moved = FVector::DotProduct(Location - Measurement.StartLocation, Measurement.Direction);
+		if (Moved >= MotionThreshold)
+		{
+			RecordLatency(Measurement, Now);
+			OpenMeasurements.RemoveAtSwap(i);
+		}
+		else if (Now - Measurement.PressTime > MeasureTimeoutSeconds)
+		{
+			OpenMeasurements.RemoveAtSwap(i);
+		}
+	}
+
+	if (OpenMeasurements.Num() == 0)
+	{
+		SetComponentTickEnabled(false);
+	}
+}
+
+void UInputBufferComponent::RecordLatency(const FOpenMeasurement& Measurement, double Now)
+{
+	const float LatencyMs = static_cast<float>((Now - Measurement.PressTime) * 1000.0);
+	const int32 LatencyFrames = static_cast<int32>(GFrameCounter - Measurement.PressFrame) + 1;
+
+	FInputLatencyStats& Stats = LatencyStats[static_cast<int32>(Measurement.Input)];
+	Stats.NumMeasured++;
+	Stats.TotalMs += LatencyMs;
+	Stats.MaxMs = FMath::Max(Stats.MaxMs, LatencyMs);
+	Stats.TotalFrames += LatencyFrames;
+	Stats.MaxFrames = FMath::Max(Stats.MaxFrames, LatencyFrames);
+
+	if (Measurement.Input == ERunnerInput::Jump)
+	{
+		SET_FLOAT_STAT(STAT_RunnerInputLatencyJumpMs, LatencyMs);
+	}
+	else
+	{
+		SET_FLOAT_STAT(STAT_RunnerInputLatencyLaneMs, LatencyMs);
+	}
+}
+
+FInputLatencyStats UInputBufferComponent::GetLatencyStats(ERunnerInput Input) const
+{
+	return LatencyStats.IsValidIndex(static_cast<int32>(Input)) ? LatencyStats[static_cast<int32>(Input)] : FInputLatencyStats();
+}
+
+void UInputBufferComponent::LogLatencySummary() const
+{
+	static const TCHAR* InputNames[] = { TEXT("MoveLeft"), TEXT("MoveRight"), TEXT("Jump") };
+	static_assert(UE_ARRAY_COUNT(InputNames) == static_cast<int32>(ERunnerInput::Count), "One name per input");
+
+	UE_LOG(LogTemp, Warning, TEXT("=== PRESS-TO-MOTION LATENCY ==="));
+	for (int32 i = 0; i < LatencyStats.Num(); i++)
+	{
+		const FInputLatencyStats& Stats = LatencyStats[i];
+		if (Stats.NumPresses == 0)
+			continue;
+
+		const int32 Measured = FMath::Max(Stats.NumMeasured, 1);
+		UE_LOG(LogTemp, Warning, TEXT("%-9s: %d presses (%d buffered, %d dropped), avg %.1f ms / %.2f frames, max %.1f ms / %d frames"),
+			InputNames[i], Stats.NumPresses, Stats.NumBuffered, Stats.NumDropped,
+			Stats.TotalMs / Measured, static_cast<float>(Stats.TotalFrames) / Measured, Stats.MaxMs, Stats.MaxFrames);
+	}
+}
@@ -0,0 +1,127 @@
+// InputBufferComponent.h - Buffered lane/jump commands and press-to-motion latency
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "InputBuffer.h"
+#include "InputBufferComponent.generated.h"
+
+UENUM(BlueprintType)
+enum class ERunnerInput : uint8
+{
+	MoveLeft,
+	MoveRight,
+	Jump,
+	Count UMETA(Hidden)
+};
+
+// Applies a command now if the game can; sets the direction the owner should start moving in
+// (zero if no motion is expected, e.g. already in the outermost lane)
+DECLARE_DELEGATE_RetVal_TwoParams(bool, FTryApplyRunnerInput, ERunnerInput, FVector& /* OutMotionDirection */);
+
+/**
+ * Press-to-motion latency of one kind of command
+ * Measured from the input event to the end of the first game frame in
+ * which the owner has moved the expected way; rendering and display
+ * latency after that frame is not included
+ */
+USTRUCT(BlueprintType)
+struct FInputLatencyStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Input")
+	int32 NumPresses = 0;
+
+	// Applied on a later frame than the press
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Input")
+	int32 NumBuffered = 0;
+
+	// Never became valid within the buffer window, or pushed out by newer presses
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Input")
+	int32 NumDropped = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Input")
+	int32 NumMeasured = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Input")
+	float TotalMs = 0.0f;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Input")
+	float MaxMs = 0.0f;
+
+	// Frames counted from the one that received the press, inclusive
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Input")
+	int32 TotalFrames = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Input")
+	int32 MaxFrames = 0;
+};
+
+/**
+ * Queues the owner's lane and jump commands with their press time and
+ * frame, and applies each at the earliest frame the owner accepts it
+ * (through TryApplyInput): straight away when possible, otherwise on a
+ * later frame within BufferSeconds
+ * Every applied command is then watched after physics until the owner
+ * visibly moves, giving press-to-motion latency in milliseconds and frames
+ * per command type. Only ticks while a measurement is open
+ */
+UCLASS(ClassGroup = (Runner), meta = (BlueprintSpawnableComponent))
+class CPP_ENDLESSRUNNER_API UInputBufferComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UInputBufferComponent();
+
+	// How long a command may wait for a frame that can apply it
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input", meta = (ClampMin = "0.0"))
+	float BufferSeconds = 0.2f;
+
+	// Movement along the expected direction that counts as visible (cm)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input", meta = (ClampMin = "0.01"))
+	float MotionThreshold = 1.0f;
+
+	// Measurements with no motion after this long are abandoned
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input", meta = (ClampMin = "0.01"))
+	float MeasureTimeoutSeconds = 1.0f;
+
+	// Bound by the owner
+	FTryApplyRunnerInput TryApplyInput;
+
+	// Records a press and applies it if the owner can take it this frame
+	void Press(ERunnerInput Input);
+
+	// Retries waiting commands; call once per frame before movement
+	void ApplyBuffered();
+
+	// Drops waiting commands and open measurements (e.g. on death)
+	void ResetBuffer();
+
+	UFUNCTION(BlueprintCallable, Category = "Input")
+	FInputLatencyStats GetLatencyStats(ERunnerInput Input) const;
+
+	void LogLatencySummary() const;
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+private:
+	struct FOpenMeasurement
+	{
+		ERunnerInput Input;
+		double PressTime;
+		uint64 PressFrame;
+		FVector StartLocation;
+		FVector Direction;
+	};
+
+	TInputBuffer<ERunnerInput> Buffer;
+	TArray<FOpenMeasurement, TInlineAllocator<4>> OpenMeasurements;
+
+	UPROPERTY(VisibleInstanceOnly, Category = "Input")
+	TArray<FInputLatencyStats> LatencyStats;
+
+	bool TryApply(const TInputBuffer<ERunnerInput>::FEntry& Entry);
+	void RecordLatency(const FOpenMeasurement& Measurement, double Now);
+};
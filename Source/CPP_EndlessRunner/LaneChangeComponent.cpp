@@ -0,0 +1,125 @@
+// LaneChangeComponent.cpp - Eased lane changes driven natively through the movement component
+#include "LaneChangeComponent.h"
+#include "CPP_EndlessRunner.h"
+#include "GameFramework/MovementComponent.h"
+#include "GameFramework/Actor.h"
+
+DECLARE_CYCLE_STAT(TEXT("Lane Change Tick"), STAT_RunnerLaneChangeTick, STATGROUP_Runner);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Lane Change Time (us)"), STAT_RunnerLaneChangeUs, STATGROUP_Runner);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Lane Changes"), STAT_RunnerLaneChanges, STATGROUP_Runner);
+
+ULaneChangeComponent::ULaneChangeComponent()
+{
+	// Ticks only while a change is in progress
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PrePhysics;
+}
+
+void ULaneChangeComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	Movement = GetOwner()->FindComponentByClass<UMovementComponent>();
+	if (!Movement)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("LaneChangeComponent: %s has no movement component; lane changes are ignored"), *GetOwner()->GetName());
+	}
+}
+
+void ULaneChangeComponent::MoveToLane(int32 Lane, float LaneY)
+{
+	if (!Movement || !Movement->UpdatedComponent)
+		return;
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	const float CurrentY = Movement->UpdatedComponent->GetComponentLocation().Y;
+	const float Distance = FMath::Abs(LaneY - CurrentY);
+
+	if (bChangingLane)
+	{
+		if (Lane == TargetLane)
+			return;
+
+		// Turning back or pressing on: cover what is left at the same pace
+		Stats.NumInterrupted++;
+		Duration = LaneWidth > KINDA_SMALL_NUMBER
+			? LaneChangeDuration * FMath::Clamp(Distance / LaneWidth, 0.1f, 2.0f)
+			: LaneChangeDuration;
+	}
+	else
+	{
+		// Already there (e.g. pushing against the outermost lane)
+		if (Distance <= KINDA_SMALL_NUMBER)
+			return;
+
+		LaneWidth = Distance;
+		Duration = LaneChangeDuration;
+		ChangeCycles = 0;
+	}
+
+	TargetLane = Lane;
+	StartY = CurrentY;
+	TargetY = LaneY;
+	Elapsed = 0.0f;
+	bChangingLane = true;
+	SetComponentTickEnabled(true);
+
+	ChangeCycles += FPlatformTime::Cycles64() - StartCycles;
+}
+
+void ULaneChangeComponent::ResetLane(int32 Lane)
+{
+	TargetLane = Lane;
+	bChangingLane = false;
+	SetComponentTickEnabled(false);
+}
+
+void ULaneChangeComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (!bChangingLane || !Movement || !Movement->UpdatedComponent)
+		return;
+
+	SCOPE_CYCLE_COUNTER(STAT_RunnerLaneChangeTick);
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	Elapsed += DeltaTime;
+	const float Alpha = FMath::Clamp(Elapsed / Duration, 0.0f, 1.0f);
+	const float DesiredY = UKismetMathLibrary::Ease(StartY, TargetY, Alpha, Easing, BlendExponent);
+
+	// Sideways step only; forward motion stays with the movement mode
+	USceneComponent* Updated = Movement->UpdatedComponent;
+	const FVector Delta(0.0f, DesiredY - Updated->GetComponentLocation().Y, 0.0f);
+	if (!Delta.IsNearlyZero())
+	{
+		FHitResult Hit;
+		Movement->SafeMoveUpdatedComponent(Delta, Updated->GetComponentQuat(), true, Hit);
+	}
+
+	ChangeCycles += FPlatformTime::Cycles64() - StartCycles;
+
+	if (Alpha >= 1.0f)
+	{
+		FinishChange();
+	}
+}
+
+void ULaneChangeComponent::FinishChange()
+{
+	bChangingLane = false;
+	SetComponentTickEnabled(false);
+
+	const float ChangeUs = static_cast<float>(FPlatformTime::ToMilliseconds64(ChangeCycles) * 1000.0);
+	Stats.NumChanges++;
+	Stats.LastChangeUs = ChangeUs;
+	Stats.MaxChangeUs = FMath::Max(Stats.MaxChangeUs, ChangeUs);
+	Stats.TotalChangeUs += ChangeUs;
+
+	SET_FLOAT_STAT(STAT_RunnerLaneChangeUs, ChangeUs);
+	SET_DWORD_STAT(STAT_RunnerLaneChanges, Stats.NumChanges);
+
+	OnLaneReached.Broadcast(TargetLane);
+}
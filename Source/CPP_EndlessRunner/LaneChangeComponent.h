@@ -0,0 +1,112 @@
+// LaneChangeComponent.h - Eased lane changes driven natively through the movement component
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "LaneChangeComponent.generated.h"
+
+class UMovementComponent;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnLaneReached, int32 /* Lane */);
+
+/**
+ * Game-thread cost of lane changes, from the request to the last eased step
+ * Also visible in-game with "stat Runner"
+ */
+USTRUCT(BlueprintType)
+struct FLaneChangeStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Lane")
+	int32 NumChanges = 0;
+
+	// Changes redirected to another lane before they arrived
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Lane")
+	int32 NumInterrupted = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Lane")
+	float LastChangeUs = 0.0f;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Lane")
+	float MaxChangeUs = 0.0f;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Lane")
+	float TotalChangeUs = 0.0f;
+};
+
+/**
+ * Moves its owner sideways to a lane along an easing curve
+ * Each tick sweeps the owner's updated component by the eased step through
+ * its movement component (the same path walking uses), so there is no
+ * Blueprint timeline and no teleport per frame, and side hits register
+ * A new target mid-move starts from wherever the owner is, taking a share
+ * of the duration in proportion to the distance left to cover
+ * Only ticks while a change is in progress
+ */
+UCLASS(ClassGroup = (Runner), meta = (BlueprintSpawnableComponent))
+class CPP_ENDLESSRUNNER_API ULaneChangeComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	ULaneChangeComponent();
+
+	// Seconds for a one-lane change
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lane", meta = (ClampMin = "0.01"))
+	float LaneChangeDuration = 0.2f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lane")
+	TEnumAsByte<EEasingFunc::Type> Easing = EEasingFunc::EaseInOut;
+
+	// Curve exponent for the EaseIn/EaseOut/EaseInOut functions
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lane", meta = (ClampMin = "1.0"))
+	float BlendExponent = 2.0f;
+
+	// Broadcast when the owner arrives in its target lane
+	FOnLaneReached OnLaneReached;
+
+	// Starts moving to Lane, whose centre is at world Y = LaneY; redirects a change in progress
+	void MoveToLane(int32 Lane, float LaneY);
+
+	// Drops any change in progress without moving (e.g. on respawn)
+	void ResetLane(int32 Lane);
+
+	UFUNCTION(BlueprintCallable, Category = "Lane")
+	bool IsChangingLane() const { return bChangingLane; }
+
+	UFUNCTION(BlueprintCallable, Category = "Lane")
+	int32 GetTargetLane() const { return TargetLane; }
+
+	UFUNCTION(BlueprintCallable, Category = "Lane")
+	FLaneChangeStats GetLaneChangeStats() const { return Stats; }
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+protected:
+	virtual void BeginPlay() override;
+
+private:
+	UPROPERTY()
+	UMovementComponent* Movement = nullptr;
+
+	UPROPERTY(VisibleInstanceOnly, Category = "Lane")
+	FLaneChangeStats Stats;
+
+	int32 TargetLane = 1;
+	float StartY = 0.0f;
+	float TargetY = 0.0f;
+	float Elapsed = 0.0f;
+	float Duration = 0.0f;
+
+	// Width of the last change started from rest, for scaling redirected ones
+	float LaneWidth = 0.0f;
+
+	bool bChangingLane = false;
+
+	// Game-thread cycles spent on the current change so far
+	uint64 ChangeCycles = 0;
+
+	void FinishChange();
+};
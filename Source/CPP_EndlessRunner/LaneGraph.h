@@ -22,6 +22,13 @@ struct FLaneNode
  * Uses Adjacency List representation
  * Implements BFS and DFS for pathfinding
  * Time Complexity: O(V + E) for traversal algorithms
+ *
+ * Also keeps an all-pairs route table (distance + next hop) so routing
+ * queries are O(1) lookups. The table is patched incrementally whenever an
+ * edge or a lane's blocked state changes instead of re-running BFS per query.
+ *
+ * Blocked lanes are never entered, but a route may always leave its start
+ * lane: a runner whose own lane is blocked still gets a way out.
  */
 class FLaneGraph
 {
@@ -30,6 +37,11 @@ private:
     TMap<int32, FLaneNode> Nodes;
     int32 NumLanes;
 
+    // All-pairs route table, row-major [From * NumLanes + To]
+    // Distance is INDEX_NONE when To is unreachable from From
+    TArray<int32> RouteDistance;
+    TArray<int32> RouteNextHop;
+
 public:
     FLaneGraph();
     
@@ -49,6 +61,10 @@ public:
     
     // Shortest path (for AI or optimal lane selection)
     TArray<int32> FindShortestPath(int32 StartLane, int32 TargetLane) const;
+
+    // Route table queries - O(1)
+    int32 GetNextHop(int32 StartLane, int32 TargetLane) const;
+    int32 GetDistance(int32 StartLane, int32 TargetLane) const;
     
     // Utility
     int32 GetNumLanes() const { return NumLanes; }
@@ -58,6 +74,12 @@ public:
 private:
     // Helper functions for traversal
     bool DFS_Recursive(int32 Current, int32 Target, TSet<int32>& Visited, TArray<int32>& Path) const;
+
+    // Route table maintenance
+    void ResetRouteTable();
+    void RebuildRouteRow(int32 FromLane);
+    void RelaxEdge(int32 FromLane, int32 ToLane);
+    int32 RouteIndex(int32 FromLane, int32 ToLane) const { return FromLane * NumLanes + ToLane; }
 };
 
 // ===== IMPLEMENTATION =====
@@ -67,6 +89,7 @@ inline FLaneGraph::FLaneGraph() : NumLanes(0) {}
 inline void FLaneGraph::Initialize(const TArray<float>& LanePositions)
 {
     NumLanes = LanePositions.Num();
+    Nodes.Empty(NumLanes);
     
     // Create nodes (vertices)
     for (int32 i = 0; i < NumLanes; i++)
@@ -74,6 +97,9 @@ inline void FLaneGraph::Initialize(const TArray<float>& LanePositions)
         FLaneNode Node(i, LanePositions[i]);
         Nodes.Add(i, Node);
     }
+
+    // No edges yet: every lane only reaches itself
+    ResetRouteTable();
     
     // Create edges (adjacent lanes can connect)
     // Left <-> Center <-> Right
@@ -93,26 +119,65 @@ inline void FLaneGraph::AddEdge(int32 FromLane, int32 ToLane)
 {
     if (FLaneNode* Node = Nodes.Find(FromLane))
     {
-        if (!Node->Neighbors.Contains(ToLane))
+        if (!Node->Neighbors.Contains(ToLane) && IsValidLane(ToLane))
         {
             Node->Neighbors.Add(ToLane);
+
+            // A new edge can only shorten routes
+            RelaxEdge(FromLane, ToLane);
         }
     }
 }
 
 inline void FLaneGraph::RemoveEdge(int32 FromLane, int32 ToLane)
 {
-    if (FLaneNode* Node = Nodes.Find(FromLane))
+    FLaneNode* Node = Nodes.Find(FromLane);
+    if (!Node || Node->Neighbors.Remove(ToLane) == 0)
+        return;
+
+    // Only rows whose shortest paths could have used this edge need BFS again
+    for (int32 From = 0; From < NumLanes; From++)
     {
-        Node->Neighbors.Remove(ToLane);
+        const int32 ToEdgeStart = RouteDistance[RouteIndex(From, FromLane)];
+        const int32 ToEdgeEnd = RouteDistance[RouteIndex(From, ToLane)];
+        if (ToEdgeStart != INDEX_NONE && ToEdgeEnd == ToEdgeStart + 1)
+        {
+            RebuildRouteRow(From);
+        }
     }
 }
 
 inline void FLaneGraph::SetLaneBlocked(int32 LaneID, bool bBlocked)
 {
-    if (FLaneNode* Node = Nodes.Find(LaneID))
+    FLaneNode* Node = Nodes.Find(LaneID);
+    if (!Node || Node->bIsBlocked == bBlocked)
+        return;
+
+    Node->bIsBlocked = bBlocked;
+
+    if (bBlocked)
     {
-        Node->bIsBlocked = bBlocked;
+        // Routes can only get longer: redo rows that could reach this lane
+        // (its own row is unaffected, a route may always leave its start)
+        for (int32 From = 0; From < NumLanes; From++)
+        {
+            if (From != LaneID && RouteDistance[RouteIndex(From, LaneID)] != INDEX_NONE)
+            {
+                RebuildRouteRow(From);
+            }
+        }
+    }
+    else
+    {
+        // Routes can only get shorter: relax edges into the lane so every
+        // row can pass through it (its own row already leaves it)
+        for (const TPair<int32, FLaneNode>& Pair : Nodes)
+        {
+            if (Pair.Key != LaneID && Pair.Value.Neighbors.Contains(LaneID))
+            {
+                RelaxEdge(Pair.Key, LaneID);
+            }
+        }
     }
 }
 
@@ -178,8 +243,9 @@ inline TArray<int32> FLaneGraph::BFS_FindPath(int32 StartLane, int32 TargetLane)
             break;
         }
         
+        // The start lane is left even when blocked
         const FLaneNode* CurrentNode = Nodes.Find(Current);
-        if (!CurrentNode || CurrentNode->bIsBlocked)
+        if (!CurrentNode || (CurrentNode->bIsBlocked && Current != StartLane))
             continue;
         
         // Explore neighbors
@@ -225,7 +291,8 @@ inline TArray<int32> FLaneGraph::DFS_FindPath(int32 StartLane, int32 TargetLane)
 
 inline bool FLaneGraph::DFS_Recursive(int32 Current, int32 Target, TSet<int32>& Visited, TArray<int32>& Path) const
 {
-    if (!IsValidLane(Current) || IsLaneBlocked(Current))
+    // The start lane (empty path so far) is left even when blocked
+    if (!IsValidLane(Current) || (IsLaneBlocked(Current) && Path.Num() > 0))
         return false;
     
     Visited.Add(Current);
@@ -253,6 +320,115 @@ inline bool FLaneGraph::DFS_Recursive(int32 Current, int32 Target, TSet<int32>&
 
 inline TArray<int32> FLaneGraph::FindShortestPath(int32 StartLane, int32 TargetLane) const
 {
-    // BFS always finds shortest path in unweighted graph
-    return BFS_FindPath(StartLane, TargetLane);
+    // Walk the route table instead of running BFS: O(path length)
+    TArray<int32> Path;
+    if (GetDistance(StartLane, TargetLane) == INDEX_NONE)
+        return Path;
+
+    int32 Current = StartLane;
+    Path.Add(Current);
+    while (Current != TargetLane)
+    {
+        Current = RouteNextHop[RouteIndex(Current, TargetLane)];
+        Path.Add(Current);
+    }
+    return Path;
+}
+
+// Next lane to move into on the way to TargetLane - O(1)
+// Returns StartLane when already there or when TargetLane is unreachable
+// (a blocked StartLane does not make anything unreachable)
+inline int32 FLaneGraph::GetNextHop(int32 StartLane, int32 TargetLane) const
+{
+    if (GetDistance(StartLane, TargetLane) == INDEX_NONE)
+        return StartLane;
+
+    return RouteNextHop[RouteIndex(StartLane, TargetLane)];
+}
+
+// Number of lane changes between two lanes - O(1), INDEX_NONE if unreachable
+inline int32 FLaneGraph::GetDistance(int32 StartLane, int32 TargetLane) const
+{
+    if (!IsValidLane(StartLane) || !IsValidLane(TargetLane))
+        return INDEX_NONE;
+
+    return RouteDistance[RouteIndex(StartLane, TargetLane)];
+}
+
+inline void FLaneGraph::ResetRouteTable()
+{
+    RouteDistance.Init(INDEX_NONE, NumLanes * NumLanes);
+    RouteNextHop.Init(INDEX_NONE, NumLanes * NumLanes);
+
+    for (int32 Lane = 0; Lane < NumLanes; Lane++)
+    {
+        RouteDistance[RouteIndex(Lane, Lane)] = 0;
+        RouteNextHop[RouteIndex(Lane, Lane)] = Lane;
+    }
+}
+
+// Recompute one row of the table with BFS - O(V + E)
+// Same rules as BFS_FindPath: blocked lanes are never entered, FromLane is always left
+inline void FLaneGraph::RebuildRouteRow(int32 FromLane)
+{
+    for (int32 To = 0; To < NumLanes; To++)
+    {
+        RouteDistance[RouteIndex(FromLane, To)] = INDEX_NONE;
+        RouteNextHop[RouteIndex(FromLane, To)] = INDEX_NONE;
+    }
+    RouteDistance[RouteIndex(FromLane, FromLane)] = 0;
+    RouteNextHop[RouteIndex(FromLane, FromLane)] = FromLane;
+
+    TArray<int32> Frontier;
+    Frontier.Reserve(NumLanes);
+    Frontier.Add(FromLane);
+
+    for (int32 Head = 0; Head < Frontier.Num(); Head++)
+    {
+        const int32 Current = Frontier[Head];
+        const int32 CurrentDistance = RouteDistance[RouteIndex(FromLane, Current)];
+
+        for (int32 Neighbor : Nodes[Current].Neighbors)
+        {
+            const int32 Index = RouteIndex(FromLane, Neighbor);
+            if (RouteDistance[Index] != INDEX_NONE || IsLaneBlocked(Neighbor))
+                continue;
+
+            RouteDistance[Index] = CurrentDistance + 1;
+            // First step out of FromLane is inherited by everything behind it
+            RouteNextHop[Index] = (Current == FromLane) ? Neighbor : RouteNextHop[RouteIndex(FromLane, Current)];
+            Frontier.Add(Neighbor);
+        }
+    }
+}
+
+// Apply a newly usable edge to every pair - O(V^2)
+// d(s,t) = min(d(s,t), d(s,From) + 1 + d(To,t))
+// A blocked FromLane is only reachable from its own row, so only that row uses the edge
+inline void FLaneGraph::RelaxEdge(int32 FromLane, int32 ToLane)
+{
+    if (IsLaneBlocked(ToLane))
+        return;
+
+    for (int32 From = 0; From < NumLanes; From++)
+    {
+        const int32 ToEdgeStart = RouteDistance[RouteIndex(From, FromLane)];
+        if (ToEdgeStart == INDEX_NONE)
+            continue;
+
+        for (int32 To = 0; To < NumLanes; To++)
+        {
+            const int32 FromEdgeEnd = RouteDistance[RouteIndex(ToLane, To)];
+            if (FromEdgeEnd == INDEX_NONE)
+                continue;
+
+            const int32 Candidate = ToEdgeStart + 1 + FromEdgeEnd;
+            const int32 Index = RouteIndex(From, To);
+            if (RouteDistance[Index] == INDEX_NONE || Candidate < RouteDistance[Index])
+            {
+                RouteDistance[Index] = Candidate;
+                RouteNextHop[Index] = (From == FromLane) ? ToLane : RouteNextHop[RouteIndex(From, FromLane)];
+            }
+        }
+    }
 }
\ No newline at end of file
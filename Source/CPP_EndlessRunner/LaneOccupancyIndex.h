@@ -0,0 +1,133 @@
+// LaneOccupancyIndex.h - Per-Lane Obstacle Index along the upcoming track
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SortedSearch.h"
+
+/**
+ * Sorted list of obstacle track distances for one lane
+ * Tiles are added at the far end and retired from the near end,
+ * so it behaves like a FIFO that stays sorted without any re-sorting
+ */
+struct FLaneOccupancy
+{
+    TArray<float> Distances;    // Ascending track distances of obstacles
+    int32 Head;                 // First live entry (entries before it are retired)
+
+    FLaneOccupancy() : Head(0) {}
+
+    int32 Num() const { return Distances.Num() - Head; }
+};
+
+/**
+ * Lane Occupancy Index
+ * Answers "is lane L blocked within the next D units" without touching actors
+ * Time Complexity: O(1) amortized add/retire, O(log n) queries
+ */
+class FLaneOccupancyIndex
+{
+private:
+    TArray<FLaneOccupancy> Lanes;
+
+public:
+    FLaneOccupancyIndex() {}
+
+    void Initialize(int32 NumLanes);
+    void Clear();
+
+    // Updates - called as tiles are spawned and retired
+    void AddObstacle(int32 LaneID, float Distance);    // O(1) amortized
+    void RetireBefore(float Distance);                  // O(k) for k retired entries
+
+    // Queries - O(log n) binary search per lane
+    bool IsLaneBlockedWithin(int32 LaneID, float FromDistance, float Range) const;
+    float GetNextObstacleDistance(int32 LaneID, float FromDistance) const;    // -1 if none
+
+    // Utility
+    int32 GetNumLanes() const { return Lanes.Num(); }
+    int32 GetObstacleCount(int32 LaneID) const;
+
+private:
+    int32 LowerBound(const FLaneOccupancy& Lane, float Distance) const;
+};
+
+// ===== IMPLEMENTATION =====
+
+inline void FLaneOccupancyIndex::Initialize(int32 NumLanes)
+{
+    Lanes.Empty(NumLanes);
+    Lanes.SetNum(NumLanes);
+}
+
+inline void FLaneOccupancyIndex::Clear()
+{
+    for (FLaneOccupancy& Lane : Lanes)
+    {
+        Lane.Distances.Reset();
+        Lane.Head = 0;
+    }
+}
+
+inline void FLaneOccupancyIndex::AddObstacle(int32 LaneID, float Distance)
+{
+    if (!Lanes.IsValidIndex(LaneID))
+        return;
+
+    FLaneOccupancy& Lane = Lanes[LaneID];
+
+    // Common case: new tiles are always further along the track
+    if (Lane.Num() == 0 || Distance >= Lane.Distances.Last())
+    {
+        Lane.Distances.Add(Distance);
+        return;
+    }
+
+    // Out-of-order spawn: keep the list sorted
+    Lane.Distances.Insert(Distance, LowerBound(Lane, Distance));
+}
+
+inline void FLaneOccupancyIndex::RetireBefore(float Distance)
+{
+    for (FLaneOccupancy& Lane : Lanes)
+    {
+        while (Lane.Head < Lane.Distances.Num() && Lane.Distances[Lane.Head] < Distance)
+        {
+            Lane.Head++;
+        }
+
+        // Compact once the dead prefix outgrows the live part
+        if (Lane.Head > 0 && Lane.Head >= Lane.Num())
+        {
+            Lane.Distances.RemoveAt(0, Lane.Head, EAllowShrinking::No);
+            Lane.Head = 0;
+        }
+    }
+}
+
+inline bool FLaneOccupancyIndex::IsLaneBlockedWithin(int32 LaneID, float FromDistance, float Range) const
+{
+    const float Next = GetNextObstacleDistance(LaneID, FromDistance);
+    return Next >= 0.0f && Next <= FromDistance + Range;
+}
+
+inline float FLaneOccupancyIndex::GetNextObstacleDistance(int32 LaneID, float FromDistance) const
+{
+    if (!Lanes.IsValidIndex(LaneID))
+        return -1.0f;
+
+    const FLaneOccupancy& Lane = Lanes[LaneID];
+    const int32 Index = LowerBound(Lane, FromDistance);
+    return Index < Lane.Distances.Num() ? Lane.Distances[Index] : -1.0f;
+}
+
+inline int32 FLaneOccupancyIndex::GetObstacleCount(int32 LaneID) const
+{
+    return Lanes.IsValidIndex(LaneID) ? Lanes[LaneID].Num() : 0;
+}
+
+// Binary Search - first live entry >= Distance
+inline int32 FLaneOccupancyIndex::LowerBound(const FLaneOccupancy& Lane, float Distance) const
+{
+    const int32 NumLive = Lane.Distances.Num() - Lane.Head;
+    return Lane.Head + FSortedSearch::LowerBound(Lane.Distances.GetData() + Lane.Head, NumLive, Distance);
+}
@@ -0,0 +1,668 @@
+// LeaderboardMerge.cpp - Partitioned k-way merge with per-player de-duplication
+#include "LeaderboardMerge.h"
+#include "LeaderboardStore.h"
+#include "Async/MappedFileHandle.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+// A player name as bytes inside a mapped shard
+struct FMergeName
+{
+	const uint8* Bytes;
+	uint32 Length;
+	uint32 Hash;
+
+	static uint8 Fold(uint8 Byte)
+	{
+		return (Byte >= 'A' && Byte <= 'Z') ? Byte + ('a' - 'A') : Byte;
+	}
+
+	bool operator==(const FMergeName& Other) const
+	{
+		if (Length != Other.Length || Hash != Other.Hash)
+			return false;
+		for (uint32 i = 0; i < Length; i++)
+		{
+			if (Fold(Bytes[i]) != Fold(Other.Bytes[i]))
+				return false;
+		}
+		return true;
+	}
+
+	// FNV-1a over case-folded bytes
+	static uint32 HashBytes(const uint8* Bytes, uint32 Length)
+	{
+		uint32 Hash = 2166136261u;
+		for (uint32 i = 0; i < Length; i++)
+		{
+			Hash = (Hash ^ Fold(Bytes[i])) * 16777619u;
+		}
+		return Hash;
+	}
+};
+
+// Multiply-shift takes the partition from the high bits of the name hash
+static int32 GetPartition(uint32 Hash, int32 NumPartitions)
+{
+	return static_cast<int32>((static_cast<uint64>(Hash) * NumPartitions) >> 32);
+}
+
+// A file mapped read-only, or loaded when it can't be mapped
+struct FMergeFile
+{
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	TArray64<uint8> FallbackData;
+	const uint8* Data = nullptr;
+	int64 DataSize = 0;
+
+	bool Map(const FString& Path)
+	{
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+		FOpenMappedResult MapResult = PlatformFile.OpenMappedEx(*Path);
+		if (!MapResult.HasError())
+		{
+			MappedFile = MapResult.StealValue();
+			MappedRegion.Reset(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+		}
+
+		if (MappedRegion)
+		{
+			Data = MappedRegion->GetMappedPtr();
+			DataSize = MappedRegion->GetMappedSize();
+			return true;
+		}
+		if (FFileHelper::LoadFileToArray(FallbackData, *Path, FILEREAD_Silent))
+		{
+			Data = FallbackData.GetData();
+			DataSize = FallbackData.Num();
+			return true;
+		}
+		return false;
+	}
+
+	// Region must go before the handle it was mapped from, and both before the file is deleted
+	void Unmap()
+	{
+		Data = nullptr;
+		DataSize = 0;
+		MappedRegion.Reset();
+		MappedFile.Reset();
+		FallbackData.Empty();
+	}
+};
+
+// One shard entry in the shard's partition-bucketed copy; the name hash
+// rides along so each entry's name is hashed only while bucketing
+struct FMergeRecord
+{
+	int32 Score;
+	uint32 NameId;
+	uint32 Hash;
+};
+
+// One player in a partition's output, in the order the partition found them
+// (highest first); the name stays in the shard it came from
+struct FMergedEntry
+{
+	int32 Score;
+	int32 Shard;
+	uint32 NameId;
+};
+
+// One input snapshot, mapped read-only, and its entries bucketed by partition
+struct FMergeShard
+{
+	FMergeFile Snapshot;
+	bool bValid = false;
+	bool bBucketed = false;
+	int64 BucketBytes = 0;
+
+	// Partition P's records are Buckets[PartitionStart[P]] up to Buckets[PartitionStart[P + 1]],
+	// highest score first
+	FMergeFile Buckets;
+	TArray<int32> PartitionStart;
+
+	const FLeaderboardSnapshotHeader& GetHeader() const { return *reinterpret_cast<const FLeaderboardSnapshotHeader*>(Snapshot.Data); }
+	const FLeaderboardSnapshotEntry* GetEntries() const { return reinterpret_cast<const FLeaderboardSnapshotEntry*>(Snapshot.Data + GetHeader().EntriesOffset); }
+	const FMergeRecord* GetRecords() const { return reinterpret_cast<const FMergeRecord*>(Buckets.Data); }
+	int32 Num() const { return Snapshot.Data ? static_cast<int32>(GetHeader().NumEntries) : 0; }
+
+	// Hash is carried, not computed: callers have it from the bucketed record (or don't need it)
+	FMergeName GetName(uint32 NameId, uint32 Hash) const
+	{
+		const uint32* Offsets = reinterpret_cast<const uint32*>(Snapshot.Data + GetHeader().NameOffsetsOffset);
+		const uint32 Begin = Offsets[NameId];
+		return { Snapshot.Data + GetHeader().NameDataOffset + Begin, Offsets[NameId + 1] - Begin, Hash };
+	}
+
+	uint32 HashName(uint32 NameId) const
+	{
+		const FMergeName Name = GetName(NameId, 0);
+		return FMergeName::HashBytes(Name.Bytes, Name.Length);
+	}
+
+	bool Open(const FString& Path)
+	{
+		return Snapshot.Map(Path) && FLeaderboardStore::IsValidSnapshot(Snapshot.Data, Snapshot.DataSize);
+	}
+
+	// Checks every name and entry reference stays in the file
+	bool Prepare() const
+	{
+		const FLeaderboardSnapshotHeader& Header = GetHeader();
+		const uint32* Offsets = reinterpret_cast<const uint32*>(Snapshot.Data + Header.NameOffsetsOffset);
+		const int64 NameDataSize = Snapshot.DataSize - Header.NameDataOffset;
+
+		for (uint32 NameId = 0; NameId < Header.NumNames; NameId++)
+		{
+			if (Offsets[NameId] > Offsets[NameId + 1] || Offsets[NameId + 1] > NameDataSize)
+				return false;
+		}
+
+		const FLeaderboardSnapshotEntry* Entries = GetEntries();
+		for (int32 i = 0; i < Num(); i++)
+		{
+			if (Entries[i].NameId >= Header.NumNames || (i > 0 && Entries[i].Score < Entries[i - 1].Score))
+				return false;
+		}
+		return true;
+	}
+
+	// Counting sort by partition (stable, top down) written to Path, so no partition walks
+	// past another's entries. One pass counts, the next fills a small buffer per partition
+	// and flushes it to that partition's region of the file; nothing per entry stays in memory
+	bool WriteBuckets(const FString& Path, int32 NumPartitions, int64& OutWorkingBytes)
+	{
+		const FLeaderboardSnapshotEntry* Entries = GetEntries();
+
+		PartitionStart.SetNumZeroed(NumPartitions + 1);
+		for (int32 i = 0; i < Num(); i++)
+		{
+			PartitionStart[GetPartition(HashName(Entries[i].NameId), NumPartitions) + 1]++;
+		}
+		for (int32 Partition = 0; Partition < NumPartitions; Partition++)
+		{
+			PartitionStart[Partition + 1] += PartitionStart[Partition];
+		}
+
+		TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Path));
+		if (!Writer)
+			return false;
+
+		// Up to 1024 records per partition, fewer when the shard would not fill them
+		const int32 BufferRecords = FMath::Clamp(Num() / NumPartitions + 1, 16, 1024);
+		TArray<FMergeRecord> Buffers;
+		Buffers.SetNumUninitialized(NumPartitions * BufferRecords);
+		TArray<int32> Buffered;
+		Buffered.SetNumZeroed(NumPartitions);
+		TArray<int32> Next(PartitionStart.GetData(), NumPartitions);
+
+		auto Flush = [&](int32 Partition)
+		{
+			Writer->Seek(static_cast<int64>(Next[Partition]) * sizeof(FMergeRecord));
+			Writer->Serialize(&Buffers[Partition * BufferRecords], Buffered[Partition] * sizeof(FMergeRecord));
+			Next[Partition] += Buffered[Partition];
+			Buffered[Partition] = 0;
+		};
+
+		for (int32 i = Num() - 1; i >= 0; i--)
+		{
+			const uint32 Hash = HashName(Entries[i].NameId);
+			const int32 Partition = GetPartition(Hash, NumPartitions);
+			Buffers[Partition * BufferRecords + Buffered[Partition]++] = { Entries[i].Score, Entries[i].NameId, Hash };
+			if (Buffered[Partition] == BufferRecords)
+			{
+				Flush(Partition);
+			}
+		}
+		for (int32 Partition = 0; Partition < NumPartitions; Partition++)
+		{
+			if (Buffered[Partition] > 0)
+			{
+				Flush(Partition);
+			}
+		}
+
+		OutWorkingBytes = Buffers.GetAllocatedSize() + Buffered.GetAllocatedSize() + Next.GetAllocatedSize() + PartitionStart.GetAllocatedSize();
+		if (!Writer->Close() || Writer->IsError())
+			return false;
+
+		// Every region was filled, so the file is exactly one record per entry
+		return Buckets.Map(Path) && Buckets.DataSize == static_cast<int64>(Num()) * sizeof(FMergeRecord);
+	}
+};
+
+// Names already written by one partition
+// Open addressing over a flat slot array: one probe run per lookup and no
+// allocation per name, which matters with millions of players
+class FSeenNames
+{
+public:
+	FSeenNames()
+	{
+		Slots.SetNumZeroed(1024);
+	}
+
+	// True if the name was not in the set yet
+	bool Add(const FMergeName& Name)
+	{
+		if (2 * (NumNames + 1) > Slots.Num())
+		{
+			Grow();
+		}
+
+		FMergeName* Slot = FindSlot(Name);
+		if (Slot->Bytes)
+			return false;
+
+		*Slot = Name;
+		NumNames++;
+		return true;
+	}
+
+	SIZE_T GetAllocatedSize() const { return Slots.GetAllocatedSize(); }
+
+private:
+	TArray<FMergeName> Slots;   // Bytes == nullptr marks an empty slot
+	int32 NumNames = 0;
+
+	// The name's slot, or the empty slot it would go in
+	FMergeName* FindSlot(const FMergeName& Name)
+	{
+		const uint32 Mask = Slots.Num() - 1;
+		uint32 Index = (Name.Hash * 0x9E3779B1u) & Mask;
+		while (Slots[Index].Bytes && !(Slots[Index] == Name))
+		{
+			Index = (Index + 1) & Mask;
+		}
+		return &Slots[Index];
+	}
+
+	void Grow()
+	{
+		TArray<FMergeName> OldSlots = MoveTemp(Slots);
+		Slots.SetNumZeroed(OldSlots.Num() * 2);
+		for (const FMergeName& Name : OldSlots)
+		{
+			if (Name.Bytes)
+			{
+				*FindSlot(Name) = Name;
+			}
+		}
+	}
+};
+
+// What one partition wrote: its players and the bytes their names will take
+struct FMergedPartition
+{
+	FString Path;
+	FMergeFile Output;
+	int32 NumEntries = 0;
+	uint64 NameDataSize = 0;
+	int64 WorkingBytes = 0;
+	bool bWritten = false;
+
+	const FMergedEntry* GetEntries() const { return reinterpret_cast<const FMergedEntry*>(Output.Data); }
+};
+
+// Every player of one partition, best score each, highest first, streamed to OutPartition.Path
+static bool MergePartition(const TArray<FMergeShard>& Shards, int32 Partition, FMergedPartition& OutPartition)
+{
+	struct FCursor
+	{
+		int32 Shard;
+		int32 Position;   // Into the shard's bucketed records; this partition's are walked from the top down
+		int32 End;
+		int32 Score;
+	};
+
+	auto IsAbove = [](const FCursor& A, const FCursor& B)
+	{
+		return A.Score != B.Score ? A.Score > B.Score : A.Shard < B.Shard;
+	};
+
+	// Loads the score at the cursor; false once the shard has no more entries in this partition
+	auto Seek = [&](FCursor& Cursor) -> bool
+	{
+		if (Cursor.Position >= Cursor.End)
+			return false;
+
+		Cursor.Score = Shards[Cursor.Shard].GetRecords()[Cursor.Position].Score;
+		return true;
+	};
+
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*OutPartition.Path));
+	if (!Writer)
+		return false;
+
+	TArray<FCursor> Heap;
+	Heap.Reserve(Shards.Num());
+	for (int32 ShardIndex = 0; ShardIndex < Shards.Num(); ShardIndex++)
+	{
+		const FMergeShard& Shard = Shards[ShardIndex];
+		FCursor Cursor = { ShardIndex, Shard.PartitionStart[Partition], Shard.PartitionStart[Partition + 1], 0 };
+		if (Seek(Cursor))
+		{
+			Heap.Add(Cursor);
+		}
+	}
+
+	// The top cursor advances in place, so one sift-down replaces a pop and a push
+	auto SiftDown = [&Heap, &IsAbove](int32 Index)
+	{
+		const int32 Num = Heap.Num();
+		const FCursor Moving = Heap[Index];
+		for (int32 Child = 2 * Index + 1; Child < Num; Child = 2 * Index + 1)
+		{
+			if (Child + 1 < Num && IsAbove(Heap[Child + 1], Heap[Child]))
+			{
+				Child++;
+			}
+			if (!IsAbove(Heap[Child], Moving))
+				break;
+
+			Heap[Index] = Heap[Child];
+			Index = Child;
+		}
+		Heap[Index] = Moving;
+	};
+
+	for (int32 Index = Heap.Num() / 2 - 1; Index >= 0; Index--)
+	{
+		SiftDown(Index);
+	}
+
+	TArray<FMergedEntry> Buffer;
+	Buffer.Reserve(4096);
+	auto Flush = [&]()
+	{
+		Writer->Serialize(Buffer.GetData(), Buffer.Num() * sizeof(FMergedEntry));
+		Buffer.Reset();
+	};
+
+	FSeenNames Seen;
+	while (Heap.Num() > 0)
+	{
+		FCursor& Top = Heap[0];
+		const FMergeShard& Shard = Shards[Top.Shard];
+		const FMergeRecord& Record = Shard.GetRecords()[Top.Position];
+		const FMergeName Name = Shard.GetName(Record.NameId, Record.Hash);
+
+		// Shards are walked best first, so a player's first entry is their best
+		if (Seen.Add(Name))
+		{
+			Buffer.Add({ Top.Score, Top.Shard, Record.NameId });
+			OutPartition.NumEntries++;
+			OutPartition.NameDataSize += Name.Length;
+			if (Buffer.Num() == Buffer.Max())
+			{
+				Flush();
+			}
+		}
+
+		Top.Position++;
+		if (!Seek(Top))
+		{
+			Heap.RemoveAtSwap(0, 1, EAllowShrinking::No);
+		}
+		if (Heap.Num() > 0)
+		{
+			SiftDown(0);
+		}
+	}
+	Flush();
+
+	OutPartition.WorkingBytes = Heap.GetAllocatedSize() + Seen.GetAllocatedSize() + Buffer.GetAllocatedSize();
+	if (!Writer->Close() || Writer->IsError())
+		return false;
+
+	return OutPartition.Output.Map(OutPartition.Path)
+		&& OutPartition.Output.DataSize == static_cast<int64>(OutPartition.NumEntries) * sizeof(FMergedEntry);
+}
+
+// Partitions (each highest first) -> one ascending snapshot, written front to back
+static bool WriteMerged(const TArray<FMergeShard>& Shards, const TArray<FMergedPartition>& Partitions, const FString& Path,
+	int64& OutWorkingBytes)
+{
+	// Each player appears once, so partition P's i-th entry gets name ID Base[P] + i
+	TArray<uint32> NameBase;
+	uint64 NumEntries = 0;
+	uint64 NameDataSize = 0;
+	for (const FMergedPartition& Partition : Partitions)
+	{
+		NameBase.Add(static_cast<uint32>(NumEntries));
+		NumEntries += Partition.NumEntries;
+		NameDataSize += Partition.NameDataSize;
+	}
+
+	FLeaderboardSnapshotHeader Header;
+	FMemory::Memzero(Header);
+	Header.Magic = LEADERBOARD_SNAPSHOT_MAGIC;
+	Header.Version = LEADERBOARD_FORMAT_VERSION;
+	Header.EntriesOffset = sizeof(FLeaderboardSnapshotHeader);
+
+	const uint64 NameOffsetsOffset = Header.EntriesOffset + NumEntries * sizeof(FLeaderboardSnapshotEntry);
+	const uint64 NameDataOffset = NameOffsetsOffset + (NumEntries + 1) * sizeof(uint32);
+	const uint64 TotalSize = Align(NameDataOffset + NameDataSize, 4);
+	if (TotalSize > MAX_uint32)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Leaderboard merge: %llu bytes is over the snapshot format's 4 GB limit"), TotalSize);
+		return false;
+	}
+	Header.NumEntries = static_cast<uint32>(NumEntries);
+	Header.NumNames = static_cast<uint32>(NumEntries);
+	Header.NameOffsetsOffset = static_cast<uint32>(NameOffsetsOffset);
+	Header.NameDataOffset = static_cast<uint32>(NameDataOffset);
+	Header.TotalSize = static_cast<uint32>(TotalSize);
+
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Path));
+	if (!Writer)
+		return false;
+
+	TArray<uint8> Buffer;
+	Buffer.Reserve(1 << 20);
+	auto Write = [&](const void* Bytes, int64 Size)
+	{
+		if (Buffer.Num() + Size > Buffer.Max())
+		{
+			Writer->Serialize(Buffer.GetData(), Buffer.Num());
+			Buffer.Reset();
+		}
+		if (Size > Buffer.Max())
+		{
+			Writer->Serialize(const_cast<void*>(Bytes), Size);
+			return;
+		}
+		Buffer.Append(static_cast<const uint8*>(Bytes), Size);
+	};
+
+	Write(&Header, sizeof(Header));
+
+	// Entries, lowest first: a second heap over the tails of the partitions
+	struct FTail
+	{
+		int32 Partition;
+		int32 Index;
+		int32 Score;
+	};
+	struct FLowestFirst
+	{
+		bool operator()(const FTail& A, const FTail& B) const
+		{
+			return A.Score != B.Score ? A.Score < B.Score : A.Partition < B.Partition;
+		}
+	};
+
+	TArray<FTail> Heap;
+	for (int32 Partition = 0; Partition < Partitions.Num(); Partition++)
+	{
+		const int32 Last = Partitions[Partition].NumEntries - 1;
+		if (Last >= 0)
+		{
+			Heap.HeapPush({ Partition, Last, Partitions[Partition].GetEntries()[Last].Score }, FLowestFirst());
+		}
+	}
+
+	while (Heap.Num() > 0)
+	{
+		FTail Tail;
+		Heap.HeapPop(Tail, FLowestFirst(), EAllowShrinking::No);
+
+		const FLeaderboardSnapshotEntry Entry = { Tail.Score, NameBase[Tail.Partition] + Tail.Index };
+		Write(&Entry, sizeof(Entry));
+
+		if (--Tail.Index >= 0)
+		{
+			Tail.Score = Partitions[Tail.Partition].GetEntries()[Tail.Index].Score;
+			Heap.HeapPush(Tail, FLowestFirst());
+		}
+	}
+
+	// Name table in ID order, the bytes read from the shards they came from
+	uint32 Offset = 0;
+	for (const FMergedPartition& Partition : Partitions)
+	{
+		for (int32 i = 0; i < Partition.NumEntries; i++)
+		{
+			const FMergedEntry& Entry = Partition.GetEntries()[i];
+			Write(&Offset, sizeof(Offset));
+			Offset += Shards[Entry.Shard].GetName(Entry.NameId, 0).Length;
+		}
+	}
+	Write(&Offset, sizeof(Offset));
+
+	for (const FMergedPartition& Partition : Partitions)
+	{
+		for (int32 i = 0; i < Partition.NumEntries; i++)
+		{
+			const FMergedEntry& Entry = Partition.GetEntries()[i];
+			const FMergeName Name = Shards[Entry.Shard].GetName(Entry.NameId, 0);
+			Write(Name.Bytes, Name.Length);
+		}
+	}
+
+	const uint8 Padding[4] = { 0, 0, 0, 0 };
+	Write(Padding, TotalSize - (NameDataOffset + NameDataSize));
+
+	OutWorkingBytes = Buffer.GetAllocatedSize() + Heap.GetAllocatedSize() + NameBase.GetAllocatedSize();
+	Writer->Serialize(Buffer.GetData(), Buffer.Num());
+	return Writer->Close() && !Writer->IsError();
+}
+
+bool FLeaderboardMerge::MergeSnapshots(const TArray<FString>& ShardPaths, const FString& OutputPath,
+	FLeaderboardMergeStats* OutStats, int32 NumPartitions)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	TArray<FMergeShard> Shards;
+	Shards.SetNum(ShardPaths.Num());
+
+	// Mapping and checking are independent per shard
+	ParallelFor(Shards.Num(), [&](int32 Index)
+	{
+		Shards[Index].bValid = Shards[Index].Open(ShardPaths[Index]) && Shards[Index].Prepare();
+	});
+
+	int64 InputEntries = 0;
+	for (int32 Index = 0; Index < Shards.Num(); Index++)
+	{
+		if (!Shards[Index].bValid)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Leaderboard merge: %s is not a valid snapshot"), *ShardPaths[Index]);
+			return false;
+		}
+		InputEntries += Shards[Index].Num();
+	}
+
+	if (NumPartitions <= 0)
+	{
+		NumPartitions = FPlatformMisc::NumberOfCoresIncludingHyperthreads();
+	}
+	NumPartitions = FMath::Clamp(NumPartitions, 1, 256);
+
+	// Bucketed shards and partition outputs go beside the destination and are deleted afterwards
+	const FString WorkDirectory = OutputPath + TEXT(".work");
+	IFileManager::Get().MakeDirectory(*WorkDirectory, true);
+
+	TArray<FMergedPartition> Partitions;
+	Partitions.SetNum(NumPartitions);
+	for (int32 Partition = 0; Partition < NumPartitions; Partition++)
+	{
+		Partitions[Partition].Path = FPaths::Combine(WorkDirectory, FString::Printf(TEXT("Partition%03d.run"), Partition));
+	}
+
+	auto Cleanup = [&]()
+	{
+		for (FMergeShard& Shard : Shards)
+		{
+			Shard.Buckets.Unmap();
+		}
+		for (FMergedPartition& Partition : Partitions)
+		{
+			Partition.Output.Unmap();
+		}
+		IFileManager::Get().DeleteDirectory(*WorkDirectory, false, true);
+	};
+
+	ParallelFor(Shards.Num(), [&](int32 Index)
+	{
+		const FString BucketPath = FPaths::Combine(WorkDirectory, FString::Printf(TEXT("Shard%05d.bkt"), Index));
+		Shards[Index].bBucketed = Shards[Index].WriteBuckets(BucketPath, NumPartitions, Shards[Index].BucketBytes);
+	});
+
+	const bool bBucketed = !Shards.ContainsByPredicate([](const FMergeShard& Shard) { return !Shard.bBucketed; });
+	if (bBucketed)
+	{
+		ParallelFor(NumPartitions, [&](int32 Partition)
+		{
+			Partitions[Partition].bWritten = MergePartition(Shards, Partition, Partitions[Partition]);
+		});
+	}
+	const bool bMerged = bBucketed && !Partitions.ContainsByPredicate([](const FMergedPartition& Partition) { return !Partition.bWritten; });
+
+	// Write beside the destination, then swap, like compaction does
+	const FString TempPath = OutputPath + TEXT(".tmp");
+	int64 WriteBytes = 0;
+	if (!bMerged || !WriteMerged(Shards, Partitions, TempPath, WriteBytes) || !IFileManager::Get().Move(*OutputPath, *TempPath, true))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Leaderboard merge: could not write %s"), *OutputPath);
+		IFileManager::Get().Delete(*TempPath, false, false, true);
+		Cleanup();
+		return false;
+	}
+
+	if (OutStats)
+	{
+		// Phases run one after another, so the peak is the largest phase; within a
+		// phase, the largest task times the tasks that can run at once
+		const int32 NumWorkers = FPlatformMisc::NumberOfCoresIncludingHyperthreads();
+		int64 BucketBytes = 0;
+		for (const FMergeShard& Shard : Shards)
+		{
+			BucketBytes = FMath::Max(BucketBytes, Shard.BucketBytes);
+		}
+		BucketBytes *= FMath::Min(Shards.Num(), NumWorkers);
+
+		int64 MergeBytes = 0;
+		OutStats->OutputEntries = 0;
+		for (const FMergedPartition& Partition : Partitions)
+		{
+			OutStats->OutputEntries += Partition.NumEntries;
+			MergeBytes = FMath::Max(MergeBytes, Partition.WorkingBytes);
+		}
+		MergeBytes *= FMath::Min(NumPartitions, NumWorkers);
+
+		OutStats->NumShards = Shards.Num();
+		OutStats->NumPartitions = NumPartitions;
+		OutStats->InputEntries = InputEntries;
+		OutStats->WorkingBytes = FMath::Max3(BucketBytes, MergeBytes, WriteBytes);
+		OutStats->Seconds = FPlatformTime::Seconds() - StartTime;
+	}
+
+	Cleanup();
+	return true;
+}
@@ -0,0 +1,40 @@
+// LeaderboardMerge.h - Streaming k-way merge of leaderboard snapshot shards
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FLeaderboardMergeStats
+{
+	int32 NumShards = 0;
+	int32 NumPartitions = 0;
+	int64 InputEntries = 0;
+	int32 OutputEntries = 0;
+	int64 WorkingBytes = 0;   // Largest phase's heaps, buffers and de-dupe sets; mapped inputs and temporary files are not counted
+	double Seconds = 0.0;
+};
+
+/**
+ * Combines leaderboard snapshots (Scores.snap files from many sessions or
+ * servers) into one snapshot that holds each player's best score
+ * Players are split by name hash into partitions (one per core by default).
+ * Each shard is first copied, in parallel, to a temporary file bucketed by
+ * partition; the copy is filled through a small buffer per partition, so no
+ * per-entry index is kept in memory. Each partition then walks its bucket of
+ * every shard from the highest score down through a k-way heap, so the first
+ * entry it sees for a player is that player's best, and streams those players
+ * to its own file as the heap pops. Inputs and temporary files stay
+ * memory-mapped; working memory is O(k P) for the heaps and buffers plus the
+ * de-dupe set of each running partition, which more partitions make smaller
+ * The partition files are then merged again, lowest first, straight into the
+ * output file, which FLeaderboardStore can open as its snapshot
+ * Player names match ignoring ASCII case, as in FPlayerNameTable
+ * Time Complexity: O(N log k) for N entries over k shards, split across cores,
+ * plus O(N + k P) to bucket them into P partitions
+ */
+class FLeaderboardMerge
+{
+public:
+	// NumPartitions <= 0 uses one per core; fails without writing if any shard is invalid
+	static bool MergeSnapshots(const TArray<FString>& ShardPaths, const FString& OutputPath,
+		FLeaderboardMergeStats* OutStats = nullptr, int32 NumPartitions = 0);
+};
@@ -0,0 +1,640 @@
+// LeaderboardStore.cpp - Snapshot mapping, log replay/append and compaction
+#include "LeaderboardStore.h"
+#include "ScoreBST.h"
+#include "SortedSearch.h"
+#include "Algo/Sort.h"
+#include "Async/Async.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+// Names are capped at LEADERBOARD_MAX_NAME_CHARS, so anything larger is corruption
+static constexpr uint32 MaxLogNameBytes = LEADERBOARD_MAX_NAME_CHARS * 4;
+
+template<typename T>
+static void AppendPOD(TArray<uint8>& Bytes, const T& Value)
+{
+	Bytes.Append(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+}
+
+FLeaderboardStore::FLeaderboardStore()
+	: Data(nullptr), DataSize(0), LogGeneration(0), CompactThreshold(4096)
+	, FrozenLogGeneration(0), bHasFrozenLog(false), bCompactionFailed(false)
+{
+}
+
+FLeaderboardStore::~FLeaderboardStore()
+{
+	Close();
+}
+
+bool FLeaderboardStore::Open(const FString& Directory)
+{
+	Close();
+
+	IFileManager::Get().MakeDirectory(*Directory, true);
+	SnapshotPath = FPaths::Combine(Directory, TEXT("Scores.snap"));
+	LogPath = FPaths::Combine(Directory, TEXT("Scores.log"));
+	FrozenLogPath = FPaths::Combine(Directory, TEXT("Scores.frozen.log"));
+	Recent = MakeUnique<FScoreBST>();
+
+	// A missing snapshot is a fresh leaderboard; a broken one is set aside, not overwritten
+	if (!MapSnapshot() && IFileManager::Get().FileExists(*SnapshotPath))
+	{
+		const FString BadPath = SnapshotPath + TEXT(".bad");
+		UE_LOG(LogTemp, Error, TEXT("Leaderboard snapshot %s is invalid, moved to %s"), *SnapshotPath, *BadPath);
+		IFileManager::Get().Move(*BadPath, *SnapshotPath, true);
+	}
+
+	// An interrupted compaction leaves its frozen log; UpdateCompaction() finishes the job
+	ReplayFrozenLog(GetSnapshotGeneration());
+	if (!ReplayLog(bHasFrozenLog ? FrozenLogGeneration + 1 : GetSnapshotGeneration()))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Leaderboard log %s could not be opened for writing"), *LogPath);
+		Close();
+		return false;
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("Leaderboard opened: %d snapshot entries, %d from log"), GetSnapshotNum(), Recent->GetNodeCount());
+	return true;
+}
+
+void FLeaderboardStore::Close()
+{
+	// The task reads the mapped snapshot: let it finish, and keep what it wrote
+	if (CompactionTask.IsValid())
+	{
+		CompactionTask.Wait();
+		FinishCompaction();
+	}
+
+	LogWriter.Reset();
+	UnmapSnapshot();
+	Recent.Reset();
+	bHasFrozenLog = false;
+	bCompactionFailed = false;
+}
+
+// ===== SNAPSHOT =====
+
+bool FLeaderboardStore::MapSnapshot()
+{
+	UnmapSnapshot();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	FOpenMappedResult MapResult = PlatformFile.OpenMappedEx(*SnapshotPath);
+	if (!MapResult.HasError())
+	{
+		MappedFile = MapResult.StealValue();
+		MappedRegion.Reset(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+	}
+
+	if (MappedRegion)
+	{
+		Data = MappedRegion->GetMappedPtr();
+		DataSize = MappedRegion->GetMappedSize();
+	}
+	else if (FFileHelper::LoadFileToArray(FallbackData, *SnapshotPath, FILEREAD_Silent))
+	{
+		Data = FallbackData.GetData();
+		DataSize = FallbackData.Num();
+	}
+	else
+	{
+		UnmapSnapshot();
+		return false;
+	}
+
+	if (!ValidateSnapshot())
+	{
+		UnmapSnapshot();
+		return false;
+	}
+	return true;
+}
+
+void FLeaderboardStore::UnmapSnapshot()
+{
+	Data = nullptr;
+	DataSize = 0;
+
+	// Region must go before the handle it was mapped from
+	MappedRegion.Reset();
+	MappedFile.Reset();
+	FallbackData.Empty();
+}
+
+bool FLeaderboardStore::ValidateSnapshot() const
+{
+	return IsValidSnapshot(Data, DataSize);
+}
+
+bool FLeaderboardStore::IsValidSnapshot(const uint8* Bytes, int64 NumBytes)
+{
+	if (!Bytes || NumBytes < static_cast<int64>(sizeof(FLeaderboardSnapshotHeader)))
+		return false;
+
+	const FLeaderboardSnapshotHeader& Header = *reinterpret_cast<const FLeaderboardSnapshotHeader*>(Bytes);
+	if (Header.Magic != LEADERBOARD_SNAPSHOT_MAGIC || Header.Version != LEADERBOARD_FORMAT_VERSION || Header.TotalSize != NumBytes)
+		return false;
+
+	// Every table must fit inside the file, in order
+	const bool bEntriesFit = Header.EntriesOffset + static_cast<int64>(Header.NumEntries) * sizeof(FLeaderboardSnapshotEntry) <= Header.NameOffsetsOffset;
+	const bool bOffsetsFit = Header.NameOffsetsOffset + (static_cast<int64>(Header.NumNames) + 1) * sizeof(uint32) <= Header.NameDataOffset;
+	return bEntriesFit && bOffsetsFit && Header.NameDataOffset <= Header.TotalSize;
+}
+
+const FLeaderboardSnapshotEntry* FLeaderboardStore::GetSnapshotEntries() const
+{
+	return Data ? reinterpret_cast<const FLeaderboardSnapshotEntry*>(Data + GetHeader().EntriesOffset) : nullptr;
+}
+
+FString FLeaderboardStore::ReadSnapshotName(const uint8* Bytes, int64 NumBytes, uint32 NameId)
+{
+	if (!Bytes || NameId >= reinterpret_cast<const FLeaderboardSnapshotHeader*>(Bytes)->NumNames)
+		return FString();
+
+	const FLeaderboardSnapshotHeader& Header = *reinterpret_cast<const FLeaderboardSnapshotHeader*>(Bytes);
+	const uint32* Offsets = reinterpret_cast<const uint32*>(Bytes + Header.NameOffsetsOffset);
+	const int64 Begin = Header.NameDataOffset + static_cast<int64>(Offsets[NameId]);
+	const int64 End = Header.NameDataOffset + static_cast<int64>(Offsets[NameId + 1]);
+	if (Begin > End || End > NumBytes)
+		return FString();
+
+	FUTF8ToTCHAR Converted(reinterpret_cast<const UTF8CHAR*>(Bytes + Begin), static_cast<int32>(End - Begin));
+	return FString(Converted.Length(), Converted.Get());
+}
+
+// First snapshot entry with a score above Score
+int32 FLeaderboardStore::SnapshotUpperBound(int32 Score) const
+{
+	// Branchless: the mapped snapshot is usually far bigger than the cache
+	return FSortedSearch::UpperBound(GetSnapshotEntries(), GetSnapshotNum(), Score,
+		[](const FLeaderboardSnapshotEntry& Entry) { return Entry.Score; });
+}
+
+void FLeaderboardStore::SerializeSnapshot(const TArray<FLeaderboardSnapshotEntry>& Entries, const FPlayerNameTable& Names,
+	uint32 NextLogGeneration, TArray<uint8>& OutBytes)
+{
+	TArray<uint32> NameOffsets;
+	NameOffsets.Reserve(Names.Num() + 1);
+	TArray<uint8> NameData;
+
+	for (int32 NameId = 0; NameId < Names.Num(); NameId++)
+	{
+		NameOffsets.Add(NameData.Num());
+		FTCHARToUTF8 Utf8(*Names.GetName(NameId));
+		NameData.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+	}
+	NameOffsets.Add(NameData.Num());
+
+	FLeaderboardSnapshotHeader Header;
+	FMemory::Memzero(Header);
+	Header.Magic = LEADERBOARD_SNAPSHOT_MAGIC;
+	Header.Version = LEADERBOARD_FORMAT_VERSION;
+	Header.NextLogGeneration = NextLogGeneration;
+	Header.NumEntries = Entries.Num();
+	Header.NumNames = Names.Num();
+	Header.EntriesOffset = sizeof(FLeaderboardSnapshotHeader);
+	Header.NameOffsetsOffset = Header.EntriesOffset + Entries.Num() * sizeof(FLeaderboardSnapshotEntry);
+	Header.NameDataOffset = Header.NameOffsetsOffset + NameOffsets.Num() * sizeof(uint32);
+	Header.TotalSize = Align(Header.NameDataOffset + NameData.Num(), 4);
+
+	OutBytes.Reset(Header.TotalSize);
+	AppendPOD(OutBytes, Header);
+	OutBytes.Append(reinterpret_cast<const uint8*>(Entries.GetData()), Entries.Num() * sizeof(FLeaderboardSnapshotEntry));
+	OutBytes.Append(reinterpret_cast<const uint8*>(NameOffsets.GetData()), NameOffsets.Num() * sizeof(uint32));
+	OutBytes.Append(NameData);
+	OutBytes.SetNumZeroed(Header.TotalSize);
+}
+
+// ===== LOG =====
+
+bool FLeaderboardStore::OpenLogWriter()
+{
+	LogWriter.Reset(IFileManager::Get().CreateFileWriter(*LogPath, FILEWRITE_Append | FILEWRITE_AllowRead));
+	return LogWriter.IsValid();
+}
+
+bool FLeaderboardStore::ResetLog(uint32 Generation)
+{
+	LogWriter.Reset();
+
+	FLeaderboardLogHeader Header;
+	FMemory::Memzero(Header);
+	Header.Magic = LEADERBOARD_LOG_MAGIC;
+	Header.Version = LEADERBOARD_FORMAT_VERSION;
+	Header.Generation = Generation;
+
+	TArray<uint8> Bytes;
+	AppendPOD(Bytes, Header);
+	if (!FFileHelper::SaveArrayToFile(Bytes, *LogPath))
+		return false;
+
+	LogGeneration = Generation;
+	return OpenLogWriter();
+}
+
+int32 FLeaderboardStore::ParseLog(const TArray<uint8>& Bytes, TArray<FLeaderboardEntry>& OutEntries)
+{
+	int32 Offset = sizeof(FLeaderboardLogHeader);
+	while (Offset + static_cast<int32>(sizeof(FLeaderboardLogRecord)) <= Bytes.Num())
+	{
+		FLeaderboardLogRecord Record;
+		FMemory::Memcpy(&Record, Bytes.GetData() + Offset, sizeof(Record));
+
+		const int32 RecordEnd = Offset + sizeof(FLeaderboardLogRecord) + Record.NameBytes;
+		if (Record.NameBytes > MaxLogNameBytes || RecordEnd > Bytes.Num())
+			break;
+
+		FUTF8ToTCHAR Name(reinterpret_cast<const UTF8CHAR*>(Bytes.GetData() + Offset + sizeof(FLeaderboardLogRecord)), Record.NameBytes);
+		OutEntries.Add({ Record.Score, FString(Name.Length(), Name.Get()) });
+		Offset = RecordEnd;
+	}
+	return Offset;
+}
+
+bool FLeaderboardStore::ReplayLog(uint32 MinGeneration)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *LogPath, FILEREAD_Silent) || Bytes.Num() < static_cast<int32>(sizeof(FLeaderboardLogHeader)))
+		return ResetLog(MinGeneration);
+
+	const FLeaderboardLogHeader& Header = *reinterpret_cast<const FLeaderboardLogHeader*>(Bytes.GetData());
+	if (Header.Magic != LEADERBOARD_LOG_MAGIC || Header.Version != LEADERBOARD_FORMAT_VERSION)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Leaderboard log %s is invalid, starting a new one"), *LogPath);
+		return ResetLog(MinGeneration);
+	}
+	if (Header.Generation < MinGeneration)
+	{
+		// Compaction finished but the log was not reset: its entries are already in the snapshot
+		return ResetLog(MinGeneration);
+	}
+
+	TArray<FLeaderboardEntry> Entries;
+	const int32 Offset = ParseLog(Bytes, Entries);
+	for (const FLeaderboardEntry& Entry : Entries)
+	{
+		Recent->Insert(Entry.Score, Entry.PlayerName);
+	}
+
+	// A torn record at the end (crash mid-append) is dropped so new appends start clean
+	if (Offset != Bytes.Num())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Leaderboard log %s: dropped %d trailing bytes"), *LogPath, Bytes.Num() - Offset);
+		Bytes.SetNum(Offset);
+		if (!FFileHelper::SaveArrayToFile(Bytes, *LogPath))
+			return false;
+	}
+
+	LogGeneration = Header.Generation;
+	return OpenLogWriter();
+}
+
+void FLeaderboardStore::ReplayFrozenLog(uint32 SnapshotGeneration)
+{
+	bHasFrozenLog = false;
+
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *FrozenLogPath, FILEREAD_Silent))
+		return;
+
+	const FLeaderboardLogHeader* Header = Bytes.Num() >= static_cast<int32>(sizeof(FLeaderboardLogHeader))
+		? reinterpret_cast<const FLeaderboardLogHeader*>(Bytes.GetData()) : nullptr;
+	if (!Header || Header->Magic != LEADERBOARD_LOG_MAGIC || Header->Version != LEADERBOARD_FORMAT_VERSION
+		|| Header->Generation < SnapshotGeneration)
+	{
+		// The swap happened (or the file is junk): the snapshot already holds these runs
+		IFileManager::Get().Delete(*FrozenLogPath, false, false, true);
+		return;
+	}
+
+	TArray<FLeaderboardEntry> Entries;
+	ParseLog(Bytes, Entries);
+	for (const FLeaderboardEntry& Entry : Entries)
+	{
+		Recent->Insert(Entry.Score, Entry.PlayerName);
+	}
+
+	FrozenLogGeneration = Header->Generation;
+	bHasFrozenLog = true;
+}
+
+bool FLeaderboardStore::Append(int32 Score, const FString& PlayerName)
+{
+	if (!IsOpen())
+		return false;
+
+	const FString Name = PlayerName.Left(LEADERBOARD_MAX_NAME_CHARS);
+	FTCHARToUTF8 Utf8(*Name);
+
+	FLeaderboardLogRecord Record;
+	Record.Score = Score;
+	Record.NameBytes = Utf8.Length();
+
+	TArray<uint8> Bytes;
+	AppendPOD(Bytes, Record);
+	Bytes.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+
+	LogWriter->Serialize(Bytes.GetData(), Bytes.Num());
+	LogWriter->Flush();
+	if (LogWriter->IsError())
+	{
+		UE_LOG(LogTemp, Error, TEXT("Leaderboard log %s: write failed"), *LogPath);
+		return false;
+	}
+
+	Recent->Insert(Score, Name);
+	return true;
+}
+
+// ===== COMPACTION =====
+
+void FLeaderboardStore::GatherSorted(const uint8* SnapshotBytes, int64 SnapshotSize, const TArray<FLeaderboardEntry>& RecentSorted,
+	FPlayerNameTable& Names, TArray<FLeaderboardSnapshotEntry>& OutEntries)
+{
+	const FLeaderboardSnapshotHeader* Header = reinterpret_cast<const FLeaderboardSnapshotHeader*>(SnapshotBytes);
+	const FLeaderboardSnapshotEntry* Snapshot = Header ? reinterpret_cast<const FLeaderboardSnapshotEntry*>(SnapshotBytes + Header->EntriesOffset) : nullptr;
+	const int32 SnapshotNum = Header ? static_cast<int32>(Header->NumEntries) : 0;
+	const int32 SnapshotNames = Header ? static_cast<int32>(Header->NumNames) : 0;
+
+	OutEntries.Reset(SnapshotNum + RecentSorted.Num());
+
+	// Snapshot name IDs are remapped on first use
+	TArray<uint32> SnapshotRemap;
+	SnapshotRemap.Init(FPlayerNameTable::InvalidId, SnapshotNames);
+
+	auto RemapSnapshotName = [&](uint32 NameId) -> uint32
+	{
+		if (NameId >= static_cast<uint32>(SnapshotNames))
+			return Names.Intern(FString());
+		if (SnapshotRemap[NameId] == FPlayerNameTable::InvalidId)
+			SnapshotRemap[NameId] = Names.Intern(ReadSnapshotName(SnapshotBytes, SnapshotSize, NameId));
+		return SnapshotRemap[NameId];
+	};
+
+	// Two-way merge of already sorted sequences - O(n)
+	int32 i = 0;
+	int32 j = 0;
+	while (i < SnapshotNum || j < RecentSorted.Num())
+	{
+		FLeaderboardSnapshotEntry& Entry = OutEntries.AddDefaulted_GetRef();
+		if (j >= RecentSorted.Num() || (i < SnapshotNum && Snapshot[i].Score <= RecentSorted[j].Score))
+		{
+			Entry.Score = Snapshot[i].Score;
+			Entry.NameId = RemapSnapshotName(Snapshot[i].NameId);
+			i++;
+		}
+		else
+		{
+			Entry.Score = RecentSorted[j].Score;
+			Entry.NameId = Names.Intern(RecentSorted[j].PlayerName);
+			j++;
+		}
+	}
+}
+
+bool FLeaderboardStore::NeedsCompaction() const
+{
+	return Recent && Recent->GetNodeCount() >= CompactThreshold;
+}
+
+FLeaderboardCompactionResult FLeaderboardStore::WriteCompactedSnapshot(const uint8* SnapshotBytes, int64 SnapshotSize,
+	const FString& FrozenLogPath, uint32 NextGeneration, const FString& OutPath)
+{
+	FLeaderboardCompactionResult Result;
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Open() checked the frozen log's header, or RotateLog() just wrote it
+	TArray<uint8> LogBytes;
+	TArray<FLeaderboardEntry> Frozen;
+	if (FFileHelper::LoadFileToArray(LogBytes, *FrozenLogPath, FILEREAD_Silent))
+	{
+		ParseLog(LogBytes, Frozen);
+	}
+	Algo::SortBy(Frozen, &FLeaderboardEntry::Score);
+
+	FPlayerNameTable Names;
+	TArray<FLeaderboardSnapshotEntry> Entries;
+	GatherSorted(SnapshotBytes, SnapshotSize, Frozen, Names, Entries);
+
+	TArray<uint8> Bytes;
+	SerializeSnapshot(Entries, Names, NextGeneration, Bytes);
+
+	Result.bWritten = FFileHelper::SaveArrayToFile(Bytes, *OutPath);
+	Result.NumEntries = Entries.Num();
+	Result.NumBytes = Bytes.Num();
+	Result.Seconds = FPlatformTime::Seconds() - StartTime;
+	return Result;
+}
+
+bool FLeaderboardStore::RotateLog()
+{
+	// Runs from here on go to a new log one generation up; the frozen one is the compaction's input
+	LogWriter.Reset();
+	if (!IFileManager::Get().Move(*FrozenLogPath, *LogPath, true))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Leaderboard compaction: could not freeze %s"), *LogPath);
+		bCompactionFailed = true;
+		OpenLogWriter();
+		return false;
+	}
+
+	FrozenLogGeneration = LogGeneration;
+	bHasFrozenLog = true;
+	if (!ResetLog(FrozenLogGeneration + 1))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Leaderboard log %s could not be reset"), *LogPath);
+		return false;
+	}
+	return true;
+}
+
+void FLeaderboardStore::StartCompaction()
+{
+	// The snapshot stays mapped and the frozen log untouched until FinishCompaction()
+	const uint8* SnapshotBytes = Data;
+	const int64 SnapshotSize = DataSize;
+	const FString InputPath = FrozenLogPath;
+	const uint32 NextGeneration = FrozenLogGeneration + 1;
+	const FString OutPath = SnapshotPath + TEXT(".tmp");
+
+	CompactionTask = Async(EAsyncExecution::ThreadPool, [SnapshotBytes, SnapshotSize, InputPath, NextGeneration, OutPath]()
+	{
+		return WriteCompactedSnapshot(SnapshotBytes, SnapshotSize, InputPath, NextGeneration, OutPath);
+	});
+}
+
+bool FLeaderboardStore::FinishCompaction()
+{
+	const FLeaderboardCompactionResult Result = CompactionTask.Get();
+	CompactionTask.Reset();
+
+	const FString TempPath = SnapshotPath + TEXT(".tmp");
+	if (!Result.bWritten)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Leaderboard compaction: could not write %s"), *TempPath);
+		bCompactionFailed = true;
+		return false;
+	}
+
+	// The mapped file cannot be replaced on every platform while it is mapped
+	LogWriter.Reset();
+	UnmapSnapshot();
+
+	const bool bSwapped = IFileManager::Get().Move(*SnapshotPath, *TempPath, true);
+	MapSnapshot();
+	if (!bSwapped)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Leaderboard compaction: could not replace %s"), *SnapshotPath);
+		bCompactionFailed = true;
+		OpenLogWriter();
+		return false;
+	}
+
+	// The new snapshot holds the frozen log; only the runs logged since it was frozen stay recent
+	IFileManager::Get().Delete(*FrozenLogPath, false, false, true);
+	bHasFrozenLog = false;
+	Recent = MakeUnique<FScoreBST>();
+	if (!ReplayLog(GetSnapshotGeneration()))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Leaderboard log %s could not be reopened"), *LogPath);
+		return false;
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("Leaderboard compacted: %d entries, %lld bytes in %.1f ms (background)"),
+		Result.NumEntries, Result.NumBytes, Result.Seconds * 1000.0);
+	return true;
+}
+
+void FLeaderboardStore::UpdateCompaction()
+{
+	if (CompactionTask.IsValid())
+	{
+		if (CompactionTask.IsReady())
+		{
+			FinishCompaction();
+		}
+		return;
+	}
+
+	// A failed compaction is retried by the next Open(), not every frame
+	if (!IsOpen() || bCompactionFailed)
+		return;
+
+	if (bHasFrozenLog || (NeedsCompaction() && RotateLog()))
+	{
+		StartCompaction();
+	}
+}
+
+bool FLeaderboardStore::Compact()
+{
+	if (!IsOpen())
+		return false;
+
+	if (!CompactionTask.IsValid())
+	{
+		if (!bHasFrozenLog && !RotateLog())
+			return false;
+		StartCompaction();
+	}
+
+	CompactionTask.Wait();
+	return FinishCompaction();
+}
+
+// ===== QUERIES =====
+
+int32 FLeaderboardStore::Num() const
+{
+	return GetSnapshotNum() + (Recent ? Recent->GetNodeCount() : 0);
+}
+
+int32 FLeaderboardStore::GetRank(int32 Score) const
+{
+	const int32 SnapshotGreater = GetSnapshotNum() - SnapshotUpperBound(Score);
+	const int32 RecentGreater = Recent ? Recent->CountGreater(Score) : 0;
+	return 1 + SnapshotGreater + RecentGreater;
+}
+
+TArray<FLeaderboardEntry> FLeaderboardStore::GetTopScores(int32 Count) const
+{
+	TArray<FLeaderboardEntry> TopScores;
+	if (!Recent)
+		return TopScores;
+
+	// Both sources are read highest first and merged until Count entries
+	const TArray<FScoreNode*> RecentTop = Recent->GetTopScores(Count);
+	const FLeaderboardSnapshotEntry* Snapshot = GetSnapshotEntries();
+	int32 i = GetSnapshotNum() - 1;
+	int32 j = 0;
+
+	TopScores.Reserve(FMath::Min(Count, Num()));
+	while (TopScores.Num() < Count && (i >= 0 || j < RecentTop.Num()))
+	{
+		FLeaderboardEntry& Entry = TopScores.AddDefaulted_GetRef();
+		if (j >= RecentTop.Num() || (i >= 0 && Snapshot[i].Score > RecentTop[j]->Score))
+		{
+			Entry.Score = Snapshot[i].Score;
+			Entry.PlayerName = GetSnapshotName(Snapshot[i].NameId);
+			i--;
+		}
+		else
+		{
+			Entry.Score = RecentTop[j]->Score;
+			Entry.PlayerName = Recent->GetPlayerName(RecentTop[j]);
+			j++;
+		}
+	}
+	return TopScores;
+}
+
+void FLeaderboardStore::LoadInto(FScoreBST& Tree) const
+{
+	if (!Recent)
+	{
+		Tree.Clear();
+		return;
+	}
+
+	TArray<FLeaderboardEntry> RecentSorted;
+	RecentSorted.Reserve(Recent->GetNodeCount());
+	for (const FScoreNode* Node : Recent->InOrderTraversal())
+	{
+		RecentSorted.Add({ Node->Score, Recent->GetPlayerName(Node) });
+	}
+
+	TArray<FLeaderboardSnapshotEntry> Entries;
+	GatherSorted(Data, DataSize, RecentSorted, Tree.GetNameTable(), Entries);
+
+	// The tree orders ties by player ID, and names were just renumbered: re-sort each run of equal scores
+	for (int32 First = 0; First < Entries.Num(); )
+	{
+		int32 End = First + 1;
+		while (End < Entries.Num() && Entries[End].Score == Entries[First].Score)
+		{
+			End++;
+		}
+		if (End - First > 1)
+		{
+			Algo::SortBy(MakeArrayView(Entries.GetData() + First, End - First), &FLeaderboardSnapshotEntry::NameId);
+		}
+		First = End;
+	}
+
+	TArray<int32> Scores;
+	TArray<uint32> PlayerIds;
+	Scores.SetNumUninitialized(Entries.Num());
+	PlayerIds.SetNumUninitialized(Entries.Num());
+	for (int32 i = 0; i < Entries.Num(); i++)
+	{
+		Scores[i] = Entries[i].Score;
+		PlayerIds[i] = Entries[i].NameId;
+	}
+
+	Tree.BuildFromSorted(Scores, PlayerIds);
+}
@@ -0,0 +1,191 @@
+// LeaderboardStore.h - Persistent leaderboard: memory-mapped snapshot + append-only log
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+
+class FArchive;
+class FScoreBST;
+class FPlayerNameTable;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+// ===== BINARY FORMAT =====
+// Snapshot (Scores.snap), little-endian, 4-byte aligned, read in place:
+//   [Header][Entries: NumEntries, ascending score][Name offsets: NumNames + 1][UTF-8 name bytes]
+// Log (Scores.log): [Header] then one record per finished run:
+//   [int32 Score][uint32 NameBytes][UTF-8 name]
+// Generations make compaction crash-safe: a snapshot already contains every
+// log whose generation is below its NextLogGeneration, so such a log is dropped.
+// Compaction first renames the log to Scores.frozen.log and starts a new log one
+// generation up, so runs keep landing while the frozen one is folded in
+
+#define LEADERBOARD_SNAPSHOT_MAGIC 0x534E4252 // "RBNS"
+#define LEADERBOARD_LOG_MAGIC 0x474C4252 // "RBLG"
+#define LEADERBOARD_FORMAT_VERSION 1
+#define LEADERBOARD_MAX_NAME_CHARS 64
+
+struct FLeaderboardSnapshotHeader
+{
+	uint32 Magic;
+	uint32 Version;
+	uint32 NextLogGeneration;
+	uint32 NumEntries;
+	uint32 NumNames;
+	uint32 EntriesOffset;
+	uint32 NameOffsetsOffset;
+	uint32 NameDataOffset;
+	uint32 TotalSize;
+};
+
+struct FLeaderboardSnapshotEntry
+{
+	int32 Score;
+	uint32 NameId;  // Index into the snapshot's name offsets
+};
+
+struct FLeaderboardLogHeader
+{
+	uint32 Magic;
+	uint32 Version;
+	uint32 Generation;
+	uint32 Reserved;
+};
+
+struct FLeaderboardLogRecord
+{
+	int32 Score;
+	uint32 NameBytes;
+};
+
+static_assert(sizeof(FLeaderboardSnapshotHeader) == 36, "Leaderboard snapshot header layout changed");
+static_assert(sizeof(FLeaderboardSnapshotEntry) == 8, "Leaderboard snapshot entry layout changed");
+static_assert(sizeof(FLeaderboardLogHeader) == 16, "Leaderboard log header layout changed");
+static_assert(sizeof(FLeaderboardLogRecord) == 8, "Leaderboard log record layout changed");
+
+struct FLeaderboardEntry
+{
+	int32 Score;
+	FString PlayerName;
+};
+
+// What a background compaction wrote beside the live snapshot
+struct FLeaderboardCompactionResult
+{
+	bool bWritten = false;
+	int32 NumEntries = 0;
+	int64 NumBytes = 0;
+	double Seconds = 0.0;
+};
+
+/**
+ * All-time leaderboard kept on disk
+ * Open() maps the snapshot and replays only the log written since the last
+ * compaction, so startup cost does not grow with the number of entries.
+ * Once the log reaches the threshold, UpdateCompaction() freezes it and folds
+ * it into a new snapshot on a pool thread; the finished snapshot is swapped in
+ * by a later UpdateCompaction(), so neither Open() nor Append() pays for it.
+ * Queries run against the mapped snapshot and a small in-memory tree of
+ * recent entries; LoadInto() builds a full FScoreBST when one is needed.
+ * Time Complexity: O(1) append (amortized), O(log n) rank, O(log n + K) top-K,
+ * O(n) bulk load, O(n) compaction on a pool thread (the caller only renames
+ * the log, swaps the file and replays the runs logged meanwhile)
+ */
+class FLeaderboardStore
+{
+private:
+	FString SnapshotPath;
+	FString LogPath;
+
+	// Snapshot, mapped read-only (or loaded where mapping is unavailable)
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	TArray64<uint8> FallbackData;
+	const uint8* Data;
+	int64 DataSize;
+
+	// Entries appended since the snapshot was written (mirrors the frozen and live logs)
+	TUniquePtr<FScoreBST> Recent;
+	TUniquePtr<FArchive> LogWriter;
+	uint32 LogGeneration;
+	int32 CompactThreshold;
+
+	// Compaction in flight: it reads the mapped snapshot and the frozen log, so
+	// neither changes until FinishCompaction()
+	FString FrozenLogPath;
+	uint32 FrozenLogGeneration;
+	bool bHasFrozenLog;
+	bool bCompactionFailed;
+	TFuture<FLeaderboardCompactionResult> CompactionTask;
+
+public:
+	FLeaderboardStore();
+	~FLeaderboardStore();
+
+	// Directory holds Scores.snap and Scores.log; created if missing
+	bool Open(const FString& Directory);
+	void Close();
+	bool IsOpen() const { return LogWriter.IsValid(); }
+
+	// Durable once this returns true; never compacts, so finishing a run stays cheap
+	bool Append(int32 Score, const FString& PlayerName);
+
+	// Call every frame (or between requests) from the thread that owns the store:
+	// starts a background compaction once the log reaches the threshold and swaps
+	// in the result when it is done. A failed compaction is retried by the next Open()
+	void UpdateCompaction();
+
+	// Blocking compaction, for tools and tests
+	bool Compact();
+	bool NeedsCompaction() const;
+	bool IsCompacting() const { return CompactionTask.IsValid(); }
+	void SetCompactThreshold(int32 NumLogEntries) { CompactThreshold = FMath::Max(NumLogEntries, 1); }
+
+	// Queries over snapshot + recent entries
+	int32 Num() const;
+	int32 GetRank(int32 Score) const;   // 1 + number of higher scores
+	TArray<FLeaderboardEntry> GetTopScores(int32 Count) const;
+
+	// Rebuild Tree with every stored entry - O(n), no rebalancing
+	void LoadInto(FScoreBST& Tree) const;
+
+	// Header and table bounds of a snapshot image (name bytes are checked on access)
+	static bool IsValidSnapshot(const uint8* Bytes, int64 NumBytes);
+
+	// Sorted (ascending) entries + their name table -> snapshot image
+	static void SerializeSnapshot(const TArray<FLeaderboardSnapshotEntry>& Entries, const FPlayerNameTable& Names,
+		uint32 NextLogGeneration, TArray<uint8>& OutBytes);
+
+private:
+	bool MapSnapshot();
+	void UnmapSnapshot();
+	bool ValidateSnapshot() const;
+	bool ReplayLog(uint32 MinGeneration);
+	void ReplayFrozenLog(uint32 SnapshotGeneration);
+	bool ResetLog(uint32 Generation);
+	bool OpenLogWriter();
+
+	bool RotateLog();
+	void StartCompaction();
+	bool FinishCompaction();
+
+	const FLeaderboardSnapshotHeader& GetHeader() const { return *reinterpret_cast<const FLeaderboardSnapshotHeader*>(Data); }
+	const FLeaderboardSnapshotEntry* GetSnapshotEntries() const;
+	int32 GetSnapshotNum() const { return Data ? GetHeader().NumEntries : 0; }
+	uint32 GetSnapshotGeneration() const { return Data ? GetHeader().NextLogGeneration : 0; }
+	FString GetSnapshotName(uint32 NameId) const { return ReadSnapshotName(Data, DataSize, NameId); }
+	int32 SnapshotUpperBound(int32 Score) const;
+
+	// Static so the compaction task can run them without touching the store
+	static FString ReadSnapshotName(const uint8* Bytes, int64 NumBytes, uint32 NameId);
+
+	// Whole records of a log image; returns the bytes they span
+	static int32 ParseLog(const TArray<uint8>& Bytes, TArray<FLeaderboardEntry>& OutEntries);
+
+	// Snapshot image + ascending entries -> every entry in ascending order, names interned into Names
+	static void GatherSorted(const uint8* SnapshotBytes, int64 SnapshotSize, const TArray<FLeaderboardEntry>& RecentSorted,
+		FPlayerNameTable& Names, TArray<FLeaderboardSnapshotEntry>& OutEntries);
+
+	static FLeaderboardCompactionResult WriteCompactedSnapshot(const uint8* SnapshotBytes, int64 SnapshotSize,
+		const FString& FrozenLogPath, uint32 NextGeneration, const FString& OutPath);
+};
@@ -0,0 +1,119 @@
+// LocalScoreServer.cpp - HTTP route, de-duplication and storage for submitted runs
+#include "LocalScoreServer.h"
+#include "ScoreSubmitter.h"
+#include "HttpPath.h"
+#include "HttpServerModule.h"
+#include "HttpServerRequest.h"
+#include "HttpServerResponse.h"
+#include "IHttpRouter.h"
+#include "JsonObjectConverter.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+FLocalScoreServer::FLocalScoreServer()
+	: Requests(0), Accepted(0), Duplicates(0), InjectedFailures(0)
+{
+}
+
+FLocalScoreServer::~FLocalScoreServer()
+{
+	Stop();
+}
+
+bool FLocalScoreServer::Start(uint32 Port, const FString& Directory)
+{
+	Stop();
+
+	if (!Store.Open(Directory))
+		return false;
+
+	// Seen IDs survive restarts, so clients resending after a crash are still de-duplicated
+	RunIdsPath = FPaths::Combine(Directory, TEXT("RunIds.txt"));
+	TArray<FString> Lines;
+	FFileHelper::LoadFileToStringArray(Lines, *RunIdsPath);
+	SeenRunIds.Reset();
+	SeenRunIds.Append(Lines);
+
+	Router = FHttpServerModule::Get().GetHttpRouter(Port, true);
+	if (!Router)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Score server: could not bind port %u"), Port);
+		Store.Close();
+		return false;
+	}
+
+	RouteHandle = Router->BindRoute(FHttpPath(TEXT("/scores")), EHttpServerRequestVerbs::VERB_POST,
+		FHttpRequestHandler::CreateRaw(this, &FLocalScoreServer::HandleSubmit));
+	FHttpServerModule::Get().StartAllListeners();
+
+	UE_LOG(LogTemp, Display, TEXT("Score server: listening on http://127.0.0.1:%u/scores (%d runs stored, %d run IDs known)"),
+		Port, Store.Num(), SeenRunIds.Num());
+	return true;
+}
+
+void FLocalScoreServer::Stop()
+{
+	if (Router && RouteHandle)
+	{
+		Router->UnbindRoute(RouteHandle);
+	}
+	RouteHandle.Reset();
+	Router.Reset();
+	Store.Close();
+}
+
+bool FLocalScoreServer::HandleSubmit(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	Requests++;
+
+	if (FailureRate > 0.0f && FMath::FRand() < FailureRate)
+	{
+		InjectedFailures++;
+		OnComplete(FHttpServerResponse::Error(EHttpServerResponseCodes::ServiceUnavail, TEXT("Unavailable"), TEXT("Injected failure")));
+		return true;
+	}
+
+	FUTF8ToTCHAR Body(reinterpret_cast<const UTF8CHAR*>(Request.Body.GetData()), Request.Body.Num());
+	FScoreSubmissionBatch Batch;
+	if (!FJsonObjectConverter::JsonObjectStringToUStruct(FString(Body.Length(), Body.Get()), &Batch))
+	{
+		OnComplete(FHttpServerResponse::Error(EHttpServerResponseCodes::BadRequest, TEXT("BadBatch"), TEXT("Body is not a run batch")));
+		return true;
+	}
+
+	FScoreSubmissionAck Ack;
+	FString NewRunIds;
+	for (const FScoreSubmission& Run : Batch.Runs)
+	{
+		bool bAlreadySeen = false;
+		SeenRunIds.Add(Run.RunId, &bAlreadySeen);
+		if (bAlreadySeen || Run.RunId.IsEmpty())
+		{
+			Ack.Duplicates++;
+			continue;
+		}
+
+		Store.Append(Run.Score, Run.PlayerName);
+		NewRunIds += Run.RunId + TEXT("\n");
+		Ack.Accepted++;
+	}
+
+	// One append per batch keeps the ID list cheap at thousands of runs per second
+	if (!NewRunIds.IsEmpty())
+	{
+		FFileHelper::SaveStringToFile(NewRunIds, *RunIdsPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM,
+			&IFileManager::Get(), FILEWRITE_Append);
+	}
+
+	// Starts a compaction once the log is long enough, or swaps in a finished one
+	Store.UpdateCompaction();
+
+	Accepted += Ack.Accepted;
+	Duplicates += Ack.Duplicates;
+
+	FString Response;
+	FJsonObjectConverter::UStructToJsonObjectString(Ack, Response, 0, 0, 0, nullptr, false);
+	OnComplete(FHttpServerResponse::Create(Response, TEXT("application/json")));
+	return true;
+}
@@ -0,0 +1,51 @@
+// LocalScoreServer.h - Offline stand-in for the leaderboard service
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HttpRouteHandle.h"
+#include "HttpResultCallback.h"
+#include "LeaderboardStore.h"
+
+class IHttpRouter;
+struct FHttpServerRequest;
+
+/**
+ * Serves POST /scores for FScoreSubmitter, backed by an FLeaderboardStore
+ * Run IDs already seen (this session or earlier ones) are acknowledged as
+ * duplicates without being stored again. FailureRate answers that share
+ * of requests with 503, to exercise client retries.
+ */
+class FLocalScoreServer
+{
+private:
+	TSharedPtr<IHttpRouter> Router;
+	FHttpRouteHandle RouteHandle;
+
+	FLeaderboardStore Store;
+	TSet<FString> SeenRunIds;
+	FString RunIdsPath;
+
+	int32 Requests;
+	int32 Accepted;
+	int32 Duplicates;
+	int32 InjectedFailures;
+
+public:
+	float FailureRate = 0.0f;
+
+	FLocalScoreServer();
+	~FLocalScoreServer();
+
+	// Directory holds the store and the list of seen run IDs
+	bool Start(uint32 Port, const FString& Directory);
+	void Stop();
+
+	int32 GetRequestCount() const { return Requests; }
+	int32 GetAcceptedCount() const { return Accepted; }
+	int32 GetDuplicateCount() const { return Duplicates; }
+	int32 GetInjectedFailureCount() const { return InjectedFailures; }
+	const FLeaderboardStore& GetStore() const { return Store; }
+
+private:
+	bool HandleSubmit(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+};
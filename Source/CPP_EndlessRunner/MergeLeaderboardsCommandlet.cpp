@@ -0,0 +1,50 @@
+// MergeLeaderboardsCommandlet.cpp - Combines leaderboard snapshots from many sessions into one
+
+#include "MergeLeaderboardsCommandlet.h"
+#include "LeaderboardMerge.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+UMergeLeaderboardsCommandlet::UMergeLeaderboardsCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UMergeLeaderboardsCommandlet::Main(const FString& Params)
+{
+	FString ShardDir;
+	FString OutPath = TEXT("Leaderboard/Merged.snap");
+	int32 NumPartitions = 0;
+
+	if (!FParse::Value(*Params, TEXT("Shards="), ShardDir))
+	{
+		UE_LOG(LogTemp, Error, TEXT("MergeLeaderboards: missing -Shards=<directory of .snap files>"));
+		return 1;
+	}
+	FParse::Value(*Params, TEXT("Out="), OutPath);
+	FParse::Value(*Params, TEXT("Partitions="), NumPartitions);
+
+	TArray<FString> ShardPaths;
+	IFileManager::Get().FindFilesRecursive(ShardPaths, *ShardDir, TEXT("*.snap"), true, false);
+	if (ShardPaths.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("MergeLeaderboards: no .snap files under %s"), *ShardDir);
+		return 1;
+	}
+
+	const FString Filename = FPaths::Combine(FPaths::ProjectSavedDir(), OutPath);
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(Filename), true);
+
+	FLeaderboardMergeStats Stats;
+	if (!FLeaderboardMerge::MergeSnapshots(ShardPaths, Filename, &Stats, NumPartitions))
+		return 1;
+
+	UE_LOG(LogTemp, Display, TEXT("MergeLeaderboards: %d shards, %lld entries -> %d players in %.2f s (%d partitions, %.1f MB working memory)"),
+		Stats.NumShards, Stats.InputEntries, Stats.OutputEntries, Stats.Seconds, Stats.NumPartitions,
+		Stats.WorkingBytes / (1024.0 * 1024.0));
+	UE_LOG(LogTemp, Display, TEXT("MergeLeaderboards: wrote %s"), *Filename);
+	return 0;
+}
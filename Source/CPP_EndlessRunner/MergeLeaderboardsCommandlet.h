@@ -0,0 +1,30 @@
+// MergeLeaderboardsCommandlet.h - Combines leaderboard snapshots from many sessions into one
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MergeLeaderboardsCommandlet.generated.h"
+
+/**
+ * Merges every Scores.snap under a directory into one snapshot holding each
+ * player's best score
+ *
+ * Usage:
+ *   UnrealEditor-Cmd CPP_EndlessRunner.uproject -run=MergeLeaderboards
+ *       -Shards=D:/Collected/Leaderboards [-Out=Leaderboard/Scores.snap] [-Partitions=8]
+ *
+ * Every *.snap below -Shards is an input. -Out is relative to the project
+ * Saved directory; copying it over a store's Scores.snap (with its log
+ * removed) makes the merged board live
+ */
+UCLASS()
+class CPP_ENDLESSRUNNER_API UMergeLeaderboardsCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMergeLeaderboardsCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,302 @@
+// PlayerNameIndex.h - Radix trie over interned player names for prefix search
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PlayerNameTable.h"
+
+/**
+ * Trie node; the edge into it is labelled with a run of characters
+ * Children hang off FirstChild as a sibling list sorted by first character
+ * 28 bytes; labels live in the index's shared character pool
+ */
+struct FNameTrieNode
+{
+    uint32 LabelStart;
+    uint32 LabelLength;
+    uint32 Parent;
+    uint32 FirstChild;
+    uint32 NextSibling;
+    uint32 PlayerId;   // Player whose name ends here, or FPlayerNameTable::InvalidId
+    int32 NumPlayers;  // Players on the board in this subtree, for pruning and counts
+};
+
+/**
+ * Case-insensitive prefix index over the names of the players on a board
+ * Case folds exactly as FPlayerNameTable compares names (ASCII A-Z only)
+ * Path-compressed (radix) trie: a chain of single-child nodes is one edge,
+ * so there are at most two nodes per name however long names get. Each
+ * node counts the players below it, which makes "how many match" an
+ * O(prefix) answer and lets searches skip subtrees whose players all left
+ * Players are counted per board entry: Add/Remove mirror the tree's nodes,
+ * and a name only drops out of results once its last entry is gone (trie
+ * nodes themselves are kept, like the interned names)
+ * Time Complexity: O(name) add/first-add, O(depth) remove,
+ * O(prefix + results) search, alphabetical order
+ */
+class FPlayerNameIndex
+{
+private:
+    TSharedRef<FPlayerNameTable> Names;
+
+    TArray<FNameTrieNode> Nodes;   // 0 is the root (empty label)
+    TArray<TCHAR> CharPool;        // Folded edge labels
+
+    // By player ID (IDs are dense)
+    TArray<uint32> EntryCounts;
+    TArray<uint32> TerminalNodes;  // InvalidNode until the name is first added
+
+    static constexpr uint32 InvalidNode = MAX_uint32;
+
+public:
+    explicit FPlayerNameIndex(TSharedRef<FPlayerNameTable> InNames);
+
+    // The board gained / lost one entry of this player
+    void Add(uint32 PlayerId);
+    void Remove(uint32 PlayerId);
+    void Reset();
+
+    // Players on the board whose name starts with Prefix, ignoring case,
+    // alphabetically; returns the total number of matches, which may be
+    // more than MaxResults
+    int32 FindByPrefix(const FString& Prefix, int32 MaxResults, TArray<uint32>& OutPlayerIds) const;
+    int32 CountByPrefix(const FString& Prefix) const;
+
+    // Utility
+    int32 NumPlayers() const { return Nodes[0].NumPlayers; }
+    int32 NumNodes() const { return Nodes.Num(); }
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    // FString comparison (and so the name table) folds ASCII only: "É" and "é"
+    // are different players, so they must not share a trie path either
+    static TCHAR Fold(TCHAR Char) { return (Char >= TEXT('A') && Char <= TEXT('Z')) ? Char + (TEXT('a') - TEXT('A')) : Char; }
+
+    uint32 NewNode(uint32 Parent, uint32 LabelStart, uint32 LabelLength);
+    uint32 InsertName(uint32 PlayerId);
+    void AddToPath(uint32 Node, int32 Delta);
+
+    // Node whose subtree holds exactly the names starting with Prefix, or InvalidNode
+    uint32 FindPrefixNode(const FString& Prefix) const;
+};
+
+// ===== IMPLEMENTATION =====
+
+inline FPlayerNameIndex::FPlayerNameIndex(TSharedRef<FPlayerNameTable> InNames)
+    : Names(InNames)
+{
+    Reset();
+}
+
+inline void FPlayerNameIndex::Reset()
+{
+    Nodes.Reset();
+    CharPool.Reset();
+    EntryCounts.Reset();
+    TerminalNodes.Reset();
+    NewNode(InvalidNode, 0, 0);
+}
+
+inline uint32 FPlayerNameIndex::NewNode(uint32 Parent, uint32 LabelStart, uint32 LabelLength)
+{
+    FNameTrieNode& Node = Nodes.AddDefaulted_GetRef();
+    Node.LabelStart = LabelStart;
+    Node.LabelLength = LabelLength;
+    Node.Parent = Parent;
+    Node.FirstChild = InvalidNode;
+    Node.NextSibling = InvalidNode;
+    Node.PlayerId = FPlayerNameTable::InvalidId;
+    Node.NumPlayers = 0;
+    return static_cast<uint32>(Nodes.Num() - 1);
+}
+
+inline void FPlayerNameIndex::Add(uint32 PlayerId)
+{
+    if (PlayerId >= static_cast<uint32>(EntryCounts.Num()))
+    {
+        const int32 NewNum = FMath::Max(static_cast<int32>(PlayerId) + 1, Names->Num());
+        EntryCounts.SetNumZeroed(NewNum);
+        TerminalNodes.Reserve(NewNum);
+        while (TerminalNodes.Num() < NewNum)
+        {
+            TerminalNodes.Add(InvalidNode);
+        }
+    }
+
+    if (EntryCounts[PlayerId]++ > 0)
+        return;
+
+    uint32 Node = TerminalNodes[PlayerId];
+    if (Node == InvalidNode)
+    {
+        Node = InsertName(PlayerId);
+        TerminalNodes[PlayerId] = Node;
+    }
+    AddToPath(Node, 1);
+}
+
+inline void FPlayerNameIndex::Remove(uint32 PlayerId)
+{
+    if (PlayerId >= static_cast<uint32>(EntryCounts.Num()) || EntryCounts[PlayerId] == 0)
+        return;
+
+    if (--EntryCounts[PlayerId] == 0)
+    {
+        AddToPath(TerminalNodes[PlayerId], -1);
+    }
+}
+
+inline void FPlayerNameIndex::AddToPath(uint32 Node, int32 Delta)
+{
+    for (; Node != InvalidNode; Node = Nodes[Node].Parent)
+    {
+        Nodes[Node].NumPlayers += Delta;
+    }
+}
+
+inline uint32 FPlayerNameIndex::InsertName(uint32 PlayerId)
+{
+    const FString& Name = Names->GetName(PlayerId);
+    const int32 Length = Name.Len();
+
+    uint32 Node = 0;
+    int32 Pos = 0;
+    while (Pos < Length)
+    {
+        const TCHAR Next = Fold(Name[Pos]);
+
+        // Children are sorted by first character; find the match or the insertion point
+        uint32 Prev = InvalidNode;
+        uint32 Child = Nodes[Node].FirstChild;
+        while (Child != InvalidNode && CharPool[Nodes[Child].LabelStart] < Next)
+        {
+            Prev = Child;
+            Child = Nodes[Child].NextSibling;
+        }
+
+        if (Child == InvalidNode || CharPool[Nodes[Child].LabelStart] != Next)
+        {
+            // New leaf holding the rest of the name
+            const uint32 LabelStart = static_cast<uint32>(CharPool.Num());
+            for (int32 i = Pos; i < Length; i++)
+            {
+                CharPool.Add(Fold(Name[i]));
+            }
+            const uint32 Leaf = NewNode(Node, LabelStart, Length - Pos);
+            Nodes[Leaf].NextSibling = Child;
+            (Prev == InvalidNode ? Nodes[Node].FirstChild : Nodes[Prev].NextSibling) = Leaf;
+            Nodes[Leaf].PlayerId = PlayerId;
+            return Leaf;
+        }
+
+        // Follow the edge as far as the name agrees with it
+        const uint32 LabelStart = Nodes[Child].LabelStart;
+        const uint32 LabelLength = Nodes[Child].LabelLength;
+        uint32 Common = 1;
+        while (Common < LabelLength && Pos + static_cast<int32>(Common) < Length
+            && CharPool[LabelStart + Common] == Fold(Name[Pos + Common]))
+        {
+            Common++;
+        }
+
+        if (Common < LabelLength)
+        {
+            // Split the edge: a new node takes the shared part and Child's place among the siblings
+            const uint32 Split = NewNode(Node, LabelStart, Common);
+            Nodes[Split].NextSibling = Nodes[Child].NextSibling;
+            Nodes[Split].FirstChild = Child;
+            Nodes[Split].NumPlayers = Nodes[Child].NumPlayers;
+            (Prev == InvalidNode ? Nodes[Node].FirstChild : Nodes[Prev].NextSibling) = Split;
+
+            Nodes[Child].Parent = Split;
+            Nodes[Child].NextSibling = InvalidNode;
+            Nodes[Child].LabelStart += Common;
+            Nodes[Child].LabelLength -= Common;
+            Child = Split;
+        }
+
+        Node = Child;
+        Pos += Common;
+    }
+
+    // The name ends on an existing node (a prefix of another name, or a split point)
+    Nodes[Node].PlayerId = PlayerId;
+    return Node;
+}
+
+inline uint32 FPlayerNameIndex::FindPrefixNode(const FString& Prefix) const
+{
+    const int32 Length = Prefix.Len();
+    uint32 Node = 0;
+    int32 Pos = 0;
+
+    while (Pos < Length)
+    {
+        const TCHAR Next = Fold(Prefix[Pos]);
+        uint32 Child = Nodes[Node].FirstChild;
+        while (Child != InvalidNode && CharPool[Nodes[Child].LabelStart] < Next)
+        {
+            Child = Nodes[Child].NextSibling;
+        }
+        if (Child == InvalidNode || CharPool[Nodes[Child].LabelStart] != Next)
+            return InvalidNode;
+
+        // The prefix may end part-way along the edge; everything below still matches
+        const FNameTrieNode& Edge = Nodes[Child];
+        for (uint32 i = 1; i < Edge.LabelLength && Pos + static_cast<int32>(i) < Length; i++)
+        {
+            if (CharPool[Edge.LabelStart + i] != Fold(Prefix[Pos + i]))
+                return InvalidNode;
+        }
+
+        Node = Child;
+        Pos += Edge.LabelLength;
+    }
+    return Node;
+}
+
+inline int32 FPlayerNameIndex::CountByPrefix(const FString& Prefix) const
+{
+    const uint32 Node = FindPrefixNode(Prefix);
+    return Node != InvalidNode ? Nodes[Node].NumPlayers : 0;
+}
+
+inline int32 FPlayerNameIndex::FindByPrefix(const FString& Prefix, int32 MaxResults, TArray<uint32>& OutPlayerIds) const
+{
+    OutPlayerIds.Reset();
+
+    const uint32 Start = FindPrefixNode(Prefix);
+    if (Start == InvalidNode || Nodes[Start].NumPlayers == 0)
+        return 0;
+
+    // Pre-order with siblings in character order is alphabetical order
+    TArray<uint32, TInlineAllocator<64>> Stack;
+    Stack.Push(Start);
+    while (Stack.Num() > 0 && OutPlayerIds.Num() < MaxResults)
+    {
+        const uint32 Index = Stack.Pop(EAllowShrinking::No);
+        const FNameTrieNode& Node = Nodes[Index];
+
+        // The sibling comes after this whole subtree (the start node's siblings are out of range)
+        if (Index != Start && Node.NextSibling != InvalidNode)
+        {
+            Stack.Push(Node.NextSibling);
+        }
+        if (Node.NumPlayers == 0)
+            continue;
+
+        if (Node.PlayerId != FPlayerNameTable::InvalidId && EntryCounts[Node.PlayerId] > 0)
+        {
+            OutPlayerIds.Add(Node.PlayerId);
+        }
+        if (Node.FirstChild != InvalidNode)
+        {
+            Stack.Push(Node.FirstChild);
+        }
+    }
+    return Nodes[Start].NumPlayers;
+}
+
+inline SIZE_T FPlayerNameIndex::GetAllocatedSize() const
+{
+    return Nodes.GetAllocatedSize() + CharPool.GetAllocatedSize() + EntryCounts.GetAllocatedSize() + TerminalNodes.GetAllocatedSize();
+}
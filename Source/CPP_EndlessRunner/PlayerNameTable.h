@@ -0,0 +1,59 @@
+// PlayerNameTable.h - Interned player names referenced by a small integer ID
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Stores each distinct player name once; score entries keep only the ID
+ * IDs are dense (0..Num-1) and never reused, so they can index side arrays
+ * Names compare case-insensitively (ASCII letters only), like FString keys
+ * everywhere else
+ * Time Complexity: O(1) average intern, O(1) lookup
+ */
+class FPlayerNameTable
+{
+private:
+    TArray<FString> Names;
+    TMap<FString, uint32> NameToId;
+
+public:
+    static constexpr uint32 InvalidId = MAX_uint32;
+
+    uint32 Intern(const FString& Name)
+    {
+        if (const uint32* Existing = NameToId.Find(Name))
+        {
+            return *Existing;
+        }
+
+        const uint32 Id = static_cast<uint32>(Names.Add(Name));
+        NameToId.Add(Name, Id);
+        return Id;
+    }
+
+    // InvalidId if the name was never interned
+    uint32 FindId(const FString& Name) const
+    {
+        const uint32* Existing = NameToId.Find(Name);
+        return Existing ? *Existing : InvalidId;
+    }
+
+    const FString& GetName(uint32 Id) const
+    {
+        static const FString Unknown;
+        return Id < static_cast<uint32>(Names.Num()) ? Names[Id] : Unknown;
+    }
+
+    int32 Num() const { return Names.Num(); }
+
+    SIZE_T GetAllocatedSize() const
+    {
+        SIZE_T Bytes = Names.GetAllocatedSize() + NameToId.GetAllocatedSize();
+        for (const FString& Name : Names)
+        {
+            // Stored twice: once in Names, once as the map key
+            Bytes += 2 * Name.GetAllocatedSize();
+        }
+        return Bytes;
+    }
+};
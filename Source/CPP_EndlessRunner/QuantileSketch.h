@@ -0,0 +1,364 @@
+// QuantileSketch.h - Mergeable KLL sketch for score percentiles in bounded memory
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RadixSort.h"
+#include "SortedSearch.h"
+#include "Varint.h"
+
+#define QUANTILE_SKETCH_MAGIC 0x4B534B51 // "QKSK"
+#define QUANTILE_SKETCH_VERSION 1
+
+/**
+ * KLL quantile sketch over int32 scores
+ * Level h keeps items that each stand for 2^h runs. When the sketch is full,
+ * the lowest full level is sorted and every other item (random offset)
+ * moves up a level, so total weight stays exact while the item count stays
+ * around 3 * K no matter how many runs are added
+ * Rank error is roughly 1.7 / K of the population (K = 200: ~1%)
+ * Sketches from different sessions or servers merge into one
+ * Time Complexity: O(1) amortized add, O(m) first query after a change
+ * (m = retained items, radix sorted), O(log m) after that
+ */
+class FQuantileSketch
+{
+private:
+    static constexpr int32 MinLevelCapacity = 8;
+
+    TArray<TArray<int32>> Levels;
+    TArray<int32> LevelCapacities;
+    int32 K;
+    int64 Count;
+    int32 MinValue;
+    int32 MaxValue;
+    int32 NumRetained;
+    int32 TotalCapacity;
+    uint32 RandomState;
+
+    // Every retained item in score order with the weight at or below it, built on first query
+    mutable TArray<int32> SortedValues;
+    mutable TArray<int64> CumulativeWeights;
+    mutable bool bSortedValid;
+
+public:
+    explicit FQuantileSketch(int32 InK = 200);
+
+    void Reset();
+    void Add(int32 Score);
+
+    // Fold another sketch in; the result keeps the smaller K of the two
+    void Merge(const FQuantileSketch& Other);
+
+    // Estimated runs scoring below / above Score
+    int64 GetCountBelow(int32 Score) const;
+    int64 GetCountAbove(int32 Score) const;
+    int64 GetRank(int32 Score) const { return 1 + GetCountAbove(Score); } // 1 + number of higher scores
+
+    // Share of runs a score beats, 0-100
+    float GetPercentile(int32 Score) const;
+
+    // Score at a fraction of the population (0 = lowest, 1 = highest)
+    int32 GetQuantile(double Fraction) const;
+
+    // Utility
+    int64 Num() const { return Count; }
+    bool IsEmpty() const { return Count == 0; }
+    int32 GetK() const { return K; }
+    int32 GetMin() const { return MinValue; }
+    int32 GetMax() const { return MaxValue; }
+    int32 GetRetainedCount() const { return NumRetained; }
+    SIZE_T GetAllocatedSize() const;
+
+    // Levels sorted and delta/varint coded, a few KB at most
+    void Serialize(TArray<uint8>& OutBytes) const;
+    bool Load(const TArray<uint8>& Bytes);
+
+private:
+    void UpdateCapacity();
+    void CompressOnce();
+    bool RandomBit();
+    void BuildSorted() const;
+};
+
+// ===== IMPLEMENTATION =====
+
+inline FQuantileSketch::FQuantileSketch(int32 InK)
+    : K(FMath::Max(InK, MinLevelCapacity))
+{
+    Reset();
+}
+
+inline void FQuantileSketch::Reset()
+{
+    Levels.Reset();
+    Levels.AddDefaulted();
+    Count = 0;
+    MinValue = MAX_int32;
+    MaxValue = MIN_int32;
+    NumRetained = 0;
+    RandomState = 0x9E3779B9;
+    bSortedValid = false;
+    UpdateCapacity();
+}
+
+// Capacities shrink by 2/3 per level below the top one
+// Only changes when a level is added or K shrinks, so it is cached
+inline void FQuantileSketch::UpdateCapacity()
+{
+    LevelCapacities.SetNum(Levels.Num());
+    TotalCapacity = 0;
+
+    double Capacity = K;
+    for (int32 Level = Levels.Num() - 1; Level >= 0; Level--)
+    {
+        LevelCapacities[Level] = FMath::Max(MinLevelCapacity, static_cast<int32>(FMath::CeilToDouble(Capacity)));
+        TotalCapacity += LevelCapacities[Level];
+        Capacity *= 2.0 / 3.0;
+    }
+}
+
+inline bool FQuantileSketch::RandomBit()
+{
+    // xorshift32: cheap, and fixed-seeded so runs are reproducible
+    RandomState ^= RandomState << 13;
+    RandomState ^= RandomState >> 17;
+    RandomState ^= RandomState << 5;
+    return (RandomState & 1) != 0;
+}
+
+inline void FQuantileSketch::Add(int32 Score)
+{
+    Levels[0].Add(Score);
+    Count++;
+    NumRetained++;
+    MinValue = FMath::Min(MinValue, Score);
+    MaxValue = FMath::Max(MaxValue, Score);
+    bSortedValid = false;
+
+    if (NumRetained >= TotalCapacity)
+    {
+        CompressOnce();
+    }
+}
+
+// Halve the lowest level at capacity into the one above
+inline void FQuantileSketch::CompressOnce()
+{
+    int32 Level = 0;
+    while (Level < Levels.Num() - 1 && Levels[Level].Num() < LevelCapacities[Level])
+    {
+        Level++;
+    }
+
+    const bool bNewLevel = Level == Levels.Num() - 1;
+    if (bNewLevel)
+    {
+        Levels.AddDefaulted();
+    }
+
+    TArray<int32>& Items = Levels[Level];
+    TArray<int32>& Above = Levels[Level + 1];
+    Items.Sort();
+
+    // An odd item out stays behind so only pairs are halved and weight is preserved
+    const int32 Keep = Items.Num() & 1;
+    const int32 Offset = RandomBit() ? 1 : 0;
+    for (int32 i = Keep + Offset; i < Items.Num(); i += 2)
+    {
+        Above.Add(Items[i]);
+    }
+
+    const int32 Compacted = Items.Num() - Keep;
+    Items.SetNum(Keep, EAllowShrinking::No);
+    NumRetained -= Compacted / 2;
+    if (bNewLevel)
+    {
+        UpdateCapacity();
+    }
+}
+
+inline void FQuantileSketch::Merge(const FQuantileSketch& Other)
+{
+    if (Other.IsEmpty())
+        return;
+
+    K = FMath::Min(K, Other.K);
+    while (Levels.Num() < Other.Levels.Num())
+    {
+        Levels.AddDefaulted();
+    }
+    for (int32 Level = 0; Level < Other.Levels.Num(); Level++)
+    {
+        Levels[Level].Append(Other.Levels[Level]);
+    }
+
+    Count += Other.Count;
+    NumRetained += Other.NumRetained;
+    MinValue = FMath::Min(MinValue, Other.MinValue);
+    MaxValue = FMath::Max(MaxValue, Other.MaxValue);
+    bSortedValid = false;
+    UpdateCapacity();
+
+    while (NumRetained >= TotalCapacity)
+    {
+        CompressOnce();
+    }
+}
+
+inline void FQuantileSketch::BuildSorted() const
+{
+    if (bSortedValid)
+        return;
+
+    struct FWeighted
+    {
+        int32 Value;
+        int64 Weight;
+    };
+
+    TArray<FWeighted> Items;
+    Items.Reserve(NumRetained);
+    for (int32 Level = 0; Level < Levels.Num(); Level++)
+    {
+        for (int32 Value : Levels[Level])
+        {
+            Items.Add({ Value, int64(1) << Level });
+        }
+    }
+    FRadixSort::SortByKey(TArrayView<FWeighted>(Items), [](const FWeighted& Item) { return Item.Value; });
+
+    SortedValues.SetNumUninitialized(Items.Num());
+    CumulativeWeights.SetNumUninitialized(Items.Num());
+    int64 Total = 0;
+    for (int32 i = 0; i < Items.Num(); i++)
+    {
+        Total += Items[i].Weight;
+        SortedValues[i] = Items[i].Value;
+        CumulativeWeights[i] = Total;
+    }
+    bSortedValid = true;
+}
+
+inline int64 FQuantileSketch::GetCountBelow(int32 Score) const
+{
+    BuildSorted();
+    const int32 Index = FSortedSearch::LowerBound(SortedValues, Score);
+    return Index > 0 ? CumulativeWeights[Index - 1] : 0;
+}
+
+inline int64 FQuantileSketch::GetCountAbove(int32 Score) const
+{
+    BuildSorted();
+    const int32 Index = FSortedSearch::UpperBound(SortedValues, Score);
+    return Count - (Index > 0 ? CumulativeWeights[Index - 1] : 0);
+}
+
+inline float FQuantileSketch::GetPercentile(int32 Score) const
+{
+    if (Count == 0)
+        return 0.0f;
+    return static_cast<float>(100.0 * GetCountBelow(Score) / Count);
+}
+
+inline int32 FQuantileSketch::GetQuantile(double Fraction) const
+{
+    if (Count == 0)
+        return 0;
+    if (Fraction <= 0.0)
+        return MinValue;
+    if (Fraction >= 1.0)
+        return MaxValue;
+
+    BuildSorted();
+    const int64 Target = static_cast<int64>(Fraction * Count);
+    const int32 Index = FSortedSearch::UpperBound(CumulativeWeights, Target);
+    return SortedValues[FMath::Min(Index, SortedValues.Num() - 1)];
+}
+
+inline SIZE_T FQuantileSketch::GetAllocatedSize() const
+{
+    SIZE_T Size = Levels.GetAllocatedSize() + LevelCapacities.GetAllocatedSize() + SortedValues.GetAllocatedSize() + CumulativeWeights.GetAllocatedSize();
+    for (const TArray<int32>& Level : Levels)
+    {
+        Size += Level.GetAllocatedSize();
+    }
+    return Size;
+}
+
+// Header: magic, version, K, levels, count (2 words), min, max
+// Then per level: item count, then items ascending as deltas (the first from min)
+inline void FQuantileSketch::Serialize(TArray<uint8>& OutBytes) const
+{
+    const uint32 Header[8] = {
+        QUANTILE_SKETCH_MAGIC, QUANTILE_SKETCH_VERSION, static_cast<uint32>(K), static_cast<uint32>(Levels.Num()),
+        static_cast<uint32>(static_cast<uint64>(Count)), static_cast<uint32>(static_cast<uint64>(Count) >> 32),
+        static_cast<uint32>(MinValue), static_cast<uint32>(MaxValue) };
+
+    OutBytes.Reset();
+    OutBytes.Append(reinterpret_cast<const uint8*>(Header), sizeof(Header));
+
+    TArray<int32> Items;
+    for (const TArray<int32>& Level : Levels)
+    {
+        Items = Level;
+        Items.Sort();
+        FVarint::Write(OutBytes, static_cast<uint32>(Items.Num()));
+
+        uint32 Previous = static_cast<uint32>(MinValue);
+        for (int32 Value : Items)
+        {
+            FVarint::Write(OutBytes, static_cast<uint32>(Value) - Previous);
+            Previous = static_cast<uint32>(Value);
+        }
+    }
+}
+
+inline bool FQuantileSketch::Load(const TArray<uint8>& Bytes)
+{
+    uint32 Header[8];
+    if (Bytes.Num() < static_cast<int32>(sizeof(Header)))
+        return false;
+    FMemory::Memcpy(Header, Bytes.GetData(), sizeof(Header));
+
+    if (Header[0] != QUANTILE_SKETCH_MAGIC || Header[1] != QUANTILE_SKETCH_VERSION || Header[3] == 0 || Header[3] > 64)
+        return false;
+
+    FQuantileSketch Loaded(static_cast<int32>(Header[2]));
+    Loaded.Levels.SetNum(static_cast<int32>(Header[3]));
+    const int64 LoadedCount = static_cast<int64>(Header[4] | (static_cast<uint64>(Header[5]) << 32));
+    Loaded.MinValue = static_cast<int32>(Header[6]);
+    Loaded.MaxValue = static_cast<int32>(Header[7]);
+
+    int32 Offset = sizeof(Header);
+    int64 Weight = 0;
+    for (int32 Level = 0; Level < Loaded.Levels.Num(); Level++)
+    {
+        uint32 NumItems = 0;
+        if (!FVarint::Read(Bytes, Offset, NumItems) || NumItems > static_cast<uint32>(Bytes.Num() - Offset))
+            return false;
+
+        TArray<int32>& Items = Loaded.Levels[Level];
+        Items.Reserve(NumItems);
+        uint32 Value = static_cast<uint32>(Loaded.MinValue);
+        for (uint32 i = 0; i < NumItems; i++)
+        {
+            uint32 Delta = 0;
+            if (!FVarint::Read(Bytes, Offset, Delta))
+                return false;
+            Value += Delta;
+            Items.Add(static_cast<int32>(Value));
+        }
+        Loaded.NumRetained += Items.Num();
+        Weight += static_cast<int64>(Items.Num()) << Level;
+    }
+
+    // Retained weights must add up to the population exactly
+    if (Offset != Bytes.Num() || Weight != LoadedCount)
+        return false;
+
+    Loaded.Count = LoadedCount;
+    Loaded.UpdateCapacity();
+
+    *this = MoveTemp(Loaded);
+    return true;
+}
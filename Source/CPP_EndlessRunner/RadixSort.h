@@ -0,0 +1,216 @@
+// RadixSort.h - Stable LSD radix sort for int32 scores and (score, payload) records
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/ParallelFor.h"
+#include <type_traits>
+
+enum class ERadixSortFlags : uint8
+{
+    None = 0,
+    Descending = 1 << 0,      // Highest key first (ties keep their input order either way)
+    SingleThreaded = 1 << 1,  // Never split across worker threads
+};
+ENUM_CLASS_FLAGS(ERadixSortFlags)
+
+/**
+ * Least-significant-digit radix sort on 32-bit keys, 8 bits per pass
+ * Cost depends only on the number of records, never on their order, so
+ * already-sorted and duplicate-heavy score lists are as fast as random ones,
+ * and nothing recurses. Passes whose digit is the same for every key are
+ * skipped (scores below 65536 take 2 passes, not 4)
+ * Large inputs are split into per-thread chunks: each chunk counts its own
+ * digits, then scatters into its own slice of every bucket, which keeps
+ * the sort stable
+ * Time Complexity: O(n) per pass, O(n) scratch memory
+ */
+class FRadixSort
+{
+public:
+    // Below this, a stable insertion sort beats building histograms
+    static constexpr int32 SmallSortThreshold = 64;
+
+    // Inputs at least this large use worker threads
+    static constexpr int32 ParallelThreshold = 1 << 18;
+    static constexpr int32 MinItemsPerChunk = 1 << 16;
+
+    static void Sort(TArrayView<int32> Keys, ERadixSortFlags Flags = ERadixSortFlags::None)
+    {
+        SortByKey(Keys, [](int32 Key) { return Key; }, Flags);
+    }
+
+    // Sorts whole records by an int32 key; the payload travels with the key
+    template<typename RecordType, typename KeyFuncType>
+    static void SortByKey(TArrayView<RecordType> Records, KeyFuncType GetKey, ERadixSortFlags Flags = ERadixSortFlags::None);
+
+private:
+    static constexpr int32 NumBuckets = 256;
+    static constexpr int32 NumPasses = 4;
+
+    static int32 GetNumChunks(int32 Num, ERadixSortFlags Flags);
+
+    template<typename BodyType>
+    static void ForEachChunk(int32 NumChunks, BodyType Body);
+
+    template<typename RecordType, typename RadixKeyFuncType>
+    static void InsertionSort(TArrayView<RecordType> Records, RadixKeyFuncType RadixKey);
+};
+
+// ===== IMPLEMENTATION =====
+
+inline int32 FRadixSort::GetNumChunks(int32 Num, ERadixSortFlags Flags)
+{
+    if (Num < ParallelThreshold || EnumHasAnyFlags(Flags, ERadixSortFlags::SingleThreaded))
+        return 1;
+    return FMath::Clamp(Num / MinItemsPerChunk, 1, FPlatformMisc::NumberOfCoresIncludingHyperthreads());
+}
+
+template<typename BodyType>
+void FRadixSort::ForEachChunk(int32 NumChunks, BodyType Body)
+{
+    if (NumChunks == 1)
+    {
+        Body(0);
+        return;
+    }
+    ParallelFor(NumChunks, Body);
+}
+
+template<typename RecordType, typename RadixKeyFuncType>
+void FRadixSort::InsertionSort(TArrayView<RecordType> Records, RadixKeyFuncType RadixKey)
+{
+    for (int32 i = 1; i < Records.Num(); i++)
+    {
+        const RecordType Record = Records[i];
+        const uint32 Key = RadixKey(Record);
+
+        int32 j = i - 1;
+        while (j >= 0 && RadixKey(Records[j]) > Key)
+        {
+            Records[j + 1] = Records[j];
+            j--;
+        }
+        Records[j + 1] = Record;
+    }
+}
+
+template<typename RecordType, typename KeyFuncType>
+void FRadixSort::SortByKey(TArrayView<RecordType> Records, KeyFuncType GetKey, ERadixSortFlags Flags)
+{
+    static_assert(std::is_trivially_copyable_v<RecordType>, "Records are moved between buffers with plain copies");
+
+    // Flipping the sign bit orders signed keys as unsigned; flipping every other bit reverses the order
+    const uint32 KeyFlip = EnumHasAnyFlags(Flags, ERadixSortFlags::Descending) ? 0x7FFFFFFFu : 0x80000000u;
+    auto RadixKey = [&GetKey, KeyFlip](const RecordType& Record) -> uint32
+    {
+        return static_cast<uint32>(GetKey(Record)) ^ KeyFlip;
+    };
+
+    const int32 Num = Records.Num();
+    if (Num <= SmallSortThreshold)
+    {
+        InsertionSort(Records, RadixKey);
+        return;
+    }
+
+    const int32 NumChunks = GetNumChunks(Num, Flags);
+    const int32 ChunkSize = FMath::DivideAndRoundUp(Num, NumChunks);
+
+    // Every digit's histogram from one read of the input
+    TArray<uint32> DigitCounts;
+    DigitCounts.SetNumZeroed(NumChunks * NumPasses * NumBuckets);
+    ForEachChunk(NumChunks, [&](int32 Chunk)
+    {
+        uint32* Counts = &DigitCounts[Chunk * NumPasses * NumBuckets];
+        const int32 End = FMath::Min(Num, (Chunk + 1) * ChunkSize);
+        for (int32 i = Chunk * ChunkSize; i < End; i++)
+        {
+            const uint32 Key = RadixKey(Records[i]);
+            for (int32 Pass = 0; Pass < NumPasses; Pass++)
+            {
+                Counts[Pass * NumBuckets + ((Key >> (Pass * 8)) & 0xFF)]++;
+            }
+        }
+    });
+
+    TArray<RecordType> Scratch;
+    Scratch.SetNumUninitialized(Num);
+    RecordType* Src = Records.GetData();
+    RecordType* Dst = Scratch.GetData();
+
+    TArray<uint32> PassCounts;
+    TArray<uint32> Offsets;
+    PassCounts.SetNumUninitialized(NumChunks * NumBuckets);
+    Offsets.SetNumUninitialized(NumChunks * NumBuckets);
+    bool bReordered = false;
+
+    for (int32 Pass = 0; Pass < NumPasses; Pass++)
+    {
+        const int32 Shift = Pass * 8;
+
+        bool bSingleBucket = false;
+        for (int32 Bucket = 0; Bucket < NumBuckets && !bSingleBucket; Bucket++)
+        {
+            uint32 Total = 0;
+            for (int32 Chunk = 0; Chunk < NumChunks; Chunk++)
+            {
+                Total += DigitCounts[(Chunk * NumPasses + Pass) * NumBuckets + Bucket];
+            }
+            bSingleBucket = Total == static_cast<uint32>(Num);
+        }
+        if (bSingleBucket)
+            continue;
+
+        // Chunk contents change after each scatter, so chunk histograms are recounted
+        if (bReordered && NumChunks > 1)
+        {
+            ForEachChunk(NumChunks, [&](int32 Chunk)
+            {
+                uint32* Counts = &PassCounts[Chunk * NumBuckets];
+                FMemory::Memzero(Counts, NumBuckets * sizeof(uint32));
+                const int32 End = FMath::Min(Num, (Chunk + 1) * ChunkSize);
+                for (int32 i = Chunk * ChunkSize; i < End; i++)
+                {
+                    Counts[(RadixKey(Src[i]) >> Shift) & 0xFF]++;
+                }
+            });
+        }
+        else
+        {
+            for (int32 Chunk = 0; Chunk < NumChunks; Chunk++)
+            {
+                FMemory::Memcpy(&PassCounts[Chunk * NumBuckets], &DigitCounts[(Chunk * NumPasses + Pass) * NumBuckets],
+                    NumBuckets * sizeof(uint32));
+            }
+        }
+
+        // Bucket-major, chunk-minor: earlier chunks land first in every bucket
+        uint32 Running = 0;
+        for (int32 Bucket = 0; Bucket < NumBuckets; Bucket++)
+        {
+            for (int32 Chunk = 0; Chunk < NumChunks; Chunk++)
+            {
+                Offsets[Chunk * NumBuckets + Bucket] = Running;
+                Running += PassCounts[Chunk * NumBuckets + Bucket];
+            }
+        }
+
+        ForEachChunk(NumChunks, [&](int32 Chunk)
+        {
+            uint32* ChunkOffsets = &Offsets[Chunk * NumBuckets];
+            const int32 End = FMath::Min(Num, (Chunk + 1) * ChunkSize);
+            for (int32 i = Chunk * ChunkSize; i < End; i++)
+            {
+                Dst[ChunkOffsets[(RadixKey(Src[i]) >> Shift) & 0xFF]++] = Src[i];
+            }
+        });
+
+        Swap(Src, Dst);
+        bReordered = true;
+    }
+
+    if (Src != Records.GetData())
+    {
+        FMemory::Memcpy(Records.GetData(), Src, sizeof(RecordType) * Num);
+    }
+}
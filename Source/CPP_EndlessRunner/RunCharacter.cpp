@@ -4,6 +4,9 @@
 #include "RunCharacter.h"
 
 #include "CPP_EndlessRunnerGameModeBase.h"
+#include "InputBufferComponent.h"
+#include "LaneChangeComponent.h"
+#include "RunnerMovementComponent.h"
 #include "Camera/CameraComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
@@ -12,7 +15,8 @@
 #include "GameFramework/PlayerStart.h"
 
 // Sets default values
-ARunCharacter::ARunCharacter()
+ARunCharacter::ARunCharacter(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<URunnerMovementComponent>(ACharacter::CharacterMovementComponentName))
 {
  	// Set this character to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
@@ -29,6 +33,12 @@ ARunCharacter::ARunCharacter()
 	Camera->bUsePawnControlRotation = false;
 	Camera->SetupAttachment(CameraArm, USpringArmComponent::SocketName);
 
+	/* Lane changes */
+	LaneChange = CreateDefaultSubobject<ULaneChangeComponent>(TEXT("LaneChange"));
+
+	/* Buffered input */
+	InputBuffer = CreateDefaultSubobject<UInputBufferComponent>(TEXT("InputBuffer"));
+
 	GetCharacterMovement()->MaxWalkSpeed = 1500.0f;
 	GetCharacterMovement()->JumpZVelocity = 600.0f;
 	GetCharacterMovement()->AirControl = 0.2f;
@@ -50,6 +60,9 @@ void ARunCharacter::BeginPlay()
 	// Bind our function to OnLevelResetEvent at the GameMode
 	GameMode->OnLevelReset.AddDynamic(this, &ARunCharacter::ResetLevel);
 
+	LaneChange->OnLaneReached.AddWeakLambda(this, [this](int32) { ChangeLaneFinished(); });
+	InputBuffer->TryApplyInput.BindUObject(this, &ARunCharacter::TryApplyInput);
+
 	PlayerStart = Cast<APlayerStart>(UGameplayStatics::GetActorOfClass(GetWorld(), APlayerStart::StaticClass()));
 }
 
@@ -57,11 +70,24 @@ void ARunCharacter::BeginPlay()
 void ARunCharacter::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
+
+	// Commands that couldn't be applied when pressed (e.g. a jump just before landing)
+	InputBuffer->ApplyBuffered();
 	
 	FRotator ControlRot = GetControlRotation();
 	ControlRot.Roll = 0.0f;
 	ControlRot.Pitch = 0.0f;
 	AddMovementInput(ControlRot.Vector());
+
+	// Keep the lane graph's blocked lanes in step with what is ahead of us
+	GameMode->UpdateLaneBlocking(GetActorLocation());
+
+	// Speed follows the difficulty curve (O(1) table lookup)
+	const float RunSpeed = GameMode->GetRunSpeedAt(GetActorLocation());
+	if (RunSpeed > 0.0f)
+	{
+		GetCharacterMovement()->MaxWalkSpeed = RunSpeed;
+	}
 }
 
 // Called to bind functionality to input
@@ -75,7 +101,7 @@ void ARunCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputCompon
 	PlayerInputComponent->BindAction("MoveDown", IE_Pressed, this, &ARunCharacter::MoveDown);
 
 	// Jumping is implemented using built in jumping functions in UE's default Character class
-	PlayerInputComponent->BindAction("Jump", IE_Pressed, this, &ACharacter::Jump);
+	PlayerInputComponent->BindAction("Jump", IE_Pressed, this, &ARunCharacter::JumpPressed);
 	PlayerInputComponent->BindAction("Jump", IE_Released, this, &ACharacter::StopJumping);
 }
 
@@ -83,14 +109,72 @@ void ARunCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputCompon
 
 void ARunCharacter::MoveLeft()
 {
-	NextLane = FMath::Clamp(CurrentLane - 1, 0,2);
-	ChangeLane();
+	InputBuffer->Press(ERunnerInput::MoveLeft);
 }
 
 void ARunCharacter::MoveRight()
 {
-	NextLane = FMath::Clamp(CurrentLane + 1, 0,2);
-	ChangeLane();
+	InputBuffer->Press(ERunnerInput::MoveRight);
+}
+
+void ARunCharacter::JumpPressed()
+{
+	InputBuffer->Press(ERunnerInput::Jump);
+}
+
+void ARunCharacter::RequestInput(ERunnerInput Input)
+{
+	InputBuffer->Press(Input);
+}
+
+bool ARunCharacter::IsChangingLane() const
+{
+	return bBlueprintLaneChangeActive || LaneChange->IsChangingLane();
+}
+
+bool ARunCharacter::TryApplyInput(ERunnerInput Input, FVector& OutMotionDirection)
+{
+	if (bIsDead)
+		return false;
+
+	if (Input == ERunnerInput::Jump)
+	{
+		if (!CanJump())
+			return false;
+
+		Jump();
+		OutMotionDirection = FVector::UpVector;
+		return true;
+	}
+
+	// Lanes are known once the first tile is in; the timeline can't be redirected mid-change
+	if (GameMode->LaneSwitchValues.Num() == 0 || (bUseBlueprintLaneChange && bBlueprintLaneChangeActive))
+		return false;
+
+	// Mid-change, steps from the lane being moved to
+	const int32 FromLane = LaneChange->IsChangingLane() ? NextLane : CurrentLane;
+	NextLane = FMath::Clamp(FromLane + (Input == ERunnerInput::MoveLeft ? -1 : 1), 0,2);
+
+	const float LaneY = GameMode->LaneSwitchValues.IsValidIndex(NextLane) ? GameMode->LaneSwitchValues[NextLane] : GetActorLocation().Y;
+	OutMotionDirection = FVector(0.0f, FMath::Sign(LaneY - GetActorLocation().Y), 0.0f);
+
+	StartLaneChange();
+	return true;
+}
+
+void ARunCharacter::StartLaneChange()
+{
+	if (bUseBlueprintLaneChange)
+	{
+		bBlueprintLaneChangeActive = true;
+		ChangeLane();
+		return;
+	}
+
+	if (GameMode->LaneSwitchValues.IsValidIndex(NextLane))
+	{
+		LaneChange->MoveToLane(NextLane, GameMode->LaneSwitchValues[NextLane]);
+	}
 }
 
 void ARunCharacter::MoveDown()
@@ -109,6 +193,7 @@ void ARunCharacter::ChangeLaneUpdate(const float Value)
 void ARunCharacter::ChangeLaneFinished()
 {
 	CurrentLane = NextLane;
+	bBlueprintLaneChangeActive = false;
 }
 
 void ARunCharacter::Die()
@@ -145,6 +230,9 @@ void ARunCharacter::OnDeath()
 		GetWorldTimerManager().ClearTimer(RestartHandle);
 	}
 
+	InputBuffer->ResetBuffer();
+	InputBuffer->LogLatencySummary();
+
 	GameMode->PlayerDied();
 
 	// Execute a restart command
@@ -160,6 +248,8 @@ void ARunCharacter::ResetLevel()
 {
 	bIsDead = false;
 	EnableInput(nullptr);
+	LaneChange->ResetLane(CurrentLane);
+	bBlueprintLaneChangeActive = false;
 	GetMesh()->SetVisibility(true);
 	if(PlayerStart)
 	{
@@ -7,6 +7,9 @@
 #include "RunCharacter.generated.h"
 
 class APlayerStart;
+class ULaneChangeComponent;
+class UInputBufferComponent;
+enum class ERunnerInput : uint8;
 
 UCLASS()
 class CPP_ENDLESSRUNNER_API ARunCharacter : public ACharacter
@@ -15,7 +18,7 @@ class CPP_ENDLESSRUNNER_API ARunCharacter : public ACharacter
 
 public:
 	// Sets default values for this character's properties
-	ARunCharacter();
+	ARunCharacter(const FObjectInitializer& ObjectInitializer);
 
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite)
 	int32 CurrentLane = 1;
@@ -38,6 +41,11 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite);
 	float MoveDownImpulse = -1000.0f;
 	
+	// Old path, off by default: fires ChangeLane for a Blueprint timeline that
+	// calls ChangeLaneUpdate every frame. Kept to compare the two in Insights
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Lane")
+	bool bUseBlueprintLaneChange = false;
+
 	UFUNCTION(BlueprintImplementableEvent, Category="Lane")
 	void ChangeLane();
 
@@ -52,6 +60,12 @@ public:
 
 	UFUNCTION()
 	void AddCoin() const;
+
+	// Same path as the input bindings (buffered and latency-measured), for non-player controllers
+	void RequestInput(ERunnerInput Input);
+
+	// True until the lane being moved to is reached
+	bool IsChangingLane() const;
 	
 private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta=(AllowPrivateAccess = "true"));
@@ -60,6 +74,15 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta=(AllowPrivateAccess = "true"));
 	class UCameraComponent* Camera;
 
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta=(AllowPrivateAccess = "true"));
+	ULaneChangeComponent* LaneChange;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta=(AllowPrivateAccess = "true"));
+	UInputBufferComponent* InputBuffer;
+
+	// Set while the Blueprint timeline runs a lane change (it can't be redirected)
+	bool bBlueprintLaneChangeActive = false;
+
 	UPROPERTY(VisibleInstanceOnly)
 	class ACPP_EndlessRunnerGameModeBase* GameMode;
 	
@@ -73,6 +96,12 @@ protected:
 	UFUNCTION() void MoveLeft();
 	UFUNCTION() void MoveRight();
 	UFUNCTION() void MoveDown();
+	UFUNCTION() void JumpPressed();
+	void StartLaneChange();
+
+	// Called by the input buffer at the earliest frame each command can take effect
+	bool TryApplyInput(ERunnerInput Input, FVector& OutMotionDirection);
+
 	UFUNCTION() void OnDeath();
 	UFUNCTION()	void ResetLevel();
 
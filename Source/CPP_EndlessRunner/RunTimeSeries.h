@@ -0,0 +1,231 @@
+// RunTimeSeries.h - Delta-encoded (time, distance, coins) samples for one run
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Varint.h"
+
+/**
+ * One decoded sample: seconds since run start, run distance, coins so far
+ */
+struct FRunSample
+{
+    float Time;
+    float Distance;
+    int32 Coins;
+
+    FRunSample() : Time(0.0f), Distance(0.0f), Coins(0) {}
+};
+
+#define RUN_SERIES_MAGIC 0x53524E52 // "RNRS"
+#define RUN_SERIES_VERSION 1
+
+/**
+ * Time series of a run, stored as a varint byte stream of deltas
+ * Time is quantized to ms and distance to whole units; all three values only
+ * grow during a run, so every delta is a small unsigned number (1-2 bytes)
+ * A checkpoint every CheckpointInterval samples bounds the decode per query
+ * Time Complexity: O(1) append, O(log n + CheckpointInterval) query
+ */
+class FRunTimeSeries
+{
+private:
+    struct FState
+    {
+        uint32 TimeMs;
+        uint32 Distance;
+        uint32 Coins;
+    };
+
+    // Absolute state after sample (Index * CheckpointInterval), and where the next delta starts
+    struct FCheckpoint
+    {
+        FState State;
+        int32 NextOffset;
+    };
+
+    static constexpr int32 CheckpointInterval = 64;
+
+    TArray<uint8> Stream;
+    TArray<FCheckpoint> Checkpoints;
+    FState Last;
+    int32 NumSamples;
+
+public:
+    FRunTimeSeries() { Reset(); }
+
+    void Reset();
+
+    // Values that go backwards are clamped to the previous sample
+    void AddSample(float Time, float Distance, int32 Coins);
+
+    // Coins of the last sample at or before the given point (0 before the first)
+    int32 GetCoinsAtDistance(float Distance) const;
+    int32 GetCoinsAtTime(float Time) const;
+
+    // Utility
+    int32 Num() const { return NumSamples; }
+    bool IsEmpty() const { return NumSamples == 0; }
+    FRunSample GetLastSample() const { return ToSample(Last); }
+    void Decode(TArray<FRunSample>& OutSamples) const;
+    SIZE_T GetAllocatedSize() const { return Stream.GetAllocatedSize() + Checkpoints.GetAllocatedSize(); }
+
+    // Binary image for saving a run (e.g. as a ghost); Load rebuilds the checkpoints
+    void Serialize(TArray<uint8>& OutBytes) const;
+    bool Load(const TArray<uint8>& Bytes);
+
+private:
+    void AppendState(const FState& State);
+    static FRunSample ToSample(const FState& State);
+
+    // Last checkpoint whose state passes Pred, then decode forward while it still holds
+    template<typename PredicateType>
+    uint32 FindCoins(PredicateType Pred) const;
+};
+
+// ===== IMPLEMENTATION =====
+
+inline void FRunTimeSeries::Reset()
+{
+    Stream.Reset();
+    Checkpoints.Reset();
+    Last = { 0, 0, 0 };
+    NumSamples = 0;
+}
+
+inline FRunSample FRunTimeSeries::ToSample(const FState& State)
+{
+    FRunSample Sample;
+    Sample.Time = State.TimeMs / 1000.0f;
+    Sample.Distance = static_cast<float>(State.Distance);
+    Sample.Coins = static_cast<int32>(State.Coins);
+    return Sample;
+}
+
+inline void FRunTimeSeries::AddSample(float Time, float Distance, int32 Coins)
+{
+    FState State;
+    State.TimeMs = FMath::Max(static_cast<uint32>(FMath::Max(FMath::RoundToInt(Time * 1000.0f), 0)), Last.TimeMs);
+    State.Distance = FMath::Max(static_cast<uint32>(FMath::Max(FMath::RoundToInt(Distance), 0)), Last.Distance);
+    State.Coins = FMath::Max(static_cast<uint32>(FMath::Max(Coins, 0)), Last.Coins);
+
+    AppendState(State);
+}
+
+inline void FRunTimeSeries::AppendState(const FState& State)
+{
+    FVarint::Write(Stream, State.TimeMs - Last.TimeMs);
+    FVarint::Write(Stream, State.Distance - Last.Distance);
+    FVarint::Write(Stream, State.Coins - Last.Coins);
+
+    if (NumSamples % CheckpointInterval == 0)
+    {
+        Checkpoints.Add({ State, Stream.Num() });
+    }
+
+    Last = State;
+    NumSamples++;
+}
+
+template<typename PredicateType>
+inline uint32 FRunTimeSeries::FindCoins(PredicateType Pred) const
+{
+    // Binary search: first checkpoint that fails, step back one
+    int32 Low = 0;
+    int32 High = Checkpoints.Num();
+    while (Low < High)
+    {
+        const int32 Mid = Low + (High - Low) / 2;
+        if (Pred(Checkpoints[Mid].State))
+        {
+            Low = Mid + 1;
+        }
+        else
+        {
+            High = Mid;
+        }
+    }
+    if (Low == 0)
+        return 0;
+
+    const FCheckpoint& Checkpoint = Checkpoints[Low - 1];
+    FState State = Checkpoint.State;
+    int32 Offset = Checkpoint.NextOffset;
+
+    // At most CheckpointInterval - 1 samples until the next checkpoint
+    FState Delta;
+    while (FVarint::Read(Stream, Offset, Delta.TimeMs) && FVarint::Read(Stream, Offset, Delta.Distance) && FVarint::Read(Stream, Offset, Delta.Coins))
+    {
+        const FState Next = { State.TimeMs + Delta.TimeMs, State.Distance + Delta.Distance, State.Coins + Delta.Coins };
+        if (!Pred(Next))
+            break;
+        State = Next;
+    }
+    return State.Coins;
+}
+
+inline int32 FRunTimeSeries::GetCoinsAtDistance(float Distance) const
+{
+    const int64 Units = FMath::FloorToInt(Distance);
+    return static_cast<int32>(FindCoins([Units](const FState& State) { return static_cast<int64>(State.Distance) <= Units; }));
+}
+
+inline int32 FRunTimeSeries::GetCoinsAtTime(float Time) const
+{
+    const int64 TimeMs = FMath::FloorToInt(Time * 1000.0f);
+    return static_cast<int32>(FindCoins([TimeMs](const FState& State) { return static_cast<int64>(State.TimeMs) <= TimeMs; }));
+}
+
+inline void FRunTimeSeries::Decode(TArray<FRunSample>& OutSamples) const
+{
+    OutSamples.Reset(NumSamples);
+
+    FState State = { 0, 0, 0 };
+    FState Delta;
+    int32 Offset = 0;
+    while (FVarint::Read(Stream, Offset, Delta.TimeMs) && FVarint::Read(Stream, Offset, Delta.Distance) && FVarint::Read(Stream, Offset, Delta.Coins))
+    {
+        State = { State.TimeMs + Delta.TimeMs, State.Distance + Delta.Distance, State.Coins + Delta.Coins };
+        OutSamples.Add(ToSample(State));
+    }
+}
+
+inline void FRunTimeSeries::Serialize(TArray<uint8>& OutBytes) const
+{
+    OutBytes.Reset(Stream.Num() + 12);
+    const uint32 Header[3] = { RUN_SERIES_MAGIC, RUN_SERIES_VERSION, static_cast<uint32>(NumSamples) };
+    OutBytes.Append(reinterpret_cast<const uint8*>(Header), sizeof(Header));
+    OutBytes.Append(Stream);
+}
+
+inline bool FRunTimeSeries::Load(const TArray<uint8>& Bytes)
+{
+    Reset();
+
+    uint32 Header[3];
+    if (Bytes.Num() < static_cast<int32>(sizeof(Header)))
+        return false;
+    FMemory::Memcpy(Header, Bytes.GetData(), sizeof(Header));
+    if (Header[0] != RUN_SERIES_MAGIC || Header[1] != RUN_SERIES_VERSION)
+        return false;
+
+    // Re-append every sample so checkpoints and Last are rebuilt - O(n)
+    TArray<uint8> Encoded;
+    Encoded.Append(Bytes.GetData() + sizeof(Header), Bytes.Num() - sizeof(Header));
+
+    FState State = { 0, 0, 0 };
+    FState Delta;
+    int32 Offset = 0;
+    while (NumSamples < static_cast<int32>(Header[2])
+        && FVarint::Read(Encoded, Offset, Delta.TimeMs) && FVarint::Read(Encoded, Offset, Delta.Distance) && FVarint::Read(Encoded, Offset, Delta.Coins))
+    {
+        State = { State.TimeMs + Delta.TimeMs, State.Distance + Delta.Distance, State.Coins + Delta.Coins };
+        AppendState(State);
+    }
+
+    if (NumSamples != static_cast<int32>(Header[2]))
+    {
+        Reset();
+        return false;
+    }
+    return true;
+}
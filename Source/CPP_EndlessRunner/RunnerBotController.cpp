@@ -0,0 +1,238 @@
+// RunnerBotController.cpp - Autopilot for the runner, for unattended soak and performance runs
+#include "RunnerBotController.h"
+#include "CPP_EndlessRunnerGameModeBase.h"
+#include "InputBufferComponent.h"
+#include "RunCharacter.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Kismet/GameplayStatics.h"
+#include "Kismet/KismetSystemLibrary.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "TimerManager.h"
+
+ARunnerBotController::ARunnerBotController()
+{
+	PrimaryActorTick.bCanEverTick = true;
+}
+
+void ARunnerBotController::BeginPlay()
+{
+	Super::BeginPlay();
+
+	GameMode = Cast<ACPP_EndlessRunnerGameModeBase>(UGameplayStatics::GetGameMode(GetWorld()));
+	check(GameMode);
+
+	// Counts level loads, so rows from every restart can be told apart
+	static int32 NumBotRuns = 0;
+	Stats.Run = ++NumBotRuns;
+
+	FParse::Value(FCommandLine::Get(), TEXT("RunnerBotMetrics="), MetricsFile);
+	FParse::Value(FCommandLine::Get(), TEXT("RunnerBotHours="), MaxHours);
+	MetricsPath = FPaths::IsRelative(MetricsFile) ? FPaths::Combine(FPaths::ProjectSavedDir(), MetricsFile) : MetricsFile;
+
+	if (!IFileManager::Get().FileExists(*MetricsPath))
+	{
+		FFileHelper::SaveStringToFile(
+			TEXT("UptimeS,Run,WorldS,Frames,AvgFrameMs,MaxFrameMs,UsedPhysicalMB,PeakUsedPhysicalMB,Actors,Lives,Coins,Distance,Deaths,LaneChanges,Jumps\n"),
+			*MetricsPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+	}
+
+	LastFrameTime = LastRowTime = FPlatformTime::Seconds();
+	TakeOverPlayerPawn();
+
+	UE_LOG(LogTemp, Warning, TEXT("RunnerBot: run %d, seed %d, metrics to %s"), Stats.Run, GameMode->GetSpawnSeed(), *MetricsPath);
+}
+
+void ARunnerBotController::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	WriteMetricsRow(FPlatformTime::Seconds());
+	UE_LOG(LogTemp, Warning, TEXT("RunnerBot: run %d ended, %d deaths, %d lane changes, %d jumps, worst frame %.1f ms"),
+		Stats.Run, Stats.Deaths, Stats.LaneChanges, Stats.Jumps, Stats.MaxFrameMs);
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ARunnerBotController::TakeOverPlayerPawn()
+{
+	APlayerController* PlayerController = UGameplayStatics::GetPlayerController(GetWorld(), 0);
+	if (ARunCharacter* Character = Cast<ARunCharacter>(UGameplayStatics::GetPlayerPawn(GetWorld(), 0)))
+	{
+		// Possess unpossesses the player controller; it keeps looking through the runner's camera
+		Possess(Character);
+		if (PlayerController)
+		{
+			PlayerController->SetViewTarget(Character);
+		}
+	}
+}
+
+void ARunnerBotController::OnPossess(APawn* InPawn)
+{
+	Super::OnPossess(InPawn);
+	Runner = Cast<ARunCharacter>(InPawn);
+}
+
+void ARunnerBotController::OnUnPossess()
+{
+	Super::OnUnPossess();
+	Runner = nullptr;
+}
+
+void ARunnerBotController::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	RecordFrame();
+
+	// The player's pawn may not exist yet when the bot begins play
+	if (!Runner)
+	{
+		TakeOverPlayerPawn();
+		return;
+	}
+
+	if (Runner->bIsDead)
+	{
+		if (!bWasDead)
+		{
+			Stats.Deaths++;
+			bWasDead = true;
+		}
+
+		// Out of lives: the run is over, start the next one
+		if (GameMode->CurrentLivesCount <= 0 && !RestartHandle.IsValid())
+		{
+			GetWorldTimerManager().SetTimer(RestartHandle, this, &ARunnerBotController::RestartLevel, FMath::Max(RestartDelay, 0.01f));
+		}
+		return;
+	}
+
+	bWasDead = false;
+	Steer();
+}
+
+void ARunnerBotController::Steer()
+{
+	// One decision per lane change; the change in progress is left to finish
+	if (GameMode->GetNumLanes() == 0 || Runner->IsChangingLane())
+		return;
+
+	const int32 FromLane = Runner->CurrentLane;
+	const FVector Location = Runner->GetActorLocation();
+
+	const int32 NextLane = ChooseNextLane(FromLane, Location);
+	if (NextLane != FromLane)
+	{
+		Runner->RequestInput(NextLane < FromLane ? ERunnerInput::MoveLeft : ERunnerInput::MoveRight);
+		Stats.LaneChanges++;
+		return;
+	}
+
+	// Nowhere better to go: jump what is in the way
+	const float Obstacle = GameMode->GetObstacleDistanceAhead(FromLane, Location);
+	if (Obstacle >= 0.0f && Obstacle <= JumpDistance && Runner->CanJump())
+	{
+		Runner->RequestInput(ERunnerInput::Jump);
+		Stats.Jumps++;
+	}
+}
+
+int32 ARunnerBotController::ChooseNextLane(int32 FromLane, const FVector& Location) const
+{
+	const int32 NumLanes = GameMode->GetNumLanes();
+
+	// Clear track ahead per lane, capped at the lookahead
+	TArray<float, TInlineAllocator<8>> Clear;
+	Clear.SetNum(NumLanes);
+	for (int32 Lane = 0; Lane < NumLanes; Lane++)
+	{
+		const float Obstacle = GameMode->GetObstacleDistanceAhead(Lane, Location);
+		Clear[Lane] = Obstacle >= 0.0f ? FMath::Min(Obstacle, Lookahead) : Lookahead;
+	}
+
+	int32 BestLane = FromLane;
+	float BestScore = -MAX_flt;
+	for (int32 Lane = 0; Lane < NumLanes; Lane++)
+	{
+		// Every lane entered on the way needs room for the crossing
+		bool bReachable = true;
+		for (int32 Step = FromLane; Step != Lane && bReachable; )
+		{
+			Step += Lane > Step ? 1 : -1;
+			bReachable = Clear[Step] >= CrossClearance;
+		}
+		if (!bReachable)
+			continue;
+
+		const float Coin = GameMode->GetCoinDistanceAhead(Lane, Location);
+		const bool bCoinFirst = Coin >= 0.0f && Coin < Clear[Lane];
+
+		const float Score = Clear[Lane] + (bCoinFirst ? CoinWeight : 0.0f) - FMath::Abs(Lane - FromLane) * LaneStepCost;
+		if (Score > BestScore)
+		{
+			BestScore = Score;
+			BestLane = Lane;
+		}
+	}
+
+	// The lane graph routes around lanes blocked just ahead (FromLane if there is no way through)
+	return BestLane != FromLane ? GameMode->FindOptimalLane(FromLane, BestLane) : FromLane;
+}
+
+void ARunnerBotController::RecordFrame()
+{
+	const double Now = FPlatformTime::Seconds();
+	const float FrameMs = static_cast<float>((Now - LastFrameTime) * 1000.0);
+	LastFrameTime = Now;
+
+	IntervalFrames++;
+	IntervalFrameMs += FrameMs;
+	IntervalMaxFrameMs = FMath::Max(IntervalMaxFrameMs, FrameMs);
+	Stats.MaxFrameMs = FMath::Max(Stats.MaxFrameMs, FrameMs);
+
+	if (Now - LastRowTime >= MetricsInterval)
+	{
+		WriteMetricsRow(Now);
+
+		if (MaxHours > 0.0f && Now - GStartTime >= MaxHours * 3600.0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("RunnerBot: %.1f hours reached, exiting"), MaxHours);
+			FPlatformMisc::RequestExit(false, TEXT("RunnerBot"));
+		}
+	}
+}
+
+void ARunnerBotController::WriteMetricsRow(double Now)
+{
+	if (IntervalFrames == 0 || MetricsPath.IsEmpty() || !GameMode)
+		return;
+
+	const FPlatformMemoryStats Memory = FPlatformMemory::GetStats();
+	const FString Row = FString::Printf(TEXT("%.1f,%d,%.2f,%d,%.2f,%.2f,%.1f,%.1f,%d,%d,%d,%.0f,%d,%d,%d\n"),
+		Now - GStartTime, Stats.Run, GetWorld()->GetTimeSeconds(),
+		IntervalFrames, IntervalFrameMs / IntervalFrames, IntervalMaxFrameMs,
+		Memory.UsedPhysical / (1024.0 * 1024.0), Memory.PeakUsedPhysical / (1024.0 * 1024.0),
+		GetWorld()->GetActorCount(),
+		GameMode->CurrentLivesCount, GameMode->TotalCoins, GameMode->GetRunDistance(),
+		Stats.Deaths, Stats.LaneChanges, Stats.Jumps);
+
+	// One appended line per interval: a crash loses at most the last interval
+	FFileHelper::SaveStringToFile(Row, *MetricsPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM,
+		&IFileManager::Get(), FILEWRITE_Append);
+
+	Stats.MetricsRows++;
+	LastRowTime = Now;
+	IntervalFrames = 0;
+	IntervalFrameMs = 0.0;
+	IntervalMaxFrameMs = 0.0f;
+}
+
+void ARunnerBotController::RestartLevel()
+{
+	// Same as the game over screen's Restart button; the URL keeps ?Bot and the seed options
+	UKismetSystemLibrary::ExecuteConsoleCommand(GetWorld(), TEXT("RestartLevel"));
+}
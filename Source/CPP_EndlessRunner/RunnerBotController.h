@@ -0,0 +1,139 @@
+// RunnerBotController.h - Autopilot for the runner, for unattended soak and performance runs
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Controller.h"
+#include "RunnerBotController.generated.h"
+
+class ARunCharacter;
+class ACPP_EndlessRunnerGameModeBase;
+
+USTRUCT(BlueprintType)
+struct FRunnerBotStats
+{
+	GENERATED_BODY()
+
+	// Level loads driven by bots in this process, this one included
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Bot")
+	int32 Run = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Bot")
+	int32 Deaths = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Bot")
+	int32 LaneChanges = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Bot")
+	int32 Jumps = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Bot")
+	int32 MetricsRows = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Bot")
+	float MaxFrameMs = 0.0f;
+};
+
+/**
+ * Plays the runner without a player, so a -nullrhi build can run for hours
+ * Each frame it reads what is ahead in every lane from the game mode's
+ * obstacle and coin indices (no actor scans), picks the lane with the most
+ * clear track (plus a bonus for a coin before the next obstacle) and steps
+ * towards it along the lane graph's route; an obstacle it can't get around
+ * is jumped. Commands go through the character's input buffer, like a player's
+ * Started by the game mode with -RunnerBot (or ?Bot on the level URL); pair it
+ * with -RunnerSeed=N for a reproducible track. Game over restarts the level;
+ * bot runs are never saved to the leaderboard, ghost or score service
+ * Every MetricsInterval it appends a CSV row of wall-clock frame times,
+ * memory and actor count to MetricsFile; rows from restarted levels go to
+ * the same file
+ *
+ * Usage: CPP_EndlessRunner MainLevel -game -nullrhi -RunnerBot -RunnerSeed=42
+ *        [-RunnerBotMetrics=Bot/Soak.csv] [-RunnerBotHours=8]
+ */
+UCLASS()
+class CPP_ENDLESSRUNNER_API ARunnerBotController : public AController
+{
+	GENERATED_BODY()
+
+public:
+	ARunnerBotController();
+
+	// How far ahead the bot reads the track (cm)
+	UPROPERTY(EditAnywhere, Category = "Bot", meta = (ClampMin = "0.0"))
+	float Lookahead = 2000.0f;
+
+	// Clear track a lane needs to be crossed or moved into (cm)
+	UPROPERTY(EditAnywhere, Category = "Bot", meta = (ClampMin = "0.0"))
+	float CrossClearance = 600.0f;
+
+	// An obstacle this close that can't be dodged is jumped (cm)
+	UPROPERTY(EditAnywhere, Category = "Bot", meta = (ClampMin = "0.0"))
+	float JumpDistance = 400.0f;
+
+	// A coin before the lane's next obstacle is worth this much clear track (cm)
+	UPROPERTY(EditAnywhere, Category = "Bot", meta = (ClampMin = "0.0"))
+	float CoinWeight = 500.0f;
+
+	// Charged per lane stepped, so the bot doesn't weave for nothing (cm)
+	UPROPERTY(EditAnywhere, Category = "Bot", meta = (ClampMin = "0.0"))
+	float LaneStepCost = 150.0f;
+
+	// Seconds of wall-clock time between metrics rows
+	UPROPERTY(EditAnywhere, Category = "Bot", meta = (ClampMin = "0.1"))
+	float MetricsInterval = 1.0f;
+
+	// Relative to the Saved directory unless absolute; -RunnerBotMetrics= overrides
+	UPROPERTY(EditAnywhere, Category = "Bot")
+	FString MetricsFile = TEXT("Bot/Metrics.csv");
+
+	// Exits once the process has run this long (0 runs until stopped); -RunnerBotHours= overrides
+	UPROPERTY(EditAnywhere, Category = "Bot", meta = (ClampMin = "0.0"))
+	float MaxHours = 0.0f;
+
+	// Seconds on the game over screen before the level restarts
+	UPROPERTY(EditAnywhere, Category = "Bot", meta = (ClampMin = "0.0"))
+	float RestartDelay = 2.0f;
+
+	UFUNCTION(BlueprintCallable, Category = "Bot")
+	FRunnerBotStats GetBotStats() const { return Stats; }
+
+	virtual void Tick(float DeltaSeconds) override;
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void OnPossess(APawn* InPawn) override;
+	virtual void OnUnPossess() override;
+
+private:
+	UPROPERTY()
+	ARunCharacter* Runner;
+
+	UPROPERTY()
+	ACPP_EndlessRunnerGameModeBase* GameMode;
+
+	UPROPERTY(VisibleInstanceOnly, Category = "Bot")
+	FRunnerBotStats Stats;
+
+	FTimerHandle RestartHandle;
+	bool bWasDead = false;
+
+	// Wall-clock frame times since the last metrics row
+	double LastFrameTime = 0.0;
+	double LastRowTime = 0.0;
+	int32 IntervalFrames = 0;
+	double IntervalFrameMs = 0.0;
+	float IntervalMaxFrameMs = 0.0f;
+
+	FString MetricsPath;
+
+	void TakeOverPlayerPawn();
+	void Steer();
+
+	// Lane to step into next (FromLane to stay)
+	int32 ChooseNextLane(int32 FromLane, const FVector& Location) const;
+
+	void RecordFrame();
+	void WriteMetricsRow(double Now);
+	void RestartLevel();
+};
@@ -0,0 +1,140 @@
+// RunnerMovementComponent.cpp - Analytic running along the flat track, generic physics only as a fallback
+#include "RunnerMovementComponent.h"
+#include "CPP_EndlessRunner.h"
+#include "Components/CapsuleComponent.h"
+#include "GameFramework/Character.h"
+
+DECLARE_CYCLE_STAT(TEXT("Runner Movement Tick"), STAT_RunnerMovementTick, STATGROUP_Runner);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Movement Running (us)"), STAT_RunnerMoveRunningUs, STATGROUP_Runner);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Movement Walking/Falling (us)"), STAT_RunnerMoveFallbackUs, STATGROUP_Runner);
+
+void URunnerMovementComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RunnerMovementTick);
+
+	if (!bUseRunningMode && IsRunningOnTrack())
+	{
+		SetMovementMode(MOVE_Walking);
+	}
+
+	const bool bWasRunning = IsRunningOnTrack();
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	const float FrameUs = static_cast<float>(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0);
+	Stats.LastFrameUs = FrameUs;
+	if (bWasRunning)
+	{
+		Stats.RunningFrames++;
+		Stats.RunningUs += FrameUs;
+		SET_FLOAT_STAT(STAT_RunnerMoveRunningUs, FrameUs);
+	}
+	else
+	{
+		Stats.FallbackFrames++;
+		Stats.FallbackUs += FrameUs;
+		SET_FLOAT_STAT(STAT_RunnerMoveFallbackUs, FrameUs);
+	}
+}
+
+bool URunnerMovementComponent::IsMovingOnGround() const
+{
+	return Super::IsMovingOnGround() || (IsRunningOnTrack() && UpdatedComponent);
+}
+
+float URunnerMovementComponent::GetMaxSpeed() const
+{
+	// The run speed from the difficulty curve is written to MaxWalkSpeed
+	return IsRunningOnTrack() ? MaxWalkSpeed : Super::GetMaxSpeed();
+}
+
+void URunnerMovementComponent::PhysCustom(float DeltaTime, int32 Iterations)
+{
+	if (CustomMovementMode == static_cast<uint8>(ERunnerMovementMode::Running))
+	{
+		PhysRunning(DeltaTime);
+		return;
+	}
+	Super::PhysCustom(DeltaTime, Iterations);
+}
+
+void URunnerMovementComponent::PhysWalking(float DeltaTime, int32 Iterations)
+{
+	Super::PhysWalking(DeltaTime, Iterations);
+
+	// Standing on flat track again (after landing, a step or a slope): leave the generic floor handling
+	if (bUseRunningMode && MovementMode == MOVE_Walking && CurrentFloor.IsWalkableFloor()
+		&& CurrentFloor.HitResult.ImpactNormal.Z >= TrackNormalZ)
+	{
+		DistanceSinceFloorProbe = 0.0f;
+		SetMovementMode(MOVE_Custom, static_cast<uint8>(ERunnerMovementMode::Running));
+	}
+}
+
+void URunnerMovementComponent::PhysRunning(float DeltaTime)
+{
+	if (DeltaTime < MIN_TICK_TIME || !CharacterOwner || !UpdatedComponent)
+		return;
+
+	// Speed along the input direction, easing towards the run speed as walking does
+	const FVector InputDirection = Acceleration.GetSafeNormal2D();
+	const float CurrentSpeed = Velocity.Size2D();
+	const float TargetSpeed = InputDirection.IsNearlyZero() ? 0.0f : GetMaxSpeed();
+	const float Rate = TargetSpeed >= CurrentSpeed ? GetMaxAcceleration() : BrakingDecelerationWalking;
+	const float Speed = FMath::FInterpConstantTo(CurrentSpeed, TargetSpeed, DeltaTime, Rate);
+	const FVector Direction = InputDirection.IsNearlyZero() ? Velocity.GetSafeNormal2D() : InputDirection;
+	Velocity = Direction * Speed;
+
+	// One sweep in the track plane: obstacles block it, coins overlap it
+	const FVector OldLocation = UpdatedComponent->GetComponentLocation();
+	const FVector Delta = Velocity * DeltaTime;
+	if (!Delta.IsNearlyZero())
+	{
+		FHitResult Hit(1.0f);
+		SafeMoveUpdatedComponent(Delta, UpdatedComponent->GetComponentQuat(), true, Hit);
+		if (Hit.IsValidBlockingHit())
+		{
+			HandleImpact(Hit, DeltaTime, Delta);
+			SlideAlongSurface(Delta, 1.0f - Hit.Time, Hit.Normal, Hit, true);
+
+			// Held up: carry on from the speed actually achieved
+			Velocity = (UpdatedComponent->GetComponentLocation() - OldLocation) / DeltaTime;
+			Velocity.Z = 0.0f;
+		}
+		DistanceSinceFloorProbe += Delta.Size2D();
+	}
+
+	if (DistanceSinceFloorProbe >= FloorProbeSpacing)
+	{
+		DistanceSinceFloorProbe = 0.0f;
+		ProbeTrack();
+	}
+}
+
+void URunnerMovementComponent::ProbeTrack()
+{
+	const float HalfHeight = CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+	const FVector Start = UpdatedComponent->GetComponentLocation();
+	const FVector End = Start - FVector(0.0f, 0.0f, HalfHeight + FloorProbeDepth);
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(RunnerFloorProbe), false, CharacterOwner);
+	FCollisionResponseParams ResponseParams;
+	InitCollisionParams(QueryParams, ResponseParams);
+
+	FHitResult Hit;
+	if (!GetWorld()->LineTraceSingleByChannel(Hit, Start, End, UpdatedComponent->GetCollisionObjectType(), QueryParams, ResponseParams))
+	{
+		// Off the end of the track or over a gap
+		SetMovementMode(MOVE_Falling);
+		return;
+	}
+
+	// Walking keeps the capsule between MIN_FLOOR_DIST and MAX_FLOOR_DIST above the floor;
+	// a slope, a step or a floor at another height is left to walking
+	const float FloorGap = Hit.Distance - HalfHeight;
+	if (!IsWalkable(Hit) || Hit.ImpactNormal.Z < TrackNormalZ || FloorGap > 2.0f * MAX_FLOOR_DIST)
+	{
+		SetMovementMode(MOVE_Walking);
+	}
+}
@@ -0,0 +1,101 @@
+// RunnerMovementComponent.h - Analytic running along the flat track, generic physics only as a fallback
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "RunnerMovementComponent.generated.h"
+
+UENUM(BlueprintType)
+enum class ERunnerMovementMode : uint8
+{
+	None,
+	Running     // On the flat track: straight-line moves, no floor sweeps
+};
+
+/**
+ * Game-thread cost of the movement component's tick, split by the mode the
+ * frame started in, so the two setups can be compared in one session
+ * Also visible in-game with "stat Runner"
+ */
+USTRUCT(BlueprintType)
+struct FRunnerMovementStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement")
+	int32 RunningFrames = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement")
+	float RunningUs = 0.0f;
+
+	// Walking and falling frames (everything while bUseRunningMode is off)
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement")
+	int32 FallbackFrames = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement")
+	float FallbackUs = 0.0f;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement")
+	float LastFrameUs = 0.0f;
+};
+
+/**
+ * Character movement for a runner on a known flat track
+ * While on the track the character is in the custom Running mode: each
+ * frame is one swept move along the input direction at the run speed
+ * (obstacles block it, coins overlap it), plus a short line probe for the
+ * floor every FloorProbeSpacing of travel. Walking's floor sweeps, step-ups
+ * and ramp handling are skipped
+ * Jumping, an impulse or losing the floor hands over to the normal falling
+ * physics, and anything that is not flat track at the expected height to
+ * walking; walking returns to Running once it stands on flat floor again
+ */
+UCLASS()
+class CPP_ENDLESSRUNNER_API URunnerMovementComponent : public UCharacterMovementComponent
+{
+	GENERATED_BODY()
+
+public:
+	// Off: plain walking everywhere, for comparing costs
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Runner Movement")
+	bool bUseRunningMode = true;
+
+	// Travel between floor probes while running (cm)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Runner Movement", meta = (ClampMin = "1.0"))
+	float FloorProbeSpacing = 50.0f;
+
+	// How far below the capsule the probe looks for the track (cm)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Runner Movement", meta = (ClampMin = "1.0"))
+	float FloorProbeDepth = 10.0f;
+
+	// Floors at least this flat (normal Z) count as track
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Runner Movement", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float TrackNormalZ = 0.99f;
+
+	UFUNCTION(BlueprintCallable, Category = "Runner Movement")
+	bool IsRunningOnTrack() const { return MovementMode == MOVE_Custom && CustomMovementMode == static_cast<uint8>(ERunnerMovementMode::Running); }
+
+	UFUNCTION(BlueprintCallable, Category = "Runner Movement")
+	FRunnerMovementStats GetMovementStats() const { return Stats; }
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	// Running counts as being on the ground (jumping, impulses, animation)
+	virtual bool IsMovingOnGround() const override;
+	virtual float GetMaxSpeed() const override;
+
+protected:
+	virtual void PhysCustom(float DeltaTime, int32 Iterations) override;
+	virtual void PhysWalking(float DeltaTime, int32 Iterations) override;
+
+private:
+	UPROPERTY(VisibleInstanceOnly, Category = "Runner Movement")
+	FRunnerMovementStats Stats;
+
+	float DistanceSinceFloorProbe = 0.0f;
+
+	void PhysRunning(float DeltaTime);
+
+	// Leaves Running if the track is not right under the capsule
+	void ProbeTrack();
+};
@@ -1,28 +1,44 @@
-// ScoreBST.h - Binary Search Tree for Score Management
+// ScoreBST.h - Self-Balancing (AVL) Order-Statistic Tree for Score Management
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Algo/Reverse.h"
+#include "BlockArena.h"
+#include "PlayerNameIndex.h"
+#include "PlayerNameTable.h"
+#include "ScoreSnapshot.h"
 
 /**
  * BST Node for storing player scores
+ * 32 bytes, no owned heap memory: the name lives in the tree's FPlayerNameTable
  */
 struct FScoreNode
 {
     int32 Score;
-    FString PlayerName;
+    uint32 PlayerId; // FPlayerNameTable ID, see FScoreBST::GetPlayerName
     FScoreNode* Left;
     FScoreNode* Right;
-    int32 Height; // For AVL balancing (optional)
-    
-    FScoreNode(int32 InScore, const FString& InName)
-        : Score(InScore), PlayerName(InName), Left(nullptr), Right(nullptr), Height(1)
+    int32 Height; // AVL height (leaf = 1)
+    int32 Size;   // Nodes in this subtree (order statistics)
+
+    FScoreNode(int32 InScore, uint32 InPlayerId)
+        : Score(InScore), PlayerId(InPlayerId), Left(nullptr), Right(nullptr), Height(1), Size(1)
     {}
 };
 
 /**
- * Binary Search Tree for managing scores
- * Supports: Insert, Search, Delete, Traversal
- * Time Complexity: O(log n) average for all operations
+ * AVL Tree for managing scores
+ * Stays balanced under monotonic inserts (e.g. a streak of ever-better runs)
+ * Subtree sizes give rank/select queries; all operations are iterative,
+ * so no recursion depth grows with the number of scores
+ * Nodes come from a block arena (stable addresses, bulk free on Clear)
+ * The tree itself is for one thread; EnableSnapshots() publishes an
+ * immutable copy after every change for readers on other threads
+ * Boards that should list each player once use SubmitBest instead of
+ * Insert: an index by player ID keeps one node per player at their best
+ * EnableNameIndex() adds prefix search over the names on the board
+ * Supports: Insert, Search, Delete, Traversal, Rank, Select
+ * Time Complexity: O(log n) worst case for insert/search/delete/rank/select
  */
 class FScoreBST
 {
@@ -30,164 +46,513 @@ private:
     FScoreNode* Root;
     int32 NodeCount;
 
+    TBlockArena<FScoreNode> NodeArena;
+    TSharedRef<FPlayerNameTable> Names;
+
+    // Cached leaderboard head (highest first), rebuilt lazily
+    mutable TArray<FScoreNode*> TopCache;
+    mutable int32 TopCacheCapacity;
+    mutable int32 TopCacheCutoff;       // Lowest cached score, kept by value so deletes never touch freed nodes
+    mutable bool bTopCacheValid;
+
+    // Best-score node of each player that went through SubmitBest, by player ID
+    // (IDs are dense, so the index is a plain array: one load per lookup)
+    TArray<FScoreNode*> BestNodes;
+
+    // Set by EnableNameIndex(); counts every node's player
+    TUniquePtr<FPlayerNameIndex> NameIndex;
+
+    // Set by EnableSnapshots(); mirrors every change
+    TUniquePtr<FScoreSnapshotPublisher> Snapshots;
+
+    // AVL height is at most ~1.44 log2(n), so 64 covers any int32 node count
+    typedef TArray<FScoreNode**, TInlineAllocator<64>> FLinkPath;
+
 public:
-    FScoreBST();
+    // Trees can share one name table (e.g. several boards of the same players)
+    explicit FScoreBST(TSharedPtr<FPlayerNameTable> InNames = nullptr);
     ~FScoreBST();
-    
+
+    FScoreBST(const FScoreBST&) = delete;
+    FScoreBST& operator=(const FScoreBST&) = delete;
+
     // BST Operations
     void Insert(int32 Score, const FString& PlayerName);
+    void Insert(int32 Score, uint32 PlayerId);  // Pre-interned name, no hashing
+
+    // Replace the contents with ascending (Score, PlayerId) pairs - O(n), perfectly balanced
+    void BuildFromSorted(TArrayView<const int32> Scores, TArrayView<const uint32> PlayerIds);
     bool Search(int32 Score) const;
-    void Delete(int32 Score);
-    
+    bool Delete(int32 Score);   // Removes one node with this score
+
+    // One entry per player: a score that doesn't beat the player's best is
+    // dropped in O(1); a better one moves their node in O(log n)
+    // Returns true if the score became the player's best
+    bool SubmitBest(int32 Score, const FString& PlayerName);
+    bool SubmitBest(int32 Score, uint32 PlayerId);
+    const FScoreNode* FindPlayerBest(uint32 PlayerId) const;   // O(1), nullptr if none submitted
+    int32 GetPlayerRank(uint32 PlayerId) const;                // Rank of their best, 0 if none
+
     // Traversal Methods (different orderings)
     TArray<FScoreNode*> InOrderTraversal() const;     // Sorted ascending
     TArray<FScoreNode*> PreOrderTraversal() const;
     TArray<FScoreNode*> PostOrderTraversal() const;
-    
+
+    // Order statistics - O(log n)
+    int32 GetRank(int32 Score) const;                 // 1 + number of higher scores
+    FScoreNode* SelectByRank(int32 Rank) const;       // 1 = highest score
+    int32 CountGreater(int32 Score) const;
+    int32 CountLess(int32 Score) const;
+
     // Utility functions
     int32 FindMin() const;
     int32 FindMax() const;
     int32 GetHeight() const;
     int32 GetNodeCount() const { return NodeCount; }
+    SIZE_T GetAllocatedSize() const;
     bool IsEmpty() const { return Root == nullptr; }
-    
-    // Get top N scores (for leaderboard)
+
+    // Get top N scores (for leaderboard) - O(log n + N)
     TArray<FScoreNode*> GetTopScores(int32 Count) const;
-    
-    // Clear tree
+
+    // Rows from a 1-based rank downwards, e.g. the page around GetPlayerRank - O(log n + Count)
+    TArray<FScoreNode*> GetScoresFromRank(int32 FirstRank, int32 Count) const;
+
+    // Same, served from a cache that only inserts/deletes at or above the
+    // cached cut-off invalidate - O(1) on a hit, view valid until the next change
+    TArrayView<FScoreNode* const> GetTopScoresCached(int32 Count) const;
+
+    // Names
+    FPlayerNameTable& GetNameTable() { return *Names; }
+    const FPlayerNameTable& GetNameTable() const { return *Names; }
+    uint32 InternPlayerName(const FString& PlayerName) { return Names->Intern(PlayerName); }
+    const FString& GetPlayerName(const FScoreNode* Node) const { return Names->GetName(Node->PlayerId); }
+
+    // Clear tree (names stay interned)
     void Clear();
 
+    // Name search, kept in step with inserts and deletes once enabled
+    void EnableNameIndex();
+    bool HasNameIndex() const { return NameIndex.IsValid(); }
+    const FPlayerNameIndex* GetNameIndex() const { return NameIndex.Get(); }
+
+    // Players on the board whose name starts with Prefix (any case), alphabetical;
+    // returns the total number of matches - O(prefix + MaxResults)
+    int32 FindPlayersByPrefix(const FString& Prefix, int32 MaxResults, TArray<uint32>& OutPlayerIds) const;
+
+    // Immutable versions for other threads. Enable before sharing the tree;
+    // from then on every change costs O(sqrt n) extra to publish
+    void EnableSnapshots();
+    bool HasSnapshots() const { return Snapshots.IsValid(); }
+
+    // Any thread, once enabled - never blocks the thread that changes the tree
+    TSharedRef<const FScoreSnapshot, ESPMode::ThreadSafe> GetSnapshot() const;
+
 private:
-    // Helper recursive functions
-    FScoreNode* InsertRecursive(FScoreNode* Node, int32 Score, const FString& PlayerName);
-    bool SearchRecursive(FScoreNode* Node, int32 Score) const;
-    FScoreNode* DeleteRecursive(FScoreNode* Node, int32 Score);
-    
+    void FreeAllNodes();
+
+    // Attach a detached node by (Score, PlayerId) / detach the node at Link (Path = links above it)
+    void LinkNode(FScoreNode* Node);
+    void UnlinkNode(FLinkPath& Path, FScoreNode** Link);
+    FScoreNode** FindLink(const FScoreNode* Target, FLinkPath& OutPath);
+
     FScoreNode* FindMinNode(FScoreNode* Node) const;
     FScoreNode* FindMaxNode(FScoreNode* Node) const;
-    
-    void InOrderRecursive(FScoreNode* Node, TArray<FScoreNode*>& Result) const;
-    void PreOrderRecursive(FScoreNode* Node, TArray<FScoreNode*>& Result) const;
-    void PostOrderRecursive(FScoreNode* Node, TArray<FScoreNode*>& Result) const;
-    
-    int32 GetHeightRecursive(FScoreNode* Node) const;
-    void ClearRecursive(FScoreNode* Node);
+
+    // AVL helpers
+    static bool IsOrderedBefore(const FScoreNode* A, const FScoreNode* B)
+    {
+        return A->Score != B->Score ? A->Score < B->Score : A->PlayerId < B->PlayerId;
+    }
+
+    static int32 HeightOf(const FScoreNode* Node) { return Node ? Node->Height : 0; }
+    static int32 SizeOf(const FScoreNode* Node) { return Node ? Node->Size : 0; }
+    static void UpdateNode(FScoreNode* Node);
+    static FScoreNode* RotateLeft(FScoreNode* Node);
+    static FScoreNode* RotateRight(FScoreNode* Node);
+    static FScoreNode* Rebalance(FScoreNode* Node);
+    static void RebalancePath(FLinkPath& Path);
+
+    // Could a change at this score alter the cached top entries?
+    void InvalidateTopCache(int32 Score);
 };
 
 // ===== IMPLEMENTATION =====
 
-inline FScoreBST::FScoreBST() : Root(nullptr), NodeCount(0) {}
+inline FScoreBST::FScoreBST(TSharedPtr<FPlayerNameTable> InNames)
+    : Root(nullptr)
+    , NodeCount(0)
+    , Names(InNames.IsValid() ? InNames.ToSharedRef() : MakeShared<FPlayerNameTable>())
+    , TopCacheCapacity(0)
+    , TopCacheCutoff(0)
+    , bTopCacheValid(false)
+{}
 
 inline FScoreBST::~FScoreBST()
 {
-    Clear();
+    FreeAllNodes();
 }
 
-inline void FScoreBST::Insert(int32 Score, const FString& PlayerName)
+inline void FScoreBST::UpdateNode(FScoreNode* Node)
 {
-    Root = InsertRecursive(Root, Score, PlayerName);
-    NodeCount++;
+    Node->Height = 1 + FMath::Max(HeightOf(Node->Left), HeightOf(Node->Right));
+    Node->Size = 1 + SizeOf(Node->Left) + SizeOf(Node->Right);
+}
+
+//     Node              Pivot
+//    /    \            /     \
+//   A    Pivot  =>   Node     C
+//        /   \      /    \
+//       B     C    A      B
+inline FScoreNode* FScoreBST::RotateLeft(FScoreNode* Node)
+{
+    FScoreNode* Pivot = Node->Right;
+    Node->Right = Pivot->Left;
+    Pivot->Left = Node;
+    UpdateNode(Node);
+    UpdateNode(Pivot);
+    return Pivot;
+}
+
+inline FScoreNode* FScoreBST::RotateRight(FScoreNode* Node)
+{
+    FScoreNode* Pivot = Node->Left;
+    Node->Left = Pivot->Right;
+    Pivot->Right = Node;
+    UpdateNode(Node);
+    UpdateNode(Pivot);
+    return Pivot;
 }
 
-inline FScoreNode* FScoreBST::InsertRecursive(FScoreNode* Node, int32 Score, const FString& PlayerName)
+// Restore the AVL invariant at Node (children already balanced), returns new subtree root
+inline FScoreNode* FScoreBST::Rebalance(FScoreNode* Node)
 {
-    // Base case: empty spot found
-    if (Node == nullptr)
+    UpdateNode(Node);
+    const int32 Balance = HeightOf(Node->Left) - HeightOf(Node->Right);
+
+    if (Balance > 1)
     {
-        return new FScoreNode(Score, PlayerName);
+        // Left-Right case: straighten first
+        if (HeightOf(Node->Left->Left) < HeightOf(Node->Left->Right))
+        {
+            Node->Left = RotateLeft(Node->Left);
+        }
+        return RotateRight(Node);
     }
-    
-    // Recursive insertion
-    if (Score < Node->Score)
+    if (Balance < -1)
     {
-        Node->Left = InsertRecursive(Node->Left, Score, PlayerName);
+        // Right-Left case: straighten first
+        if (HeightOf(Node->Right->Right) < HeightOf(Node->Right->Left))
+        {
+            Node->Right = RotateRight(Node->Right);
+        }
+        return RotateLeft(Node);
     }
-    else if (Score > Node->Score)
+    return Node;
+}
+
+// Walk back up a recorded descent, fixing heights/sizes and rotating where needed
+inline void FScoreBST::RebalancePath(FLinkPath& Path)
+{
+    for (int32 i = Path.Num() - 1; i >= 0; i--)
     {
-        Node->Right = InsertRecursive(Node->Right, Score, PlayerName);
+        *Path[i] = Rebalance(*Path[i]);
     }
-    // If equal, allow duplicates by going right
-    else
+}
+
+inline void FScoreBST::Insert(int32 Score, const FString& PlayerName)
+{
+    Insert(Score, Names->Intern(PlayerName));
+}
+
+inline void FScoreBST::Insert(int32 Score, uint32 PlayerId)
+{
+    LinkNode(NodeArena.New(Score, PlayerId));
+    NodeCount++;
+    InvalidateTopCache(Score);
+
+    if (NameIndex)
     {
-        Node->Right = InsertRecursive(Node->Right, Score, PlayerName);
+        NameIndex->Add(PlayerId);
+    }
+
+    if (Snapshots)
+    {
+        Snapshots->Add(Score, PlayerId);
     }
-    
-    return Node;
 }
 
-inline bool FScoreBST::Search(int32 Score) const
+inline void FScoreBST::LinkNode(FScoreNode* Node)
 {
-    return SearchRecursive(Root, Score);
+    // Descend iteratively, remembering each parent link
+    FLinkPath Path;
+    FScoreNode** Link = &Root;
+
+    while (*Link != nullptr)
+    {
+        Path.Add(Link);
+        // Ties are ordered by player ID (so FindLink rarely branches); full duplicates go right
+        Link = IsOrderedBefore(Node, *Link) ? &(*Link)->Left : &(*Link)->Right;
+    }
+
+    *Link = Node;
+    RebalancePath(Path);
 }
 
-inline bool FScoreBST::SearchRecursive(FScoreNode* Node, int32 Score) const
+inline void FScoreBST::BuildFromSorted(TArrayView<const int32> Scores, TArrayView<const uint32> PlayerIds)
 {
-    if (Node == nullptr)
-        return false;
-    
-    if (Score == Node->Score)
-        return true;
-    
-    if (Score < Node->Score)
-        return SearchRecursive(Node->Left, Score);
-    else
-        return SearchRecursive(Node->Right, Score);
+    check(Scores.Num() == PlayerIds.Num());
+    FreeAllNodes();
+
+    // Pre-order over index ranges: the middle element roots each range
+    struct FRange
+    {
+        int32 Lo;
+        int32 Hi;
+        FScoreNode** Link;
+    };
+
+    TArray<FRange, TInlineAllocator<64>> Stack;
+    TArray<FScoreNode*> PreOrder;
+    PreOrder.Reserve(Scores.Num());
+
+    if (Scores.Num() > 0)
+        Stack.Push({ 0, Scores.Num() - 1, &Root });
+
+    while (Stack.Num() > 0)
+    {
+        const FRange Range = Stack.Pop(EAllowShrinking::No);
+        const int32 Mid = Range.Lo + (Range.Hi - Range.Lo) / 2;
+
+        FScoreNode* Node = NodeArena.New(Scores[Mid], PlayerIds[Mid]);
+        *Range.Link = Node;
+        PreOrder.Add(Node);
+
+        if (Mid < Range.Hi)
+            Stack.Push({ Mid + 1, Range.Hi, &Node->Right });
+        if (Range.Lo < Mid)
+            Stack.Push({ Range.Lo, Mid - 1, &Node->Left });
+    }
+
+    // Children follow their parent in pre-order, so walking it backwards sizes them first
+    for (int32 i = PreOrder.Num() - 1; i >= 0; i--)
+    {
+        UpdateNode(PreOrder[i]);
+    }
+    NodeCount = Scores.Num();
+
+    if (NameIndex)
+    {
+        for (const uint32 PlayerId : PlayerIds)
+        {
+            NameIndex->Add(PlayerId);
+        }
+    }
+
+    if (Snapshots)
+    {
+        TArray<FScoreSnapshotEntry> Entries;
+        Entries.SetNumUninitialized(Scores.Num());
+        for (int32 i = 0; i < Scores.Num(); i++)
+        {
+            Entries[i] = { Scores[i], PlayerIds[i] };
+        }
+        Snapshots->Rebuild(MoveTemp(Entries));
+    }
 }
 
-inline void FScoreBST::Delete(int32 Score)
+inline bool FScoreBST::Search(int32 Score) const
 {
-    Root = DeleteRecursive(Root, Score);
-    NodeCount--;
+    const FScoreNode* Node = Root;
+    while (Node != nullptr)
+    {
+        if (Score == Node->Score)
+            return true;
+        Node = (Score < Node->Score) ? Node->Left : Node->Right;
+    }
+    return false;
 }
 
-inline FScoreNode* FScoreBST::DeleteRecursive(FScoreNode* Node, int32 Score)
+inline bool FScoreBST::Delete(int32 Score)
 {
-    if (Node == nullptr)
-        return nullptr;
-    
     // Find node to delete
-    if (Score < Node->Score)
+    FLinkPath Path;
+    FScoreNode** Link = &Root;
+
+    while (*Link != nullptr && (*Link)->Score != Score)
+    {
+        Path.Add(Link);
+        Link = (Score < (*Link)->Score) ? &(*Link)->Left : &(*Link)->Right;
+    }
+
+    FScoreNode* Target = *Link;
+    if (Target == nullptr)
+        return false;
+
+    UnlinkNode(Path, Link);
+
+    // Never leave the player index pointing at a freed node
+    if (BestNodes.IsValidIndex(Target->PlayerId) && BestNodes[Target->PlayerId] == Target)
     {
-        Node->Left = DeleteRecursive(Node->Left, Score);
+        BestNodes[Target->PlayerId] = nullptr;
     }
-    else if (Score > Node->Score)
+
+    if (NameIndex)
     {
-        Node->Right = DeleteRecursive(Node->Right, Score);
+        NameIndex->Remove(Target->PlayerId);
+    }
+
+    if (Snapshots)
+    {
+        Snapshots->Remove(Target->Score, Target->PlayerId);
+    }
+
+    NodeArena.Free(Target);
+    NodeCount--;
+    InvalidateTopCache(Score);
+    return true;
+}
+
+inline void FScoreBST::UnlinkNode(FLinkPath& Path, FScoreNode** Link)
+{
+    FScoreNode* Target = *Link;
+
+    if (Target->Left == nullptr || Target->Right == nullptr)
+    {
+        // Case 1 & 2: zero or one child - splice it out
+        *Link = Target->Left ? Target->Left : Target->Right;
     }
     else
     {
-        // Node found - handle 3 cases
-        
-        // Case 1: No children (leaf node)
-        if (Node->Left == nullptr && Node->Right == nullptr)
+        // Case 3: two children - relink the inorder successor into Target's place
+        // (nodes are moved, not copied, so outside pointers to other nodes stay valid)
+        Path.Add(Link);
+        const int32 TargetRightSlot = Path.Num();
+
+        FScoreNode** SuccessorLink = &Target->Right;
+        while ((*SuccessorLink)->Left != nullptr)
         {
-            delete Node;
-            return nullptr;
+            Path.Add(SuccessorLink);
+            SuccessorLink = &(*SuccessorLink)->Left;
         }
-        
-        // Case 2: One child
-        if (Node->Left == nullptr)
+
+        FScoreNode* Successor = *SuccessorLink;
+        *SuccessorLink = Successor->Right;
+        Successor->Left = Target->Left;
+        Successor->Right = Target->Right;
+        *Link = Successor;
+
+        // That path entry was Target's right link, which now belongs to Successor
+        if (Path.IsValidIndex(TargetRightSlot))
         {
-            FScoreNode* Temp = Node->Right;
-            delete Node;
-            return Temp;
+            Path[TargetRightSlot] = &Successor->Right;
         }
-        if (Node->Right == nullptr)
+    }
+
+    RebalancePath(Path);
+}
+
+inline FScoreNode** FScoreBST::FindLink(const FScoreNode* Target, FLinkPath& OutPath)
+{
+    // A descent by (Score, PlayerId). Only a player's repeated Insert of one score
+    // makes equal keys, and rotations can leave Target on either side of those,
+    // so a tie is searched both ways; without ties the stack never holds more than one
+    struct FVisit
+    {
+        FScoreNode** Link;
+        int32 Depth;
+    };
+
+    TArray<FVisit, TInlineAllocator<64>> Stack;
+    Stack.Push({ &Root, 0 });
+    OutPath.Reset();
+
+    while (Stack.Num() > 0)
+    {
+        const FVisit Visit = Stack.Pop(EAllowShrinking::No);
+        FScoreNode* Node = *Visit.Link;
+        if (Node == nullptr)
+            continue;
+
+        OutPath.SetNum(Visit.Depth, EAllowShrinking::No);
+        if (Node == Target)
+            return Visit.Link;
+
+        OutPath.Add(Visit.Link);
+        if (!IsOrderedBefore(Node, Target))
+            Stack.Push({ &Node->Left, Visit.Depth + 1 });
+        if (!IsOrderedBefore(Target, Node))
+            Stack.Push({ &Node->Right, Visit.Depth + 1 });
+    }
+
+    OutPath.Reset();
+    return nullptr;
+}
+
+inline bool FScoreBST::SubmitBest(int32 Score, const FString& PlayerName)
+{
+    return SubmitBest(Score, Names->Intern(PlayerName));
+}
+
+inline bool FScoreBST::SubmitBest(int32 Score, uint32 PlayerId)
+{
+    if (PlayerId >= static_cast<uint32>(BestNodes.Num()))
+    {
+        BestNodes.SetNumZeroed(FMath::Max(static_cast<int32>(PlayerId) + 1, Names->Num()));
+    }
+
+    FScoreNode* Best = BestNodes[PlayerId];
+    if (Best == nullptr)
+    {
+        Best = NodeArena.New(Score, PlayerId);
+        BestNodes[PlayerId] = Best;
+        LinkNode(Best);
+        NodeCount++;
+        InvalidateTopCache(Score);
+
+        if (NameIndex)
         {
-            FScoreNode* Temp = Node->Left;
-            delete Node;
-            return Temp;
+            NameIndex->Add(PlayerId);
         }
-        
-        // Case 3: Two children
-        // Find inorder successor (min in right subtree)
-        FScoreNode* Successor = FindMinNode(Node->Right);
-        Node->Score = Successor->Score;
-        Node->PlayerName = Successor->PlayerName;
-        Node->Right = DeleteRecursive(Node->Right, Successor->Score);
-    }
-    
-    return Node;
+
+        if (Snapshots)
+        {
+            Snapshots->Add(Score, PlayerId);
+        }
+        return true;
+    }
+
+    if (Score <= Best->Score)
+        return false;
+
+    // Same node, new position: outside pointers to it stay valid
+    FLinkPath Path;
+    FScoreNode** Link = FindLink(Best, Path);
+    check(Link);
+    UnlinkNode(Path, Link);
+
+    const int32 OldScore = Best->Score;
+    *Best = FScoreNode(Score, PlayerId);
+    LinkNode(Best);
+    InvalidateTopCache(OldScore);
+    InvalidateTopCache(Score);
+
+    if (Snapshots)
+    {
+        Snapshots->Move(OldScore, Score, PlayerId);
+    }
+    return true;
+}
+
+inline const FScoreNode* FScoreBST::FindPlayerBest(uint32 PlayerId) const
+{
+    return PlayerId < static_cast<uint32>(BestNodes.Num()) ? BestNodes[PlayerId] : nullptr;
+}
+
+inline int32 FScoreBST::GetPlayerRank(uint32 PlayerId) const
+{
+    const FScoreNode* Best = FindPlayerBest(PlayerId);
+    return Best ? GetRank(Best->Score) : 0;
 }
 
 inline FScoreNode* FScoreBST::FindMinNode(FScoreNode* Node) const
@@ -224,100 +589,324 @@ inline int32 FScoreBST::FindMax() const
 inline TArray<FScoreNode*> FScoreBST::InOrderTraversal() const
 {
     TArray<FScoreNode*> Result;
-    InOrderRecursive(Root, Result);
-    return Result;
-}
+    Result.Reserve(NodeCount);
 
-inline void FScoreBST::InOrderRecursive(FScoreNode* Node, TArray<FScoreNode*>& Result) const
-{
-    if (Node == nullptr)
-        return;
-    
-    InOrderRecursive(Node->Left, Result);
-    Result.Add(Node);
-    InOrderRecursive(Node->Right, Result);
+    // Explicit stack instead of recursion
+    TArray<FScoreNode*, TInlineAllocator<64>> Stack;
+    FScoreNode* Node = Root;
+
+    while (Node != nullptr || Stack.Num() > 0)
+    {
+        while (Node != nullptr)
+        {
+            Stack.Push(Node);
+            Node = Node->Left;
+        }
+        Node = Stack.Pop(EAllowShrinking::No);
+        Result.Add(Node);
+        Node = Node->Right;
+    }
+    return Result;
 }
 
 // Pre-Order Traversal: Root -> Left -> Right
 inline TArray<FScoreNode*> FScoreBST::PreOrderTraversal() const
 {
     TArray<FScoreNode*> Result;
-    PreOrderRecursive(Root, Result);
-    return Result;
-}
+    Result.Reserve(NodeCount);
 
-inline void FScoreBST::PreOrderRecursive(FScoreNode* Node, TArray<FScoreNode*>& Result) const
-{
-    if (Node == nullptr)
-        return;
-    
-    Result.Add(Node);
-    PreOrderRecursive(Node->Left, Result);
-    PreOrderRecursive(Node->Right, Result);
+    TArray<FScoreNode*, TInlineAllocator<64>> Stack;
+    if (Root)
+        Stack.Push(Root);
+
+    while (Stack.Num() > 0)
+    {
+        FScoreNode* Node = Stack.Pop(EAllowShrinking::No);
+        Result.Add(Node);
+
+        // Right first so Left is visited first
+        if (Node->Right)
+            Stack.Push(Node->Right);
+        if (Node->Left)
+            Stack.Push(Node->Left);
+    }
+    return Result;
 }
 
 // Post-Order Traversal: Left -> Right -> Root
 inline TArray<FScoreNode*> FScoreBST::PostOrderTraversal() const
 {
     TArray<FScoreNode*> Result;
-    PostOrderRecursive(Root, Result);
+    Result.Reserve(NodeCount);
+
+    // Root -> Right -> Left, then reversed
+    TArray<FScoreNode*, TInlineAllocator<64>> Stack;
+    if (Root)
+        Stack.Push(Root);
+
+    while (Stack.Num() > 0)
+    {
+        FScoreNode* Node = Stack.Pop(EAllowShrinking::No);
+        Result.Add(Node);
+
+        if (Node->Left)
+            Stack.Push(Node->Left);
+        if (Node->Right)
+            Stack.Push(Node->Right);
+    }
+
+    Algo::Reverse(Result);
     return Result;
 }
 
-inline void FScoreBST::PostOrderRecursive(FScoreNode* Node, TArray<FScoreNode*>& Result) const
+// Stored AVL height - O(1)
+inline int32 FScoreBST::GetHeight() const
 {
-    if (Node == nullptr)
-        return;
-    
-    PostOrderRecursive(Node->Left, Result);
-    PostOrderRecursive(Node->Right, Result);
-    Result.Add(Node);
+    return HeightOf(Root);
 }
 
-inline int32 FScoreBST::GetHeight() const
+// Number of scores strictly greater than Score - O(log n)
+inline int32 FScoreBST::CountGreater(int32 Score) const
+{
+    int32 Count = 0;
+    const FScoreNode* Node = Root;
+
+    while (Node != nullptr)
+    {
+        if (Node->Score > Score)
+        {
+            // This node and its whole right subtree beat Score
+            Count += 1 + SizeOf(Node->Right);
+            Node = Node->Left;
+        }
+        else
+        {
+            Node = Node->Right;
+        }
+    }
+    return Count;
+}
+
+// Number of scores strictly less than Score - O(log n)
+inline int32 FScoreBST::CountLess(int32 Score) const
 {
-    return GetHeightRecursive(Root);
+    int32 Count = 0;
+    const FScoreNode* Node = Root;
+
+    while (Node != nullptr)
+    {
+        if (Node->Score < Score)
+        {
+            Count += 1 + SizeOf(Node->Left);
+            Node = Node->Right;
+        }
+        else
+        {
+            Node = Node->Left;
+        }
+    }
+    return Count;
 }
 
-inline int32 FScoreBST::GetHeightRecursive(FScoreNode* Node) const
+// Leaderboard position a score would have (ties share a rank) - O(log n)
+inline int32 FScoreBST::GetRank(int32 Score) const
 {
-    if (Node == nullptr)
-        return 0;
-    
-    int32 LeftHeight = GetHeightRecursive(Node->Left);
-    int32 RightHeight = GetHeightRecursive(Node->Right);
-    
-    return 1 + FMath::Max(LeftHeight, RightHeight);
+    return CountGreater(Score) + 1;
 }
 
-// Get top N highest scores (reverse in-order traversal)
+// Node at a 1-based leaderboard position (1 = highest) - O(log n)
+inline FScoreNode* FScoreBST::SelectByRank(int32 Rank) const
+{
+    if (Rank < 1 || Rank > NodeCount)
+        return nullptr;
+
+    int32 Remaining = Rank - 1; // Nodes still to skip, counting from the top
+    FScoreNode* Node = Root;
+
+    while (Node != nullptr)
+    {
+        const int32 RightSize = SizeOf(Node->Right);
+        if (Remaining < RightSize)
+        {
+            Node = Node->Right;
+        }
+        else if (Remaining == RightSize)
+        {
+            return Node;
+        }
+        else
+        {
+            Remaining -= RightSize + 1;
+            Node = Node->Left;
+        }
+    }
+    return nullptr;
+}
+
+// Get top N highest scores (reverse in-order traversal, stops after N)
 inline TArray<FScoreNode*> FScoreBST::GetTopScores(int32 Count) const
 {
-    TArray<FScoreNode*> AllScores = InOrderTraversal();
     TArray<FScoreNode*> TopScores;
-    
-    // Reverse to get highest first
-    for (int32 i = AllScores.Num() - 1; i >= 0 && TopScores.Num() < Count; i--)
+    TopScores.Reserve(FMath::Clamp(Count, 0, NodeCount));
+
+    // Right -> Root -> Left visits scores highest first
+    TArray<FScoreNode*, TInlineAllocator<64>> Stack;
+    FScoreNode* Node = Root;
+
+    while ((Node != nullptr || Stack.Num() > 0) && TopScores.Num() < Count)
     {
-        TopScores.Add(AllScores[i]);
+        while (Node != nullptr)
+        {
+            Stack.Push(Node);
+            Node = Node->Right;
+        }
+        Node = Stack.Pop(EAllowShrinking::No);
+        TopScores.Add(Node);
+        Node = Node->Left;
     }
-    
+
     return TopScores;
 }
 
+inline TArray<FScoreNode*> FScoreBST::GetScoresFromRank(int32 FirstRank, int32 Count) const
+{
+    TArray<FScoreNode*> Rows;
+    if (FirstRank < 1 || FirstRank > NodeCount || Count <= 0)
+        return Rows;
+    Rows.Reserve(FMath::Min(Count, NodeCount - FirstRank + 1));
+
+    // Descend as SelectByRank does, keeping the nodes still to come in
+    // Right -> Root -> Left order, then carry on like GetTopScores
+    TArray<FScoreNode*, TInlineAllocator<64>> Stack;
+    int32 Remaining = FirstRank - 1;
+    FScoreNode* Node = Root;
+
+    while (Node != nullptr)
+    {
+        const int32 RightSize = SizeOf(Node->Right);
+        if (Remaining < RightSize)
+        {
+            Stack.Push(Node);
+            Node = Node->Right;
+        }
+        else if (Remaining == RightSize)
+        {
+            Stack.Push(Node);
+            break;
+        }
+        else
+        {
+            Remaining -= RightSize + 1;
+            Node = Node->Left;
+        }
+    }
+
+    Node = nullptr;
+    while ((Node != nullptr || Stack.Num() > 0) && Rows.Num() < Count)
+    {
+        while (Node != nullptr)
+        {
+            Stack.Push(Node);
+            Node = Node->Right;
+        }
+        Node = Stack.Pop(EAllowShrinking::No);
+        Rows.Add(Node);
+        Node = Node->Left;
+    }
+    return Rows;
+}
+
+inline TArrayView<FScoreNode* const> FScoreBST::GetTopScoresCached(int32 Count) const
+{
+    if (!bTopCacheValid || Count > TopCacheCapacity)
+    {
+        TopCacheCapacity = FMath::Max(Count, TopCacheCapacity);
+        TopCache = GetTopScores(TopCacheCapacity);
+        TopCacheCutoff = TopCache.Num() > 0 ? TopCache.Last()->Score : 0;
+        bTopCacheValid = true;
+    }
+    return TArrayView<FScoreNode* const>(TopCache.GetData(), FMath::Clamp(Count, 0, TopCache.Num()));
+}
+
+inline void FScoreBST::InvalidateTopCache(int32 Score)
+{
+    // A full cache only changes if Score reaches its lowest entry
+    // (an equal score may be ordered ahead of it); a partial cache holds every node
+    if (bTopCacheValid && (TopCache.Num() < TopCacheCapacity || Score >= TopCacheCutoff))
+    {
+        bTopCacheValid = false;
+    }
+}
+
+inline SIZE_T FScoreBST::GetAllocatedSize() const
+{
+    // Name table excluded: it may be shared with other trees
+    return NodeArena.GetAllocatedSize() + TopCache.GetAllocatedSize() + BestNodes.GetAllocatedSize()
+        + (NameIndex ? NameIndex->GetAllocatedSize() : 0);
+}
+
 inline void FScoreBST::Clear()
 {
-    ClearRecursive(Root);
+    FreeAllNodes();
+
+    if (Snapshots)
+    {
+        Snapshots->Rebuild(TArray<FScoreSnapshotEntry>());
+    }
+}
+
+inline void FScoreBST::FreeAllNodes()
+{
+    // Nodes own nothing, so the whole arena goes at once - no tree walk
+    NodeArena.Reset();
+
     Root = nullptr;
     NodeCount = 0;
+    BestNodes.Reset();
+    if (NameIndex)
+    {
+        NameIndex->Reset();
+    }
+    TopCache.Reset();
+    bTopCacheValid = false;
 }
 
-inline void FScoreBST::ClearRecursive(FScoreNode* Node)
+inline void FScoreBST::EnableNameIndex()
 {
-    if (Node == nullptr)
+    if (NameIndex)
         return;
-    
-    ClearRecursive(Node->Left);
-    ClearRecursive(Node->Right);
-    delete Node;
-}
\ No newline at end of file
+
+    NameIndex = MakeUnique<FPlayerNameIndex>(Names);
+    for (const FScoreNode* Node : PreOrderTraversal())
+    {
+        NameIndex->Add(Node->PlayerId);
+    }
+}
+
+inline int32 FScoreBST::FindPlayersByPrefix(const FString& Prefix, int32 MaxResults, TArray<uint32>& OutPlayerIds) const
+{
+    check(NameIndex);
+    return NameIndex->FindByPrefix(Prefix, MaxResults, OutPlayerIds);
+}
+
+inline void FScoreBST::EnableSnapshots()
+{
+    if (Snapshots)
+        return;
+
+    Snapshots = MakeUnique<FScoreSnapshotPublisher>(Names);
+
+    TArray<FScoreSnapshotEntry> Entries;
+    Entries.Reserve(NodeCount);
+    for (const FScoreNode* Node : InOrderTraversal())
+    {
+        Entries.Add({ Node->Score, Node->PlayerId });
+    }
+    Snapshots->Rebuild(MoveTemp(Entries));
+}
+
+inline TSharedRef<const FScoreSnapshot, ESPMode::ThreadSafe> FScoreBST::GetSnapshot() const
+{
+    check(Snapshots);
+    return Snapshots->Acquire();
+}
@@ -0,0 +1,127 @@
+// ScoreServerCommandlet.cpp - Runs the local leaderboard stand-in, optionally under load
+
+#include "ScoreServerCommandlet.h"
+#include "LocalScoreServer.h"
+#include "ScoreSubmitter.h"
+#include "Containers/Ticker.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+// Commandlets have no engine loop: tick the HTTP client/server tickers by hand
+static void PumpTickers(double& LastTime)
+{
+	const double Now = FPlatformTime::Seconds();
+	FTSTicker::GetCoreTicker().Tick(static_cast<float>(Now - LastTime));
+	LastTime = Now;
+	FPlatformProcess::Sleep(0.0f);
+}
+
+UScoreServerCommandlet::UScoreServerCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UScoreServerCommandlet::Main(const FString& Params)
+{
+	uint32 Port = 8085;
+	FString Dir = TEXT("ScoreServer");
+	int32 LoadTest = 0;
+	int32 Batch = 100;
+	float FailureRate = 0.0f;
+	float DuplicateRate = 0.05f;
+
+	FParse::Value(*Params, TEXT("Port="), Port);
+	FParse::Value(*Params, TEXT("Dir="), Dir);
+	FParse::Value(*Params, TEXT("LoadTest="), LoadTest);
+	FParse::Value(*Params, TEXT("Batch="), Batch);
+	FParse::Value(*Params, TEXT("FailureRate="), FailureRate);
+	FParse::Value(*Params, TEXT("DuplicateRate="), DuplicateRate);
+
+	const FString Directory = FPaths::Combine(FPaths::ProjectSavedDir(), Dir);
+	if (LoadTest > 0)
+	{
+		// Start from nothing so the counts below can be checked exactly
+		IFileManager::Get().DeleteDirectory(*Directory, false, true);
+	}
+
+	FLocalScoreServer Server;
+	Server.FailureRate = FailureRate;
+	if (!Server.Start(Port, Directory))
+		return 1;
+
+	double LastTime = FPlatformTime::Seconds();
+	if (LoadTest <= 0)
+	{
+		while (!IsEngineExitRequested())
+		{
+			PumpTickers(LastTime);
+		}
+		return 0;
+	}
+
+	// ===== LOAD TEST =====
+	TSharedRef<FScoreSubmitter> Submitter = MakeShared<FScoreSubmitter>();
+	Submitter->MaxBatchSize = Batch;
+	Submitter->FlushInterval = 0.01f;
+	Submitter->RetryBaseDelay = 0.05f;
+	Submitter->RetryMaxDelay = 1.0f;
+	Submitter->Start(FPaths::Combine(Directory, TEXT("Outbox")), FString::Printf(TEXT("http://127.0.0.1:%u/scores"), Port));
+
+	FRandomStream Random(1234);
+	TArray<FString> RunIds;
+	RunIds.Reserve(LoadTest);
+
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 i = 0; i < LoadTest; i++)
+	{
+		FScoreSubmission Run;
+		Run.PlayerName = FString::Printf(TEXT("Bot%d"), i % 100);
+		Run.Score = Random.RandRange(0, 5000);
+		Run.Distance = Random.FRandRange(1000.0f, 500000.0f);
+		Run.Duration = Random.FRandRange(10.0f, 600.0f);
+
+		// Some runs are sent again under the same ID, like a client resending after a crash
+		const bool bResend = RunIds.Num() > 0 && Random.FRand() < DuplicateRate;
+		if (bResend)
+		{
+			Run.RunId = RunIds[Random.RandRange(0, RunIds.Num() - 1)];
+		}
+
+		const FString RunId = Submitter->Submit(Run);
+		if (!bResend)
+		{
+			RunIds.Add(RunId);
+		}
+
+		if (i % 64 == 0)
+		{
+			PumpTickers(LastTime);
+		}
+	}
+	const double SubmitTime = FPlatformTime::Seconds() - StartTime;
+
+	while (!Submitter->IsIdle() && !IsEngineExitRequested())
+	{
+		PumpTickers(LastTime);
+	}
+	const double TotalTime = FPlatformTime::Seconds() - StartTime;
+
+	const FScoreSubmitterStats& Stats = Submitter->GetStats();
+	UE_LOG(LogTemp, Display, TEXT("=== Score Submission Load Test ==="));
+	UE_LOG(LogTemp, Display, TEXT("Runs: %d (%d unique), Submit() %.1f us/run on the calling thread"),
+		LoadTest, RunIds.Num(), SubmitTime * 1e6 / LoadTest);
+	UE_LOG(LogTemp, Display, TEXT("Delivered in %.2f s: %.0f runs/s, %d batches, %d failed attempts (%d injected)"),
+		TotalTime, Stats.Acked / TotalTime, Stats.Batches, Stats.Failures, Server.GetInjectedFailureCount());
+	UE_LOG(LogTemp, Display, TEXT("Server: %d requests, %d stored, %d duplicates dropped, store holds %d"),
+		Server.GetRequestCount(), Server.GetAcceptedCount(), Server.GetDuplicateCount(), Server.GetStore().Num());
+
+	Submitter->Stop();
+
+	// Every unique run exactly once, whatever was retried or resent
+	const bool bPassed = Server.GetAcceptedCount() == RunIds.Num() && Server.GetStore().Num() == RunIds.Num();
+	UE_LOG(LogTemp, Display, TEXT("Load test %s"), bPassed ? TEXT("PASSED") : TEXT("FAILED"));
+	return bPassed ? 0 : 1;
+}
@@ -0,0 +1,30 @@
+// ScoreServerCommandlet.h - Runs the local leaderboard stand-in, optionally under load
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ScoreServerCommandlet.generated.h"
+
+/**
+ * Serves the local leaderboard service until the process is stopped, or
+ * load-tests the whole submission path (outbox, batching, retries, de-dupe)
+ * against an in-process server and exits
+ *
+ * Usage:
+ *   UnrealEditor-Cmd CPP_EndlessRunner.uproject -run=ScoreServer [-Port=8085] [-Dir=ScoreServer]
+ *   UnrealEditor-Cmd CPP_EndlessRunner.uproject -run=ScoreServer -LoadTest=20000
+ *       [-Batch=100] [-FailureRate=0.05] [-DuplicateRate=0.05]
+ *
+ * -Dir is relative to the project Saved directory
+ */
+UCLASS()
+class CPP_ENDLESSRUNNER_API UScoreServerCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UScoreServerCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
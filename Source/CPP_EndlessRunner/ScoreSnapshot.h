@@ -0,0 +1,358 @@
+// ScoreSnapshot.h - Immutable leaderboard versions that any thread can query
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/ScopeRWLock.h"
+#include "PlayerNameTable.h"
+#include "RadixSort.h"
+#include "SortedSearch.h"
+
+struct FScoreSnapshotEntry
+{
+    int32 Score;
+    uint32 PlayerId;
+
+    // Score order, ties by player, so a removed entry can be matched to its base entry
+    bool operator<(const FScoreSnapshotEntry& Other) const
+    {
+        return Score != Other.Score ? Score < Other.Score : PlayerId < Other.PlayerId;
+    }
+
+    bool operator==(const FScoreSnapshotEntry& Other) const
+    {
+        return Score == Other.Score && PlayerId == Other.PlayerId;
+    }
+};
+
+/**
+ * One published version of a leaderboard; never changes once published
+ * A large sorted base is shared by every version since the last compaction,
+ * and each version carries its own short sorted lists of entries added and
+ * removed since then (the same split as the store's snapshot and log)
+ * A reader holding a version sees one consistent leaderboard for as long as
+ * it keeps it, whatever the writer does meanwhile
+ * Time Complexity: O(log n) rank, O(K + removed entries passed) top K
+ */
+class FScoreSnapshot
+{
+private:
+    typedef TSharedRef<const TArray<FScoreSnapshotEntry>, ESPMode::ThreadSafe> FSharedEntries;
+    typedef TSharedRef<const TArray<FString>, ESPMode::ThreadSafe> FSharedNames;
+
+    FSharedEntries Base;                    // Ascending
+    TArray<FScoreSnapshotEntry> Added;      // Ascending, not in Base
+    TArray<FScoreSnapshotEntry> Removed;    // Ascending, each cancels one Base entry
+
+    // Names by player ID, split the same way
+    FSharedNames BaseNames;
+    TArray<FString> AddedNames;
+
+    int32 NumEntries;
+    uint64 Version;
+
+    friend class FScoreSnapshotPublisher;
+
+public:
+    FScoreSnapshot();
+
+    // Order statistics, same meaning as FScoreBST's - O(log n)
+    int32 GetRank(int32 Score) const { return CountGreater(Score) + 1; }
+    int32 CountGreater(int32 Score) const;
+    int32 CountLess(int32 Score) const;
+
+    // Highest first
+    TArray<FScoreSnapshotEntry> GetTopScores(int32 Count) const;
+
+    const FString& GetPlayerName(uint32 PlayerId) const;
+
+    // Utility
+    int32 Num() const { return NumEntries; }
+    bool IsEmpty() const { return NumEntries == 0; }
+    uint64 GetVersion() const { return Version; }   // Increases with every published change
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    static int32 CountAbove(const TArray<FScoreSnapshotEntry>& Entries, int32 Score);
+    static int32 CountBelow(const TArray<FScoreSnapshotEntry>& Entries, int32 Score);
+};
+
+/**
+ * Single writer, any number of readers: the writer builds the next version
+ * beside the current one and swaps a reference to it in; readers take a
+ * reference and query without further locking. The lock only guards that
+ * reference, so neither side ever waits on the other's queries or updates,
+ * and a version is freed when its last reader lets go (RCU with reference
+ * counts instead of grace periods)
+ * Each change copies the short added/removed lists; once they reach
+ * ~sqrt(n) they are merged into a new base, which keeps both the per-change
+ * copy and the amortized merge at O(sqrt n)
+ */
+class FScoreSnapshotPublisher
+{
+private:
+    // Read only on the writer's thread, to copy new names into versions
+    TSharedRef<FPlayerNameTable> Names;
+
+    // Written by the writer under the lock; readers copy it under the lock
+    TSharedRef<const FScoreSnapshot, ESPMode::ThreadSafe> Latest;
+    mutable FRWLock LatestLock;
+
+public:
+    // Added/removed lists never compact below this size
+    static constexpr int32 MinCompactThreshold = 64;
+
+    explicit FScoreSnapshotPublisher(TSharedRef<FPlayerNameTable> InNames);
+
+    // Writer side: mirror one change of the owning tree and publish it
+    void Add(int32 Score, uint32 PlayerId);
+    void Remove(int32 Score, uint32 PlayerId);   // The entry must be present
+    void Move(int32 OldScore, int32 NewScore, uint32 PlayerId);   // One version, never a gap
+    void Rebuild(TArray<FScoreSnapshotEntry>&& Entries);   // Any order
+
+    // Any thread - O(1), never waits for the writer to finish building
+    TSharedRef<const FScoreSnapshot, ESPMode::ThreadSafe> Acquire() const;
+
+private:
+    // New version sharing the latest one's base
+    TSharedRef<FScoreSnapshot, ESPMode::ThreadSafe> BeginVersion() const;
+    void Publish(TSharedRef<FScoreSnapshot, ESPMode::ThreadSafe> Next);
+    void CopyNewNames(FScoreSnapshot& Next) const;
+    static void AddEntry(FScoreSnapshot& Next, const FScoreSnapshotEntry& Entry);
+    static void RemoveEntry(FScoreSnapshot& Next, const FScoreSnapshotEntry& Entry);
+    static void Compact(FScoreSnapshot& Next);
+};
+
+// ===== IMPLEMENTATION =====
+
+inline FScoreSnapshot::FScoreSnapshot()
+    : Base(MakeShared<const TArray<FScoreSnapshotEntry>, ESPMode::ThreadSafe>())
+    , BaseNames(MakeShared<const TArray<FString>, ESPMode::ThreadSafe>())
+    , NumEntries(0)
+    , Version(0)
+{}
+
+inline int32 FScoreSnapshot::CountAbove(const TArray<FScoreSnapshotEntry>& Entries, int32 Score)
+{
+    return Entries.Num() - FSortedSearch::UpperBound(Entries.GetData(), Entries.Num(), Score,
+        [](const FScoreSnapshotEntry& Entry) { return Entry.Score; });
+}
+
+inline int32 FScoreSnapshot::CountBelow(const TArray<FScoreSnapshotEntry>& Entries, int32 Score)
+{
+    return FSortedSearch::LowerBound(Entries.GetData(), Entries.Num(), Score,
+        [](const FScoreSnapshotEntry& Entry) { return Entry.Score; });
+}
+
+inline int32 FScoreSnapshot::CountGreater(int32 Score) const
+{
+    return CountAbove(*Base, Score) + CountAbove(Added, Score) - CountAbove(Removed, Score);
+}
+
+inline int32 FScoreSnapshot::CountLess(int32 Score) const
+{
+    return CountBelow(*Base, Score) + CountBelow(Added, Score) - CountBelow(Removed, Score);
+}
+
+inline TArray<FScoreSnapshotEntry> FScoreSnapshot::GetTopScores(int32 Count) const
+{
+    TArray<FScoreSnapshotEntry> TopScores;
+    TopScores.Reserve(FMath::Clamp(Count, 0, NumEntries));
+
+    // Walk base and added lists down together; removed entries cancel base ones in the same order
+    const TArray<FScoreSnapshotEntry>& BaseEntries = *Base;
+    int32 BaseIndex = BaseEntries.Num() - 1;
+    int32 AddedIndex = Added.Num() - 1;
+    int32 RemovedIndex = Removed.Num() - 1;
+
+    while (TopScores.Num() < Count && (BaseIndex >= 0 || AddedIndex >= 0))
+    {
+        const bool bTakeBase = AddedIndex < 0 || (BaseIndex >= 0 && !(BaseEntries[BaseIndex] < Added[AddedIndex]));
+        if (!bTakeBase)
+        {
+            TopScores.Add(Added[AddedIndex--]);
+            continue;
+        }
+
+        const FScoreSnapshotEntry& Entry = BaseEntries[BaseIndex--];
+        if (RemovedIndex >= 0 && Removed[RemovedIndex] == Entry)
+        {
+            RemovedIndex--;
+            continue;
+        }
+        TopScores.Add(Entry);
+    }
+    return TopScores;
+}
+
+inline const FString& FScoreSnapshot::GetPlayerName(uint32 PlayerId) const
+{
+    static const FString Unknown;
+    const uint32 NumBaseNames = static_cast<uint32>(BaseNames->Num());
+    if (PlayerId < NumBaseNames)
+        return (*BaseNames)[PlayerId];
+    return PlayerId - NumBaseNames < static_cast<uint32>(AddedNames.Num()) ? AddedNames[PlayerId - NumBaseNames] : Unknown;
+}
+
+inline SIZE_T FScoreSnapshot::GetAllocatedSize() const
+{
+    // The base is shared with other versions; counted here all the same
+    SIZE_T Bytes = Base->GetAllocatedSize() + Added.GetAllocatedSize() + Removed.GetAllocatedSize()
+        + BaseNames->GetAllocatedSize() + AddedNames.GetAllocatedSize();
+    for (const FString& Name : *BaseNames)
+    {
+        Bytes += Name.GetAllocatedSize();
+    }
+    for (const FString& Name : AddedNames)
+    {
+        Bytes += Name.GetAllocatedSize();
+    }
+    return Bytes;
+}
+
+inline FScoreSnapshotPublisher::FScoreSnapshotPublisher(TSharedRef<FPlayerNameTable> InNames)
+    : Names(InNames)
+    , Latest(MakeShared<const FScoreSnapshot, ESPMode::ThreadSafe>())
+{}
+
+inline TSharedRef<const FScoreSnapshot, ESPMode::ThreadSafe> FScoreSnapshotPublisher::Acquire() const
+{
+    FReadScopeLock Lock(LatestLock);
+    return Latest;
+}
+
+inline TSharedRef<FScoreSnapshot, ESPMode::ThreadSafe> FScoreSnapshotPublisher::BeginVersion() const
+{
+    // Only the writer replaces Latest, so the writer reads it without the lock
+    TSharedRef<FScoreSnapshot, ESPMode::ThreadSafe> Next = MakeShared<FScoreSnapshot, ESPMode::ThreadSafe>(*Latest);
+    Next->Version++;
+    CopyNewNames(*Next);
+    return Next;
+}
+
+inline void FScoreSnapshotPublisher::CopyNewNames(FScoreSnapshot& Next) const
+{
+    // Player IDs are dense and never reused, so new names are always a suffix
+    for (int32 Id = Next.BaseNames->Num() + Next.AddedNames.Num(); Id < Names->Num(); Id++)
+    {
+        Next.AddedNames.Add(Names->GetName(Id));
+    }
+}
+
+inline void FScoreSnapshotPublisher::Publish(TSharedRef<FScoreSnapshot, ESPMode::ThreadSafe> Next)
+{
+    const int32 Threshold = FMath::Max(MinCompactThreshold, FMath::FloorToInt32(FMath::Sqrt(static_cast<float>(Next->Base->Num()))));
+    if (Next->Added.Num() + Next->Removed.Num() > Threshold || Next->AddedNames.Num() > Threshold)
+    {
+        Compact(*Next);
+    }
+
+    TSharedRef<const FScoreSnapshot, ESPMode::ThreadSafe> Previous = Next;
+    {
+        FWriteScopeLock Lock(LatestLock);
+        Swap(Latest, Previous);
+    }
+    // Previous is released here, outside the lock; readers may still hold it
+}
+
+inline void FScoreSnapshotPublisher::Compact(FScoreSnapshot& Next)
+{
+    const TArray<FScoreSnapshotEntry>& OldBase = *Next.Base;
+    TArray<FScoreSnapshotEntry> Merged;
+    Merged.Reserve(Next.NumEntries);
+
+    int32 BaseIndex = 0;
+    int32 AddedIndex = 0;
+    int32 RemovedIndex = 0;
+    while (BaseIndex < OldBase.Num() || AddedIndex < Next.Added.Num())
+    {
+        const bool bTakeBase = AddedIndex == Next.Added.Num() || (BaseIndex < OldBase.Num() && !(Next.Added[AddedIndex] < OldBase[BaseIndex]));
+        if (!bTakeBase)
+        {
+            Merged.Add(Next.Added[AddedIndex++]);
+            continue;
+        }
+
+        const FScoreSnapshotEntry& Entry = OldBase[BaseIndex++];
+        if (RemovedIndex < Next.Removed.Num() && Next.Removed[RemovedIndex] == Entry)
+        {
+            RemovedIndex++;
+            continue;
+        }
+        Merged.Add(Entry);
+    }
+
+    Next.Base = MakeShared<const TArray<FScoreSnapshotEntry>, ESPMode::ThreadSafe>(MoveTemp(Merged));
+    Next.Added.Empty();
+    Next.Removed.Empty();
+
+    if (Next.AddedNames.Num() > 0)
+    {
+        TArray<FString> AllNames;
+        AllNames.Reserve(Next.BaseNames->Num() + Next.AddedNames.Num());
+        AllNames.Append(*Next.BaseNames);
+        AllNames.Append(MoveTemp(Next.AddedNames));
+        Next.BaseNames = MakeShared<const TArray<FString>, ESPMode::ThreadSafe>(MoveTemp(AllNames));
+        Next.AddedNames.Empty();
+    }
+}
+
+inline void FScoreSnapshotPublisher::AddEntry(FScoreSnapshot& Next, const FScoreSnapshotEntry& Entry)
+{
+    Next.Added.Insert(Entry, FSortedSearch::UpperBound(Next.Added, Entry));
+    Next.NumEntries++;
+}
+
+inline void FScoreSnapshotPublisher::RemoveEntry(FScoreSnapshot& Next, const FScoreSnapshotEntry& Entry)
+{
+    // Undo a pending add if there is one, otherwise cancel a base entry
+    const int32 AddedIndex = FSortedSearch::LowerBound(Next.Added, Entry);
+    if (Next.Added.IsValidIndex(AddedIndex) && Next.Added[AddedIndex] == Entry)
+    {
+        Next.Added.RemoveAt(AddedIndex);
+    }
+    else
+    {
+        Next.Removed.Insert(Entry, FSortedSearch::UpperBound(Next.Removed, Entry));
+    }
+    Next.NumEntries--;
+}
+
+inline void FScoreSnapshotPublisher::Add(int32 Score, uint32 PlayerId)
+{
+    TSharedRef<FScoreSnapshot, ESPMode::ThreadSafe> Next = BeginVersion();
+    AddEntry(*Next, { Score, PlayerId });
+    Publish(Next);
+}
+
+inline void FScoreSnapshotPublisher::Remove(int32 Score, uint32 PlayerId)
+{
+    TSharedRef<FScoreSnapshot, ESPMode::ThreadSafe> Next = BeginVersion();
+    RemoveEntry(*Next, { Score, PlayerId });
+    Publish(Next);
+}
+
+inline void FScoreSnapshotPublisher::Move(int32 OldScore, int32 NewScore, uint32 PlayerId)
+{
+    TSharedRef<FScoreSnapshot, ESPMode::ThreadSafe> Next = BeginVersion();
+    RemoveEntry(*Next, { OldScore, PlayerId });
+    AddEntry(*Next, { NewScore, PlayerId });
+    Publish(Next);
+}
+
+inline void FScoreSnapshotPublisher::Rebuild(TArray<FScoreSnapshotEntry>&& Entries)
+{
+    TSharedRef<FScoreSnapshot, ESPMode::ThreadSafe> Next = BeginVersion();
+
+    // Two stable passes give (score, player) order; player IDs are dense, so they fit in int32
+    FRadixSort::SortByKey(TArrayView<FScoreSnapshotEntry>(Entries),
+        [](const FScoreSnapshotEntry& Entry) { return static_cast<int32>(Entry.PlayerId); });
+    FRadixSort::SortByKey(TArrayView<FScoreSnapshotEntry>(Entries),
+        [](const FScoreSnapshotEntry& Entry) { return Entry.Score; });
+
+    Next->NumEntries = Entries.Num();
+    Next->Base = MakeShared<const TArray<FScoreSnapshotEntry>, ESPMode::ThreadSafe>(MoveTemp(Entries));
+    Next->Added.Empty();
+    Next->Removed.Empty();
+
+    Publish(Next);
+}
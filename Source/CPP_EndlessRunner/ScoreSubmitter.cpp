@@ -0,0 +1,240 @@
+// ScoreSubmitter.cpp - Outbox persistence, batching and retry for run submission
+#include "ScoreSubmitter.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpResponse.h"
+#include "HAL/FileManager.h"
+#include "JsonObjectConverter.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+FScoreSubmitter::FScoreSubmitter()
+	: AckedLines(0), InFlight(0), FlushTimer(0.0f), RetryDelay(0.0f), RetryTimer(0.0f)
+{
+}
+
+FScoreSubmitter::~FScoreSubmitter()
+{
+	Stop();
+}
+
+void FScoreSubmitter::Start(const FString& OutboxDirectory, const FString& InEndpoint)
+{
+	Stop();
+
+	Endpoint = InEndpoint;
+	IFileManager::Get().MakeDirectory(*OutboxDirectory, true);
+	OutboxPath = FPaths::Combine(OutboxDirectory, TEXT("Outbox.jsonl"));
+	AckPath = FPaths::Combine(OutboxDirectory, TEXT("Outbox.ack"));
+	LoadOutbox();
+
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(this, &FScoreSubmitter::Tick));
+}
+
+void FScoreSubmitter::Stop()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+
+	// The abandoned request can no longer call back (a late response could acknowledge
+	// a batch sent after a restart); its runs stay in the outbox
+	if (InFlightRequest.IsValid())
+	{
+		InFlightRequest->OnProcessRequestComplete().Unbind();
+		InFlightRequest->CancelRequest();
+		InFlightRequest.Reset();
+	}
+	InFlight = 0;
+}
+
+FString FScoreSubmitter::Submit(FScoreSubmission Submission)
+{
+	if (Submission.RunId.IsEmpty())
+	{
+		Submission.RunId = FGuid::NewGuid().ToString(EGuidFormats::DigitsWithHyphensLower);
+	}
+	if (PendingRunIds.Contains(Submission.RunId))
+	{
+		return Submission.RunId;
+	}
+
+	// Durable before it is queued: one appended line, no rewrite
+	FString Line;
+	FJsonObjectConverter::UStructToJsonObjectString(Submission, Line, 0, 0, 0, nullptr, false);
+	FFileHelper::SaveStringToFile(Line + TEXT("\n"), *OutboxPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM,
+		&IFileManager::Get(), FILEWRITE_Append);
+
+	PendingRunIds.Add(Submission.RunId);
+	Pending.Add(MoveTemp(Submission));
+	Stats.Submitted++;
+	return Pending.Last().RunId;
+}
+
+bool FScoreSubmitter::Tick(float DeltaTime)
+{
+	if (InFlight > 0 || Pending.Num() == 0)
+		return true;
+
+	if (RetryDelay > 0.0f)
+	{
+		RetryTimer -= DeltaTime;
+		if (RetryTimer > 0.0f)
+			return true;
+	}
+	else
+	{
+		// Wait for a full batch, but never longer than FlushInterval
+		FlushTimer += DeltaTime;
+		if (Pending.Num() < MaxBatchSize && FlushTimer < FlushInterval)
+			return true;
+	}
+
+	SendBatch();
+	return true;
+}
+
+void FScoreSubmitter::SendBatch()
+{
+	InFlight = FMath::Min(FMath::Max(MaxBatchSize, 1), Pending.Num());
+	FlushTimer = 0.0f;
+
+	FScoreSubmissionBatch Batch;
+	Batch.Runs.Append(Pending.GetData(), InFlight);
+
+	FString Body;
+	FJsonObjectConverter::UStructToJsonObjectString(Batch, Body, 0, 0, 0, nullptr, false);
+
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+	Request->SetURL(Endpoint);
+	Request->SetVerb(TEXT("POST"));
+	Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+	Request->SetContentAsString(Body);
+	Request->OnProcessRequestComplete().BindSP(this, &FScoreSubmitter::OnBatchComplete);
+	InFlightRequest = Request;
+	Request->ProcessRequest();
+
+	Stats.Batches++;
+}
+
+void FScoreSubmitter::OnBatchComplete(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bConnectedSuccessfully)
+{
+	if (InFlight == 0 || Request != InFlightRequest)
+		return;
+	InFlightRequest.Reset();
+
+	const int32 Code = (bConnectedSuccessfully && Response.IsValid()) ? Response->GetResponseCode() : 0;
+
+	if (EHttpResponseCodes::IsOk(Code))
+	{
+		FScoreSubmissionAck Ack;
+		FJsonObjectConverter::JsonObjectStringToUStruct(Response->GetContentAsString(), &Ack);
+
+		Stats.Acked += InFlight;
+		Stats.Duplicates += Ack.Duplicates;
+		RetryDelay = 0.0f;
+		AcknowledgeBatch();
+	}
+	else if (Code >= 400 && Code < 500 && Code != EHttpResponseCodes::RequestTimeout && Code != EHttpResponseCodes::TooManyRequests)
+	{
+		// Resending a batch the service calls malformed would block the queue forever
+		UE_LOG(LogTemp, Error, TEXT("Score service rejected %d runs (HTTP %d), dropping them"), InFlight, Code);
+		Stats.Dropped += InFlight;
+		RetryDelay = 0.0f;
+		AcknowledgeBatch();
+	}
+	else
+	{
+		Stats.Failures++;
+		InFlight = 0;
+		ScheduleRetry();
+	}
+}
+
+void FScoreSubmitter::AcknowledgeBatch()
+{
+	for (int32 i = 0; i < InFlight; i++)
+	{
+		PendingRunIds.Remove(Pending[i].RunId);
+	}
+	Pending.RemoveAt(0, InFlight, EAllowShrinking::No);
+	AckedLines += InFlight;
+	InFlight = 0;
+
+	if (Pending.Num() == 0)
+	{
+		// Everything delivered: start a fresh outbox
+		// (ack first - a crash in between only resends runs, it never skips any)
+		IFileManager::Get().Delete(*AckPath, false, false, true);
+		IFileManager::Get().Delete(*OutboxPath, false, false, true);
+		AckedLines = 0;
+	}
+	else
+	{
+		SaveAckedLines();
+	}
+}
+
+void FScoreSubmitter::ScheduleRetry()
+{
+	RetryDelay = RetryDelay > 0.0f ? FMath::Min(RetryDelay * 2.0f, RetryMaxDelay) : RetryBaseDelay;
+
+	// Jitter so many clients coming back from an outage do not retry in lockstep
+	RetryTimer = RetryDelay * FMath::FRandRange(0.5f, 1.0f);
+
+	UE_LOG(LogTemp, Warning, TEXT("Score submission failed, %d runs pending, retrying in %.1f s"), Pending.Num(), RetryTimer);
+}
+
+void FScoreSubmitter::LoadOutbox()
+{
+	Pending.Reset();
+	PendingRunIds.Reset();
+	AckedLines = 0;
+	InFlight = 0;
+	RetryDelay = 0.0f;
+	FlushTimer = 0.0f;
+
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *OutboxPath))
+		return;
+
+	FString AckText;
+	const int32 Acked = FFileHelper::LoadFileToString(AckText, *AckPath) ? FCString::Atoi(*AckText) : 0;
+
+	// A torn last line (crash mid-append) fails to parse and is dropped
+	for (int32 i = FMath::Max(Acked, 0); i < Lines.Num(); i++)
+	{
+		FScoreSubmission Submission;
+		if (FJsonObjectConverter::JsonObjectStringToUStruct(Lines[i], &Submission) && !Submission.RunId.IsEmpty()
+			&& !PendingRunIds.Contains(Submission.RunId))
+		{
+			PendingRunIds.Add(Submission.RunId);
+			Pending.Add(MoveTemp(Submission));
+		}
+	}
+
+	// Rewrite with only the unsent runs, so line numbers match Pending again
+	FString Text;
+	for (const FScoreSubmission& Submission : Pending)
+	{
+		FString Line;
+		FJsonObjectConverter::UStructToJsonObjectString(Submission, Line, 0, 0, 0, nullptr, false);
+		Text += Line + TEXT("\n");
+	}
+
+	const FString TempPath = OutboxPath + TEXT(".tmp");
+	FFileHelper::SaveStringToFile(Text, *TempPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+	IFileManager::Get().Delete(*AckPath, false, false, true);
+	IFileManager::Get().Move(*OutboxPath, *TempPath, true);
+
+	if (Pending.Num() > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Score outbox: %d runs from a previous session will be resent"), Pending.Num());
+	}
+}
+
+void FScoreSubmitter::SaveAckedLines() const
+{
+	FFileHelper::SaveStringToFile(FString::FromInt(AckedLines), *AckPath);
+}
@@ -0,0 +1,131 @@
+// ScoreSubmitter.h - Asynchronous, batched, crash-safe submission of finished runs
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Interfaces/IHttpRequest.h"
+#include "ScoreSubmitter.generated.h"
+
+/**
+ * One finished run as sent to the leaderboard service
+ * RunId is unique per run, so the service can drop resubmissions
+ */
+USTRUCT()
+struct FScoreSubmission
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString RunId;
+
+	UPROPERTY()
+	FString PlayerName;
+
+	UPROPERTY()
+	int32 Score = 0;
+
+	UPROPERTY()
+	float Distance = 0.0f;
+
+	UPROPERTY()
+	float Duration = 0.0f;
+};
+
+/**
+ * Request body: POST <Endpoint> {"runs": [...]}
+ */
+USTRUCT()
+struct FScoreSubmissionBatch
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FScoreSubmission> Runs;
+};
+
+/**
+ * Response body
+ */
+USTRUCT()
+struct FScoreSubmissionAck
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 Accepted = 0;
+
+	UPROPERTY()
+	int32 Duplicates = 0;
+};
+
+struct FScoreSubmitterStats
+{
+	int32 Submitted = 0;    // Runs handed to Submit()
+	int32 Acked = 0;        // Runs confirmed by the service
+	int32 Duplicates = 0;   // Of those, already known to the service
+	int32 Batches = 0;
+	int32 Failures = 0;     // Failed batch attempts (each retried)
+	int32 Dropped = 0;      // Runs the service rejected as malformed
+};
+
+/**
+ * Outbox of finished runs, drained to an HTTP endpoint in batches
+ *
+ * Submit() only appends one line to Outbox.jsonl and returns. A core ticker
+ * sends up to MaxBatchSize runs per request, one request in flight, and
+ * advances the acknowledged count in Outbox.ack when the service answers.
+ * Failed batches are retried with exponential backoff plus jitter. Runs
+ * left in the outbox when the game exits are sent on the next start;
+ * a run acknowledged just before a crash may be sent twice, which the
+ * service absorbs by RunId.
+ */
+class FScoreSubmitter : public TSharedFromThis<FScoreSubmitter>
+{
+private:
+	FString Endpoint;
+	FString OutboxPath;
+	FString AckPath;
+
+	TArray<FScoreSubmission> Pending;   // FIFO, same order as the unacknowledged outbox lines
+	TSet<FString> PendingRunIds;
+	int32 AckedLines;                   // Outbox lines already acknowledged
+
+	int32 InFlight;                     // Runs in the outstanding request (0 = idle)
+	FHttpRequestPtr InFlightRequest;
+	float FlushTimer;
+	float RetryDelay;                   // Current backoff, 0 when healthy
+	float RetryTimer;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+	FScoreSubmitterStats Stats;
+
+public:
+	int32 MaxBatchSize = 100;
+	float FlushInterval = 0.5f;         // Seconds to wait for a batch to fill
+	float RetryBaseDelay = 1.0f;
+	float RetryMaxDelay = 60.0f;
+
+	FScoreSubmitter();
+	~FScoreSubmitter();
+
+	// Loads unsent runs from OutboxDirectory and starts ticking
+	void Start(const FString& OutboxDirectory, const FString& InEndpoint);
+	void Stop();
+
+	// Queues a run; returns its RunId (generated when the submission has none)
+	FString Submit(FScoreSubmission Submission);
+
+	int32 GetPendingCount() const { return Pending.Num(); }
+	bool IsIdle() const { return Pending.Num() == 0 && InFlight == 0; }
+	const FScoreSubmitterStats& GetStats() const { return Stats; }
+
+private:
+	bool Tick(float DeltaTime);
+	void SendBatch();
+	void OnBatchComplete(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bConnectedSuccessfully);
+	void AcknowledgeBatch();
+	void ScheduleRetry();
+
+	void LoadOutbox();
+	void SaveAckedLines() const;
+};
@@ -0,0 +1,180 @@
+// SortedSearch.h - Branchless lower/upper bound and an Eytzinger-ordered score index
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/IdentityFunctor.h"
+
+/**
+ * lower_bound / upper_bound over a sorted range without data-dependent branches
+ * The range halves every step whatever the comparison says, and the
+ * comparison only selects the next base (a conditional move), so there is
+ * nothing to mispredict. Both possible next midpoints are prefetched, which
+ * overlaps the cache misses of large arrays
+ * Time Complexity: O(log n), exactly ceil(log2 n) + 1 comparisons for n >= 1
+ * (one per halving of the range, plus one on the last remaining element)
+ */
+struct FSortedSearch
+{
+    // First index whose key is >= Value (Num if none)
+    template<typename ElementType, typename ValueType, typename ProjectionType = FIdentityFunctor>
+    static int32 LowerBound(const ElementType* First, int32 Num, const ValueType& Value, ProjectionType Projection = ProjectionType())
+    {
+        return Search(First, Num, [&](const ElementType& Element) { return Projection(Element) < Value; });
+    }
+
+    // First index whose key is > Value (Num if none)
+    template<typename ElementType, typename ValueType, typename ProjectionType = FIdentityFunctor>
+    static int32 UpperBound(const ElementType* First, int32 Num, const ValueType& Value, ProjectionType Projection = ProjectionType())
+    {
+        return Search(First, Num, [&](const ElementType& Element) { return !(Value < Projection(Element)); });
+    }
+
+    template<typename ElementType, typename ValueType>
+    static int32 LowerBound(const TArray<ElementType>& Array, const ValueType& Value)
+    {
+        return LowerBound(Array.GetData(), Array.Num(), Value);
+    }
+
+    template<typename ElementType, typename ValueType>
+    static int32 UpperBound(const TArray<ElementType>& Array, const ValueType& Value)
+    {
+        return UpperBound(Array.GetData(), Array.Num(), Value);
+    }
+
+private:
+    // Number of leading elements for which IsBefore holds (IsBefore must be monotonic)
+    template<typename ElementType, typename PredicateType>
+    static int32 Search(const ElementType* First, int32 Num, PredicateType IsBefore)
+    {
+        if (Num <= 0)
+            return 0;
+
+        const ElementType* Base = First;
+        while (Num > 1)
+        {
+            const int32 Half = Num / 2;
+            FPlatformMisc::Prefetch(Base + Half / 2);
+            FPlatformMisc::Prefetch(Base + Half + Half / 2);
+            Base = IsBefore(Base[Half]) ? Base + Half : Base;
+            Num -= Half;
+        }
+        return static_cast<int32>(Base - First) + (IsBefore(*Base) ? 1 : 0);
+    }
+};
+
+/**
+ * Sorted scores stored in Eytzinger (breadth-first) order: slot k's children
+ * are 2k and 2k+1, so the first levels of every search share a few cache
+ * lines, and the 16 descendants four levels down sit in one 64-byte line
+ * that is prefetched while the current level is compared
+ * Beats a plain binary search once the array no longer fits in cache;
+ * built once, for large read-mostly leaderboards
+ * Time Complexity: O(n) build, O(log n) lookup, 8 bytes per score
+ */
+class FEytzingerIndex
+{
+private:
+    // 1-based; slot 0 is padding so slot 16k starts a cache line
+    TArray<int32, TAlignedHeapAllocator<64>> Layout;
+
+    // Position of each slot's score in the sorted input
+    TArray<int32> SortedIndex;
+
+    int32 NumScores;
+
+public:
+    FEytzingerIndex() : NumScores(0) {}
+
+    // SortedScores must be ascending
+    void Build(const int32* SortedScores, int32 Num);
+    void Build(const TArray<int32>& SortedScores) { Build(SortedScores.GetData(), SortedScores.Num()); }
+    void Reset();
+
+    // Same results as FSortedSearch on the sorted input
+    int32 LowerBound(int32 Score) const { return Search<false>(Score); }
+    int32 UpperBound(int32 Score) const { return Search<true>(Score); }
+
+    // 1 + number of higher scores
+    int32 GetRank(int32 Score) const { return 1 + NumScores - UpperBound(Score); }
+
+    // Utility
+    int32 Num() const { return NumScores; }
+    bool IsEmpty() const { return NumScores == 0; }
+    SIZE_T GetAllocatedSize() const { return Layout.GetAllocatedSize() + SortedIndex.GetAllocatedSize(); }
+
+private:
+    template<bool bUpper>
+    int32 Search(int32 Score) const;
+};
+
+// ===== IMPLEMENTATION =====
+
+inline void FEytzingerIndex::Reset()
+{
+    Layout.Reset();
+    SortedIndex.Reset();
+    NumScores = 0;
+}
+
+inline void FEytzingerIndex::Build(const int32* SortedScores, int32 Num)
+{
+    NumScores = FMath::Max(Num, 0);
+
+    Layout.SetNumZeroed(NumScores + 1);
+    SortedIndex.SetNumZeroed(NumScores + 1);
+
+    // In-order walk of the implicit tree visits slots in sorted order
+    uint32 Slot = 1;
+    while (2 * Slot <= static_cast<uint32>(NumScores))
+    {
+        Slot *= 2;
+    }
+
+    for (int32 i = 0; i < NumScores; i++)
+    {
+        Layout[Slot] = SortedScores[i];
+        SortedIndex[Slot] = i;
+
+        if (2 * Slot + 1 <= static_cast<uint32>(NumScores))
+        {
+            // Successor: leftmost slot of the right subtree
+            Slot = 2 * Slot + 1;
+            while (2 * Slot <= static_cast<uint32>(NumScores))
+            {
+                Slot *= 2;
+            }
+        }
+        else
+        {
+            // Successor: first ancestor we are in the left subtree of
+            while (Slot & 1)
+            {
+                Slot >>= 1;
+            }
+            Slot >>= 1;
+        }
+    }
+}
+
+template<bool bUpper>
+int32 FEytzingerIndex::Search(int32 Score) const
+{
+    const int32* Slots = Layout.GetData();
+    const uint32 Num = static_cast<uint32>(NumScores);
+
+    uint32 Slot = 1;
+    while (Slot <= Num)
+    {
+        // Slot 16 * k is the first of k's great-great-grandchildren
+        if (16 * static_cast<uint64>(Slot) <= Num)
+        {
+            FPlatformMisc::Prefetch(Slots + 16 * Slot);
+        }
+        const bool bGoRight = bUpper ? Slots[Slot] <= Score : Slots[Slot] < Score;
+        Slot = 2 * Slot + (bGoRight ? 1 : 0);
+    }
+
+    // Undo the trailing right turns, then the last left turn: that slot is the answer
+    Slot >>= FMath::CountTrailingZeros(~Slot) + 1;
+    return Slot == 0 ? NumScores : SortedIndex[Slot];
+}
@@ -0,0 +1,125 @@
+// SpawnTables.h - Data-driven weighted spawn tables for floor tile items
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AliasTable.h"
+#include "SpawnTables.generated.h"
+
+/**
+ * What a single lane slot on a tile can turn into
+ */
+UENUM(BlueprintType)
+enum class ESpawnItemKind : uint8
+{
+	None,
+	Coin,
+	SmallObstacle,
+	BigObstacle
+};
+
+/**
+ * One weighted outcome in a lane's spawn table
+ */
+USTRUCT(BlueprintType)
+struct FSpawnOutcome
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn")
+	ESpawnItemKind Kind = ESpawnItemKind::None;
+
+	// Relative weight - weights in a table do not need to sum to 1
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn", meta = (ClampMin = "0.0"))
+	float Weight = 1.0f;
+
+	FSpawnOutcome() {}
+	FSpawnOutcome(ESpawnItemKind InKind, float InWeight) : Kind(InKind), Weight(InWeight) {}
+};
+
+/**
+ * Weighted outcomes for one lane
+ */
+USTRUCT(BlueprintType)
+struct FSpawnLaneTable
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn")
+	TArray<FSpawnOutcome> Outcomes;
+
+	// The floor tile's SpawnPercent thresholds, same odds as the original if-chain:
+	// [0, P1) nothing, [P1, P2) small obstacle, [P2, P3) nothing, [P3, 1] coin
+	static FSpawnLaneTable FromThresholds(float P1, float P2, float P3)
+	{
+		P2 = FMath::Max(P2, P1);
+		P3 = FMath::Max(P3, P2);
+
+		FSpawnLaneTable Table;
+		Table.Outcomes.Add({ ESpawnItemKind::None, P1 + (P3 - P2) });
+		Table.Outcomes.Add({ ESpawnItemKind::SmallObstacle, P2 - P1 });
+		Table.Outcomes.Add({ ESpawnItemKind::Coin, 1.0f - P3 });
+		return Table;
+	}
+};
+
+/**
+ * Spawn tables used from MinDistance onwards along the track
+ * Lanes[i] is used for lane i; lanes past the end reuse the last entry
+ */
+USTRUCT(BlueprintType)
+struct FSpawnBand
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn", meta = (ClampMin = "0.0"))
+	float MinDistance = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn")
+	TArray<FSpawnLaneTable> Lanes;
+};
+
+/**
+ * Runtime form of FSpawnLaneTable: alias table + outcome kinds
+ * Time Complexity: O(1) sample
+ */
+struct FCompiledSpawnTable
+{
+	FAliasTable Alias;
+	TArray<ESpawnItemKind> Kinds;
+
+	void Build(const FSpawnLaneTable& Table)
+	{
+		TArray<float> Weights;
+		Weights.Reserve(Table.Outcomes.Num());
+		Kinds.Reset(Table.Outcomes.Num());
+
+		for (const FSpawnOutcome& Outcome : Table.Outcomes)
+		{
+			Kinds.Add(Outcome.Kind);
+			Weights.Add(Outcome.Weight);
+		}
+		Alias.Build(Weights);
+	}
+
+	ESpawnItemKind Sample(float Uniform) const
+	{
+		const int32 Index = Alias.Sample(Uniform);
+		return Kinds.IsValidIndex(Index) ? Kinds[Index] : ESpawnItemKind::None;
+	}
+};
+
+/**
+ * Runtime form of FSpawnBand
+ */
+struct FCompiledSpawnBand
+{
+	float MinDistance = 0.0f;
+	TArray<FCompiledSpawnTable> Lanes;
+
+	const FCompiledSpawnTable* GetLaneTable(int32 LaneID) const
+	{
+		if (Lanes.Num() == 0)
+			return nullptr;
+		return &Lanes[FMath::Clamp(LaneID, 0, Lanes.Num() - 1)];
+	}
+};
@@ -0,0 +1,360 @@
+// TimeWindowedLeaderboard.h - Daily, weekly and all-time boards from expiring day buckets
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Algo/BinarySearch.h"
+#include "ScoreBST.h"
+#include "ScoreSnapshot.h"
+
+enum class ELeaderboardWindow : uint8
+{
+    Daily,      // The current UTC day
+    Weekly,     // The current UTC week, Monday to Sunday
+    AllTime
+};
+
+/**
+ * Scores of expired days, folded down to what the all-time board still needs:
+ * a count per distinct score (for ranks) and the highest entries (for lists)
+ * Size depends on the spread of scores and the list capacity, not on history
+ */
+struct FExpiredScores
+{
+    TArray<int32> Scores;           // Distinct, ascending
+    TArray<int32> CountAtOrAbove;   // Entries scoring at least Scores[i]
+    TArray<FScoreSnapshotEntry> Top;   // Highest first, at most TopCapacity
+    int32 NumEntries = 0;
+};
+
+/**
+ * One run per entry, as FScoreBST::Insert, on three boards at once
+ * Each UTC day gets its own FScoreBST bucket. The daily board is today's
+ * bucket and the weekly board the (at most seven) buckets of this week;
+ * when a week ends its buckets are folded into FExpiredScores and freed
+ * whole, so nothing is ever rescanned or rebuilt and the live trees only
+ * hold one week of runs. The all-time board is the expired scores plus
+ * the live buckets
+ * Ranks add up each source's count of higher scores; top lists merge the
+ * sources' own top lists. All-time lists are exact to ExpiredTopCapacity
+ * rows, which is as deep as they go once anything has expired
+ * Time is Unix seconds supplied by the caller; runs older than the current
+ * week go straight to the expired scores
+ * Time Complexity: O(log n) insert for n runs this week, O(B log n) rank
+ * and O(B (log n + K)) top K over B <= 8 sources, O(n + S) per week folded
+ */
+class FTimeWindowedLeaderboard
+{
+private:
+    struct FDayBucket
+    {
+        int64 Day;
+        TUniquePtr<FScoreBST> Scores;
+    };
+
+    TSharedRef<FPlayerNameTable> Names;
+
+    TArray<FDayBucket> Buckets;   // This week's days, oldest first
+    FExpiredScores Expired;
+    int32 ExpiredTopCapacity;
+
+    int64 CurrentDay;
+
+    static constexpr int64 SecondsPerDay = 86400;
+
+public:
+    // Shares names with other boards of the same players when given a table
+    explicit FTimeWindowedLeaderboard(TSharedPtr<FPlayerNameTable> InNames = nullptr, int32 InExpiredTopCapacity = 100);
+
+    void Insert(int32 Score, uint32 PlayerId, int64 UnixTime);
+
+    // Moves "today" forward, expiring last week's buckets on a new week;
+    // call before querying if no run has been inserted since midnight
+    void Advance(int64 UnixTime);
+
+    // Order statistics, same meaning as FScoreBST's
+    int32 GetRank(ELeaderboardWindow Window, int32 Score) const { return CountGreater(Window, Score) + 1; }
+    int32 CountGreater(ELeaderboardWindow Window, int32 Score) const;
+
+    // Highest first
+    TArray<FScoreSnapshotEntry> GetTopScores(ELeaderboardWindow Window, int32 Count) const;
+
+    // Names
+    FPlayerNameTable& GetNameTable() { return *Names; }
+    const FPlayerNameTable& GetNameTable() const { return *Names; }
+    const FString& GetPlayerName(uint32 PlayerId) const { return Names->GetName(PlayerId); }
+
+    // Utility
+    int32 Num(ELeaderboardWindow Window) const;
+    int32 NumLiveBuckets() const { return Buckets.Num(); }
+    int32 NumExpiredScores() const { return Expired.Scores.Num(); }
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    static int64 DayOf(int64 UnixTime);
+    static int64 WeekOf(int64 Day);   // Day 0 (1970-01-01) was a Thursday
+
+    // Live buckets the window covers, as an index range into Buckets
+    void GetBucketRange(ELeaderboardWindow Window, int32& OutFirst, int32& OutEnd) const;
+
+    void ExpireBucket(const FScoreBST& Bucket);
+    void ExpireEntries(TArrayView<const int32> AscendingScores, TArrayView<const FScoreSnapshotEntry> TopEntries);
+};
+
+// ===== IMPLEMENTATION =====
+
+inline FTimeWindowedLeaderboard::FTimeWindowedLeaderboard(TSharedPtr<FPlayerNameTable> InNames, int32 InExpiredTopCapacity)
+    : Names(InNames.IsValid() ? InNames.ToSharedRef() : MakeShared<FPlayerNameTable>())
+    , ExpiredTopCapacity(FMath::Max(InExpiredTopCapacity, 1))
+    , CurrentDay(MIN_int64)
+{}
+
+inline int64 FTimeWindowedLeaderboard::DayOf(int64 UnixTime)
+{
+    // Round down for times before the epoch too
+    return UnixTime >= 0 ? UnixTime / SecondsPerDay : -((-UnixTime + SecondsPerDay - 1) / SecondsPerDay);
+}
+
+inline int64 FTimeWindowedLeaderboard::WeekOf(int64 Day)
+{
+    const int64 FromMonday = Day + 3;
+    return FromMonday >= 0 ? FromMonday / 7 : -((-FromMonday + 6) / 7);
+}
+
+inline void FTimeWindowedLeaderboard::Advance(int64 UnixTime)
+{
+    const int64 Day = DayOf(UnixTime);
+    if (Day <= CurrentDay)
+        return;
+
+    CurrentDay = Day;
+
+    // Buckets are oldest first, so last week's are a prefix
+    const int64 Week = WeekOf(Day);
+    int32 NumExpired = 0;
+    while (NumExpired < Buckets.Num() && WeekOf(Buckets[NumExpired].Day) < Week)
+    {
+        ExpireBucket(*Buckets[NumExpired].Scores);
+        NumExpired++;
+    }
+    Buckets.RemoveAt(0, NumExpired);
+}
+
+inline void FTimeWindowedLeaderboard::Insert(int32 Score, uint32 PlayerId, int64 UnixTime)
+{
+    Advance(UnixTime);
+
+    const int64 Day = DayOf(UnixTime);
+    if (WeekOf(Day) < WeekOf(CurrentDay))
+    {
+        // Late arrival from a week that has already expired
+        const FScoreSnapshotEntry Entry = { Score, PlayerId };
+        ExpireEntries(MakeArrayView(&Score, 1), MakeArrayView(&Entry, 1));
+        return;
+    }
+
+    // At most seven buckets; find the day or where it goes
+    int32 Index = Buckets.Num();
+    while (Index > 0 && Buckets[Index - 1].Day >= Day)
+    {
+        Index--;
+    }
+    if (Index == Buckets.Num() || Buckets[Index].Day != Day)
+    {
+        FDayBucket Bucket;
+        Bucket.Day = Day;
+        Bucket.Scores = MakeUnique<FScoreBST>(Names);
+        Buckets.Insert(MoveTemp(Bucket), Index);
+    }
+
+    Buckets[Index].Scores->Insert(Score, PlayerId);
+}
+
+inline void FTimeWindowedLeaderboard::GetBucketRange(ELeaderboardWindow Window, int32& OutFirst, int32& OutEnd) const
+{
+    OutEnd = Buckets.Num();
+    OutFirst = 0;
+
+    if (Window == ELeaderboardWindow::Daily)
+    {
+        // No bucket is later than today, so today's is the last if it exists
+        OutFirst = OutEnd > 0 && Buckets[OutEnd - 1].Day == CurrentDay ? OutEnd - 1 : OutEnd;
+    }
+    // Weekly and all-time: every live bucket is this week's
+}
+
+inline int32 FTimeWindowedLeaderboard::CountGreater(ELeaderboardWindow Window, int32 Score) const
+{
+    int32 First, End;
+    GetBucketRange(Window, First, End);
+
+    int32 Count = 0;
+    for (int32 i = First; i < End; i++)
+    {
+        Count += Buckets[i].Scores->CountGreater(Score);
+    }
+
+    if (Window == ELeaderboardWindow::AllTime)
+    {
+        // First distinct score above this one
+        const int32 Above = Algo::UpperBound(Expired.Scores, Score);
+        Count += Above < Expired.Scores.Num() ? Expired.CountAtOrAbove[Above] : 0;
+    }
+    return Count;
+}
+
+inline int32 FTimeWindowedLeaderboard::Num(ELeaderboardWindow Window) const
+{
+    int32 First, End;
+    GetBucketRange(Window, First, End);
+
+    int32 Count = Window == ELeaderboardWindow::AllTime ? Expired.NumEntries : 0;
+    for (int32 i = First; i < End; i++)
+    {
+        Count += Buckets[i].Scores->GetNodeCount();
+    }
+    return Count;
+}
+
+inline TArray<FScoreSnapshotEntry> FTimeWindowedLeaderboard::GetTopScores(ELeaderboardWindow Window, int32 Count) const
+{
+    int32 First, End;
+    GetBucketRange(Window, First, End);
+
+    TArray<FScoreSnapshotEntry> Result;
+    if (Window == ELeaderboardWindow::AllTime && Expired.NumEntries > 0)
+    {
+        // Entries past the kept top list may outrank live ones
+        Count = FMath::Min(Count, ExpiredTopCapacity);
+    }
+    if (Count <= 0)
+        return Result;
+
+    // Each source's own top list, highest first; then take the highest head each step
+    TArray<TArray<FScoreNode*>, TInlineAllocator<8>> Lists;
+    for (int32 i = First; i < End; i++)
+    {
+        Lists.Add(Buckets[i].Scores->GetTopScores(Count));
+    }
+    const TArray<FScoreSnapshotEntry>* ExpiredTop = Window == ELeaderboardWindow::AllTime ? &Expired.Top : nullptr;
+
+    TArray<int32, TInlineAllocator<8>> Heads;
+    Heads.SetNumZeroed(Lists.Num());
+    int32 ExpiredHead = 0;
+
+    Result.Reserve(Count);
+    while (Result.Num() < Count)
+    {
+        int32 Best = INDEX_NONE;
+        int32 BestScore = MIN_int32;
+        for (int32 i = 0; i < Lists.Num(); i++)
+        {
+            if (Heads[i] < Lists[i].Num() && (Best == INDEX_NONE || Lists[i][Heads[i]]->Score > BestScore))
+            {
+                Best = i;
+                BestScore = Lists[i][Heads[i]]->Score;
+            }
+        }
+
+        if (ExpiredTop && ExpiredHead < ExpiredTop->Num() && (Best == INDEX_NONE || (*ExpiredTop)[ExpiredHead].Score > BestScore))
+        {
+            Result.Add((*ExpiredTop)[ExpiredHead++]);
+        }
+        else if (Best != INDEX_NONE)
+        {
+            const FScoreNode* Node = Lists[Best][Heads[Best]++];
+            Result.Add({ Node->Score, Node->PlayerId });
+        }
+        else
+        {
+            break;
+        }
+    }
+    return Result;
+}
+
+inline void FTimeWindowedLeaderboard::ExpireBucket(const FScoreBST& Bucket)
+{
+    TArray<int32> Scores;
+    Scores.Reserve(Bucket.GetNodeCount());
+    for (const FScoreNode* Node : Bucket.InOrderTraversal())
+    {
+        Scores.Add(Node->Score);
+    }
+
+    TArray<FScoreSnapshotEntry> Top;
+    for (const FScoreNode* Node : Bucket.GetTopScores(ExpiredTopCapacity))
+    {
+        Top.Add({ Node->Score, Node->PlayerId });
+    }
+
+    ExpireEntries(Scores, Top);
+}
+
+inline void FTimeWindowedLeaderboard::ExpireEntries(TArrayView<const int32> AscendingScores, TArrayView<const FScoreSnapshotEntry> TopEntries)
+{
+    // Merge the distinct-score counts (counts are recovered from the running sums)
+    const int32 OldNum = Expired.Scores.Num();
+    TArray<int32> MergedScores;
+    TArray<int32> MergedCounts;
+    MergedScores.Reserve(OldNum + AscendingScores.Num());
+    MergedCounts.Reserve(OldNum + AscendingScores.Num());
+
+    int32 Old = 0;
+    int32 New = 0;
+    while (Old < OldNum || New < AscendingScores.Num())
+    {
+        const bool bTakeOld = New == AscendingScores.Num() || (Old < OldNum && Expired.Scores[Old] <= AscendingScores[New]);
+        const int32 Score = bTakeOld ? Expired.Scores[Old] : AscendingScores[New];
+        int32 ScoreCount = 0;
+        if (bTakeOld)
+        {
+            ScoreCount = Expired.CountAtOrAbove[Old] - (Old + 1 < OldNum ? Expired.CountAtOrAbove[Old + 1] : 0);
+            Old++;
+        }
+        while (New < AscendingScores.Num() && AscendingScores[New] == Score)
+        {
+            ScoreCount++;
+            New++;
+        }
+
+        MergedScores.Add(Score);
+        MergedCounts.Add(ScoreCount);
+    }
+
+    for (int32 i = MergedCounts.Num() - 2; i >= 0; i--)
+    {
+        MergedCounts[i] += MergedCounts[i + 1];
+    }
+    Expired.Scores = MoveTemp(MergedScores);
+    Expired.CountAtOrAbove = MoveTemp(MergedCounts);
+    Expired.NumEntries += AscendingScores.Num();
+
+    // Keep the highest entries of both lists
+    TArray<FScoreSnapshotEntry> MergedTop;
+    MergedTop.Reserve(FMath::Min(Expired.Top.Num() + TopEntries.Num(), ExpiredTopCapacity));
+    int32 A = 0;
+    int32 B = 0;
+    while (MergedTop.Num() < ExpiredTopCapacity && (A < Expired.Top.Num() || B < TopEntries.Num()))
+    {
+        if (B == TopEntries.Num() || (A < Expired.Top.Num() && Expired.Top[A].Score >= TopEntries[B].Score))
+        {
+            MergedTop.Add(Expired.Top[A++]);
+        }
+        else
+        {
+            MergedTop.Add(TopEntries[B++]);
+        }
+    }
+    Expired.Top = MoveTemp(MergedTop);
+}
+
+inline SIZE_T FTimeWindowedLeaderboard::GetAllocatedSize() const
+{
+    SIZE_T Bytes = Buckets.GetAllocatedSize() + Expired.Scores.GetAllocatedSize()
+        + Expired.CountAtOrAbove.GetAllocatedSize() + Expired.Top.GetAllocatedSize();
+    for (const FDayBucket& Bucket : Buckets)
+    {
+        Bytes += sizeof(FScoreBST) + Bucket.Scores->GetAllocatedSize();
+    }
+    return Bytes;
+}
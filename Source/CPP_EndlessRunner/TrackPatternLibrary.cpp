@@ -0,0 +1,299 @@
+// TrackPatternLibrary.cpp - Memory-mapped pattern library and its binary writer
+#include "TrackPatternLibrary.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+
+FTrackPatternLibrary::FTrackPatternLibrary()
+	: Data(nullptr), DataSize(0)
+{
+}
+
+FTrackPatternLibrary::~FTrackPatternLibrary()
+{
+	Unload();
+}
+
+bool FTrackPatternLibrary::Load(const FString& Filename)
+{
+	Unload();
+
+	// Preferred path: map the file and read it in place
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	FOpenMappedResult MapResult = PlatformFile.OpenMappedEx(*Filename);
+	if (!MapResult.HasError())
+	{
+		MappedFile = MapResult.StealValue();
+		MappedRegion.Reset(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+	}
+
+	if (MappedRegion)
+	{
+		Data = MappedRegion->GetMappedPtr();
+		DataSize = MappedRegion->GetMappedSize();
+	}
+	else if (FFileHelper::LoadFileToArray(FallbackData, *Filename, FILEREAD_Silent))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Pattern library %s could not be mapped, loaded into memory instead"), *Filename);
+		Data = FallbackData.GetData();
+		DataSize = FallbackData.Num();
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Pattern library not found: %s"), *Filename);
+		Unload();
+		return false;
+	}
+
+	if (!ValidateHeader() || !ValidateTables())
+	{
+		UE_LOG(LogTemp, Error, TEXT("Pattern library %s is invalid or from another version"), *Filename);
+		Unload();
+		return false;
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("Pattern library loaded: %u patterns, %lld bytes"), GetHeader().NumPatterns, DataSize);
+	return true;
+}
+
+void FTrackPatternLibrary::Unload()
+{
+	Data = nullptr;
+	DataSize = 0;
+
+	// Region must go before the handle it was mapped from
+	MappedRegion.Reset();
+	MappedFile.Reset();
+	FallbackData.Empty();
+}
+
+bool FTrackPatternLibrary::ValidateHeader() const
+{
+	if (DataSize < static_cast<int64>(sizeof(FTrackPatternFileHeader)))
+		return false;
+
+	const FTrackPatternFileHeader& Header = GetHeader();
+	if (Header.Magic != TRACK_PATTERN_MAGIC || Header.Version != TRACK_PATTERN_VERSION || Header.TotalSize != DataSize)
+		return false;
+
+	// Tables are read in place, so they start after the header on a 4-byte boundary
+	if (Header.BucketTableOffset < sizeof(FTrackPatternFileHeader) || Header.BucketTableOffset % 4 != 0 || Header.PatternTableOffset % 4 != 0)
+		return false;
+
+	// Every table must fit inside the file
+	const int64 NumBuckets = static_cast<int64>(Header.NumDifficulties) * (Header.MaxLanes + 1);
+	const bool bBucketsFit = Header.BucketTableOffset + NumBuckets * sizeof(FTrackPatternBucket) <= Header.PatternTableOffset;
+	const bool bPatternsFit = Header.PatternTableOffset + static_cast<int64>(Header.NumPatterns) * sizeof(FTrackPatternRecord) <= Header.CellDataOffset;
+	return bBucketsFit && bPatternsFit && Header.CellDataOffset <= Header.TotalSize;
+}
+
+bool FTrackPatternLibrary::ValidateTables() const
+{
+	const FTrackPatternFileHeader& Header = GetHeader();
+	const FTrackPatternBucket* Buckets = reinterpret_cast<const FTrackPatternBucket*>(Data + Header.BucketTableOffset);
+	const FTrackPatternRecord* Patterns = reinterpret_cast<const FTrackPatternRecord*>(Data + Header.PatternTableOffset);
+
+	// Each bucket's range must lie inside the record table, holding only patterns of its lane count
+	for (int32 Difficulty = 0; Difficulty < Header.NumDifficulties; Difficulty++)
+	{
+		for (int32 NumLanes = 0; NumLanes <= Header.MaxLanes; NumLanes++)
+		{
+			const FTrackPatternBucket& Bucket = Buckets[Difficulty * (Header.MaxLanes + 1) + NumLanes];
+			if (static_cast<int64>(Bucket.FirstPattern) + Bucket.NumPatterns > Header.NumPatterns)
+				return false;
+
+			for (uint32 i = 0; i < Bucket.NumPatterns; i++)
+			{
+				if (Patterns[Bucket.FirstPattern + i].NumLanes != NumLanes)
+					return false;
+			}
+		}
+	}
+
+	// Every pattern's rows must lie inside the cell data, and its tier must have buckets
+	for (uint32 i = 0; i < Header.NumPatterns; i++)
+	{
+		const FTrackPatternRecord& Pattern = Patterns[i];
+		const int64 CellsEnd = static_cast<int64>(Header.CellDataOffset) + Pattern.CellOffset + static_cast<int64>(Pattern.NumTiles) * Pattern.NumLanes;
+		if (Pattern.NumLanes == 0 || Pattern.NumTiles == 0 || CellsEnd > Header.TotalSize)
+			return false;
+		if (Pattern.Difficulty >= Header.NumDifficulties || Pattern.NumLanes > Header.MaxLanes)
+			return false;
+	}
+	return true;
+}
+
+const FTrackPatternBucket* FTrackPatternLibrary::FindBucket(int32 Difficulty, int32 NumLanes) const
+{
+	if (!IsLoaded())
+		return nullptr;
+
+	const FTrackPatternFileHeader& Header = GetHeader();
+	if (Header.NumDifficulties == 0 || NumLanes < 0 || NumLanes > Header.MaxLanes)
+		return nullptr;
+
+	// Harder than anything authored: use the hardest tier
+	Difficulty = FMath::Clamp(Difficulty, 0, Header.NumDifficulties - 1);
+
+	// Dense table: direct index, no search
+	const FTrackPatternBucket* Buckets = reinterpret_cast<const FTrackPatternBucket*>(Data + Header.BucketTableOffset);
+	return &Buckets[Difficulty * (Header.MaxLanes + 1) + NumLanes];
+}
+
+int32 FTrackPatternLibrary::GetPatternCount(int32 Difficulty, int32 NumLanes) const
+{
+	const FTrackPatternBucket* Bucket = FindBucket(Difficulty, NumLanes);
+	return Bucket ? Bucket->NumPatterns : 0;
+}
+
+const FTrackPatternRecord* FTrackPatternLibrary::PickPattern(int32 Difficulty, int32 NumLanes, float Uniform) const
+{
+	const FTrackPatternBucket* Bucket = FindBucket(Difficulty, NumLanes);
+	if (!Bucket || Bucket->NumPatterns == 0)
+		return nullptr;
+
+	const int32 Offset = FMath::Min(static_cast<int32>(Uniform * Bucket->NumPatterns), static_cast<int32>(Bucket->NumPatterns) - 1);
+	const FTrackPatternRecord* Patterns = reinterpret_cast<const FTrackPatternRecord*>(Data + GetHeader().PatternTableOffset);
+	return &Patterns[Bucket->FirstPattern + FMath::Max(Offset, 0)];
+}
+
+const uint8* FTrackPatternLibrary::GetTileRow(const FTrackPatternRecord& Pattern, int32 TileIndex) const
+{
+	if (!IsLoaded() || TileIndex < 0 || TileIndex >= Pattern.NumTiles)
+		return nullptr;
+
+	const int64 RowOffset = GetHeader().CellDataOffset + static_cast<int64>(Pattern.CellOffset) + static_cast<int64>(TileIndex) * Pattern.NumLanes;
+	if (RowOffset + Pattern.NumLanes > DataSize)
+		return nullptr;
+
+	return Data + RowOffset;
+}
+
+// ===== COOKER =====
+
+static bool ParsePatternCell(TCHAR Char, ESpawnItemKind& OutKind)
+{
+	switch (Char)
+	{
+	case TEXT('.'): OutKind = ESpawnItemKind::None; return true;
+	case TEXT('C'): OutKind = ESpawnItemKind::Coin; return true;
+	case TEXT('o'): OutKind = ESpawnItemKind::SmallObstacle; return true;
+	case TEXT('O'): OutKind = ESpawnItemKind::BigObstacle; return true;
+	default: return false;
+	}
+}
+
+template<typename T>
+static void AppendPOD(TArray<uint8>& Bytes, const T& Value)
+{
+	Bytes.Append(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+}
+
+bool FTrackPatternLibrary::Serialize(const TArray<FTrackPatternRow>& Rows, TArray<uint8>& OutBytes, FString& OutError)
+{
+	struct FCookedPattern
+	{
+		uint8 Difficulty;
+		uint8 NumLanes;
+		TArray<uint8> Cells;
+	};
+
+	TArray<FCookedPattern> Patterns;
+	int32 MaxLanes = 0;
+	int32 MaxDifficulty = -1;
+
+	for (int32 RowIdx = 0; RowIdx < Rows.Num(); RowIdx++)
+	{
+		const FTrackPatternRow& Row = Rows[RowIdx];
+		if (Row.Tiles.Num() == 0 || Row.Tiles.Num() > MAX_uint16)
+		{
+			OutError = FString::Printf(TEXT("Row %d: needs 1-%d tiles"), RowIdx, MAX_uint16);
+			return false;
+		}
+		// The header stores NumDifficulties = highest tier + 1 in a uint8, so 255 would wrap to 0
+		if (Row.Difficulty < 0 || Row.Difficulty >= MAX_uint8)
+		{
+			OutError = FString::Printf(TEXT("Row %d: difficulty %d out of range"), RowIdx, Row.Difficulty);
+			return false;
+		}
+
+		FCookedPattern& Pattern = Patterns.AddDefaulted_GetRef();
+		Pattern.Difficulty = static_cast<uint8>(Row.Difficulty);
+		Pattern.NumLanes = static_cast<uint8>(FMath::Min(Row.Tiles[0].Len(), static_cast<int32>(MAX_uint8)));
+
+		for (const FString& Tile : Row.Tiles)
+		{
+			if (Tile.Len() != Pattern.NumLanes || Pattern.NumLanes == 0)
+			{
+				OutError = FString::Printf(TEXT("Row %d: every tile needs the same lane count (\"%s\")"), RowIdx, *Tile);
+				return false;
+			}
+			for (TCHAR Char : Tile)
+			{
+				ESpawnItemKind Kind;
+				if (!ParsePatternCell(Char, Kind))
+				{
+					OutError = FString::Printf(TEXT("Row %d: unknown cell '%c'"), RowIdx, Char);
+					return false;
+				}
+				Pattern.Cells.Add(static_cast<uint8>(Kind));
+			}
+		}
+
+		MaxLanes = FMath::Max(MaxLanes, static_cast<int32>(Pattern.NumLanes));
+		MaxDifficulty = FMath::Max(MaxDifficulty, static_cast<int32>(Pattern.Difficulty));
+	}
+
+	// Group by bucket so each bucket is one contiguous run of records
+	Patterns.StableSort([](const FCookedPattern& A, const FCookedPattern& B)
+	{
+		return A.Difficulty != B.Difficulty ? A.Difficulty < B.Difficulty : A.NumLanes < B.NumLanes;
+	});
+
+	const int32 NumDifficulties = MaxDifficulty + 1;
+	const int32 NumBuckets = NumDifficulties * (MaxLanes + 1);
+
+	TArray<FTrackPatternBucket> Buckets;
+	Buckets.SetNumZeroed(NumBuckets);
+
+	TArray<FTrackPatternRecord> Records;
+	TArray<uint8> Cells;
+	for (int32 i = 0; i < Patterns.Num(); i++)
+	{
+		const FCookedPattern& Pattern = Patterns[i];
+		FTrackPatternBucket& Bucket = Buckets[Pattern.Difficulty * (MaxLanes + 1) + Pattern.NumLanes];
+		if (Bucket.NumPatterns == 0)
+		{
+			Bucket.FirstPattern = i;
+		}
+		Bucket.NumPatterns++;
+
+		FTrackPatternRecord& Record = Records.AddZeroed_GetRef();
+		Record.CellOffset = Cells.Num();
+		Record.NumTiles = static_cast<uint16>(Pattern.Cells.Num() / Pattern.NumLanes);
+		Record.NumLanes = Pattern.NumLanes;
+		Record.Difficulty = Pattern.Difficulty;
+		Cells.Append(Pattern.Cells);
+	}
+
+	FTrackPatternFileHeader Header;
+	FMemory::Memzero(Header);
+	Header.Magic = TRACK_PATTERN_MAGIC;
+	Header.Version = TRACK_PATTERN_VERSION;
+	Header.NumDifficulties = static_cast<uint8>(NumDifficulties);
+	Header.MaxLanes = static_cast<uint8>(MaxLanes);
+	Header.NumPatterns = Records.Num();
+	Header.BucketTableOffset = sizeof(FTrackPatternFileHeader);
+	Header.PatternTableOffset = Header.BucketTableOffset + Buckets.Num() * sizeof(FTrackPatternBucket);
+	Header.CellDataOffset = Header.PatternTableOffset + Records.Num() * sizeof(FTrackPatternRecord);
+	Header.TotalSize = Align(Header.CellDataOffset + Cells.Num(), 4);
+
+	OutBytes.Reset(Header.TotalSize);
+	AppendPOD(OutBytes, Header);
+	OutBytes.Append(reinterpret_cast<const uint8*>(Buckets.GetData()), Buckets.Num() * sizeof(FTrackPatternBucket));
+	OutBytes.Append(reinterpret_cast<const uint8*>(Records.GetData()), Records.Num() * sizeof(FTrackPatternRecord));
+	OutBytes.Append(Cells);
+	OutBytes.SetNumZeroed(Header.TotalSize);
+
+	return true;
+}
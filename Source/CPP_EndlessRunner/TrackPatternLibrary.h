@@ -0,0 +1,115 @@
+// TrackPatternLibrary.h - Memory-mapped library of hand-authored multi-tile patterns
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataTable.h"
+#include "SpawnTables.h"
+#include "TrackPatternLibrary.generated.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Authoring row for a pattern (coin trail, obstacle gate, ...)
+ * Cooked into the binary library by the CookTrackPatterns commandlet
+ *
+ * Each entry of Tiles is one floor tile, one character per lane:
+ *   '.' nothing   'C' coin   'o' small obstacle   'O' big obstacle
+ */
+USTRUCT(BlueprintType)
+struct FTrackPatternRow : public FTableRowBase
+{
+	GENERATED_BODY()
+
+	// Difficulty tier the pattern belongs to (index into the game mode's spawn bands,
+	// or the difficulty preset's PatternTier curve when no bands are authored)
+	// 254 at most: the cooked header counts tiers in one byte
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pattern", meta = (ClampMin = "0", ClampMax = "254"))
+	int32 Difficulty = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pattern")
+	TArray<FString> Tiles;
+};
+
+// ===== BINARY FORMAT =====
+// Little-endian, every block 4-byte aligned, read in place from the mapped file:
+//   [Header][Bucket table: NumDifficulties * (MaxLanes + 1)][Pattern records][Cells]
+// Patterns are grouped by (Difficulty, NumLanes) so a bucket is a contiguous range
+
+#define TRACK_PATTERN_MAGIC 0x54415054 // "TPAT"
+#define TRACK_PATTERN_VERSION 1
+
+struct FTrackPatternFileHeader
+{
+	uint32 Magic;
+	uint16 Version;
+	uint8 NumDifficulties;
+	uint8 MaxLanes;
+	uint32 NumPatterns;
+	uint32 BucketTableOffset;
+	uint32 PatternTableOffset;
+	uint32 CellDataOffset;
+	uint32 TotalSize;
+};
+
+struct FTrackPatternBucket
+{
+	uint32 FirstPattern;
+	uint32 NumPatterns;
+};
+
+struct FTrackPatternRecord
+{
+	uint32 CellOffset;      // From start of cell data, NumTiles * NumLanes bytes (ESpawnItemKind)
+	uint16 NumTiles;
+	uint8 NumLanes;
+	uint8 Difficulty;
+};
+
+static_assert(sizeof(FTrackPatternFileHeader) == 28, "Pattern file header layout changed");
+static_assert(sizeof(FTrackPatternBucket) == 8, "Pattern bucket layout changed");
+static_assert(sizeof(FTrackPatternRecord) == 8, "Pattern record layout changed");
+
+/**
+ * Read-only pattern library backed by a memory-mapped file
+ * No parsing at load: the header, bucket ranges and pattern records are
+ * bounds-checked once, then everything is read in place
+ * Time Complexity: O(B + P) load for B buckets and P patterns, O(1) bucket
+ * lookup, O(1) pick, O(1) cell access
+ */
+class FTrackPatternLibrary
+{
+private:
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+
+	// Used only where the platform cannot map files (e.g. inside a pak)
+	TArray64<uint8> FallbackData;
+
+	const uint8* Data;
+	int64 DataSize;
+
+public:
+	FTrackPatternLibrary();
+	~FTrackPatternLibrary();
+
+	bool Load(const FString& Filename);
+	void Unload();
+	bool IsLoaded() const { return Data != nullptr; }
+
+	// Queries
+	int32 GetPatternCount(int32 Difficulty, int32 NumLanes) const;
+	const FTrackPatternRecord* PickPattern(int32 Difficulty, int32 NumLanes, float Uniform) const;
+
+	// One tile row of a pattern: NumLanes cells of ESpawnItemKind
+	const uint8* GetTileRow(const FTrackPatternRecord& Pattern, int32 TileIndex) const;
+
+	// Cooker side: authoring rows -> binary image. Returns false on invalid rows.
+	static bool Serialize(const TArray<FTrackPatternRow>& Rows, TArray<uint8>& OutBytes, FString& OutError);
+
+private:
+	const FTrackPatternFileHeader& GetHeader() const { return *reinterpret_cast<const FTrackPatternFileHeader*>(Data); }
+	const FTrackPatternBucket* FindBucket(int32 Difficulty, int32 NumLanes) const;
+	bool ValidateHeader() const;
+	bool ValidateTables() const;
+};
@@ -0,0 +1,45 @@
+// Varint.h - LEB128 variable-length encoding of uint32 values
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 7 bits per byte, low bits first, high bit set on every byte but the last
+ * Small values (deltas, counts) take one byte, the largest uint32 takes five
+ * Time Complexity: O(1) per value (at most 5 bytes)
+ */
+struct FVarint
+{
+    static void Write(TArray<uint8>& Bytes, uint32 Value);
+
+    // False on a truncated or overlong value; Offset is left past the bytes read
+    static bool Read(const TArray<uint8>& Bytes, int32& Offset, uint32& OutValue);
+};
+
+// ===== IMPLEMENTATION =====
+
+inline void FVarint::Write(TArray<uint8>& Bytes, uint32 Value)
+{
+    while (Value >= 0x80)
+    {
+        Bytes.Add(static_cast<uint8>(Value | 0x80));
+        Value >>= 7;
+    }
+    Bytes.Add(static_cast<uint8>(Value));
+}
+
+inline bool FVarint::Read(const TArray<uint8>& Bytes, int32& Offset, uint32& OutValue)
+{
+    OutValue = 0;
+    for (int32 Shift = 0; Shift < 35 && Offset < Bytes.Num(); Shift += 7)
+    {
+        const uint8 Byte = Bytes[Offset++];
+        // The fifth byte only has room for the top 4 bits of a uint32
+        if (Shift == 28 && (Byte & 0x70) != 0)
+            return false;
+        OutValue |= static_cast<uint32>(Byte & 0x7F) << Shift;
+        if ((Byte & 0x80) == 0)
+            return true;
+    }
+    return false;
+}